@@ -0,0 +1,174 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+
+#include "base/Logger.h"
+#include "base/SimpleParserStatus.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+#include "mdl/WorldReader.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+#include <string_view>
+
+namespace tb::bench
+{
+
+const vm::bbox3d WorldBounds = vm::bbox3d{8192.0};
+
+namespace
+{
+
+constexpr auto BrushesPerEntity = size_t(8);
+constexpr auto GridSize = size_t(128);
+constexpr auto GridSpacing = 64.0;
+constexpr auto CubeSize = 32.0;
+
+void appendCube(std::string& str, const size_t index)
+{
+  const auto x = double(index % GridSize) * GridSpacing - 4096.0;
+  const auto y = double((index / GridSize) % GridSize) * GridSpacing - 4096.0;
+  const auto z = double(index / (GridSize * GridSize)) * GridSpacing;
+  const auto material = fmt::format("material{}", index % 4);
+
+  str += fmt::format(
+    R"({{
+( {0} {1} {2} ) ( {0} {4} {2} ) ( {0} {1} {5} ) {6} [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {0} {1} {2} ) ( {0} {1} {5} ) ( {3} {1} {2} ) {6} [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {0} {1} {2} ) ( {3} {1} {2} ) ( {0} {4} {2} ) {6} [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( {3} {4} {5} ) ( {0} {4} {5} ) ( {3} {4} {2} ) {6} [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {3} {4} {5} ) ( {3} {4} {2} ) ( {3} {1} {5} ) {6} [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( {3} {4} {5} ) ( {3} {1} {5} ) ( {0} {4} {5} ) {6} [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+}}
+)",
+    x,
+    y,
+    z,
+    x + CubeSize,
+    y + CubeSize,
+    z + CubeSize,
+    material);
+}
+
+} // namespace
+
+size_t benchmarkBrushCount()
+{
+  constexpr auto DefaultBrushCount = size_t(10000);
+
+  if (const auto* value = std::getenv("TB_BENCHMARK_BRUSH_COUNT"))
+  {
+    const auto str = std::string_view{value};
+    auto result = size_t(0);
+    const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), result);
+    if (ec == std::errc{} && ptr == str.data() + str.size() && result > 0)
+    {
+      return result;
+    }
+  }
+  return DefaultBrushCount;
+}
+
+std::string makeBenchmarkMap(const size_t brushCount)
+{
+  auto worldBrushes = std::string{};
+  auto entities = std::string{};
+
+  auto entityCount = size_t(0);
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    if (i % BrushesPerEntity == 0)
+    {
+      appendCube(worldBrushes, i);
+    }
+    else
+    {
+      if (i % BrushesPerEntity == 1)
+      {
+        entities += fmt::format(
+          "{{\n\"classname\" \"func_detail\"\n\"targetname\" \"detail{}\"\n",
+          entityCount++);
+      }
+      appendCube(entities, i);
+      if (i % BrushesPerEntity == BrushesPerEntity - 1 || i == brushCount - 1)
+      {
+        entities += "}\n";
+      }
+    }
+  }
+
+  return fmt::format(
+    "{{\n\"classname\" \"worldspawn\"\n\"mapversion\" \"220\"\n{}}}\n{}",
+    worldBrushes,
+    entities);
+}
+
+std::unique_ptr<mdl::WorldNode> readBenchmarkMap(
+  const std::string& str, kdl::task_manager& taskManager)
+{
+  auto logger = NullLogger{};
+  auto status = SimpleParserStatus{logger};
+
+  return mdl::WorldReader::tryRead(
+           str,
+           {mdl::MapFormat::Valve},
+           WorldBounds,
+           mdl::EntityPropertyConfig{},
+           status,
+           taskManager)
+         | kdl::if_error([](const auto& e) { throw std::runtime_error{e.msg}; })
+         | kdl::value();
+}
+
+std::vector<mdl::BrushNode*> collectBrushNodes(mdl::Node& node)
+{
+  auto result = std::vector<mdl::BrushNode*>{};
+  node.accept(kdl::overload(
+    [](auto&& thisLambda, mdl::WorldNode& worldNode) {
+      worldNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, mdl::LayerNode& layerNode) {
+      layerNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, mdl::GroupNode& groupNode) {
+      groupNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, mdl::EntityNode& entityNode) {
+      entityNode.visitChildren(thisLambda);
+    },
+    [&](mdl::BrushNode& brushNode) { result.push_back(&brushNode); },
+    [](mdl::PatchNode&) {}));
+  return result;
+}
+
+} // namespace tb::bench
@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kdl
+{
+class task_manager;
+}
+
+namespace tb
+{
+namespace mdl
+{
+class BrushNode;
+class Node;
+class WorldNode;
+} // namespace mdl
+
+namespace bench
+{
+
+/**
+ * The world bounds used by all benchmarks.
+ */
+extern const vm::bbox3d WorldBounds;
+
+/**
+ * Returns the number of brushes in the generated benchmark maps.
+ *
+ * The number is read from the environment variable TB_BENCHMARK_BRUSH_COUNT and defaults
+ * to 10000 if the variable is not set or cannot be parsed.
+ */
+size_t benchmarkBrushCount();
+
+/**
+ * Generates a map in Valve format with the given number of axis aligned cubes.
+ *
+ * The cubes are laid out on a regular grid. Every eighth cube belongs to the world, the
+ * others are grouped into func_detail entities of seven brushes each.
+ */
+std::string makeBenchmarkMap(size_t brushCount);
+
+/**
+ * Parses the given map, which must be in Valve format.
+ *
+ * Throws std::runtime_error if the map cannot be parsed.
+ */
+std::unique_ptr<mdl::WorldNode> readBenchmarkMap(
+  const std::string& str, kdl::task_manager& taskManager);
+
+/**
+ * Returns all brush nodes in the given node and its descendants.
+ */
+std::vector<mdl::BrushNode*> collectBrushNodes(mdl::Node& node);
+
+} // namespace bench
+} // namespace tb
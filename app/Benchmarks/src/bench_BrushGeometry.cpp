@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::bench
+{
+
+TEST_CASE("Brush geometry")
+{
+  SECTION("create")
+  {
+    auto taskManager = kdl::task_manager{};
+
+    const auto brushCount = benchmarkBrushCount();
+    const auto world = readBenchmarkMap(makeBenchmarkMap(brushCount), taskManager);
+
+    auto faces = std::vector<std::vector<mdl::BrushFace>>{};
+    for (const auto* brushNode : collectBrushNodes(*world))
+    {
+      faces.push_back(brushNode->brush().faces());
+    }
+
+    // Brush::create computes the geometry using Brush::updateGeometryFromFaces, the
+    // measurement includes copying the faces
+    BENCHMARK(fmt::format("Brush::updateGeometryFromFaces ({} brushes)", faces.size()))
+    {
+      auto failures = size_t(0);
+      for (const auto& brushFaces : faces)
+      {
+        if (mdl::Brush::create(WorldBounds, brushFaces).is_error())
+        {
+          ++failures;
+        }
+      }
+      return failures;
+    };
+  }
+
+  SECTION("subtract")
+  {
+    const auto builder = mdl::BrushBuilder{mdl::MapFormat::Valve, WorldBounds};
+
+    const auto minuend =
+      builder.createCuboid(vm::bbox3d{{-512, -512, -512}, {512, 512, 512}}, "minuend")
+      | kdl::value();
+
+    // a grid of overlapping cubes that cut the minuend into many fragments
+    auto subtrahends = std::vector<mdl::Brush>{};
+    for (int x = -4; x < 4; ++x)
+    {
+      for (int y = -4; y < 4; ++y)
+      {
+        const auto min = vm::vec3d{double(x), double(y), -0.5} * 128.0 + vm::vec3d{16, 8, 0};
+        const auto max = min + vm::vec3d{96, 104, 128};
+        subtrahends.push_back(
+          builder.createCuboid(vm::bbox3d{min, max}, "subtrahend") | kdl::value());
+      }
+    }
+
+    auto subtrahendPtrs = std::vector<const mdl::Brush*>{};
+    for (const auto& subtrahend : subtrahends)
+    {
+      subtrahendPtrs.push_back(&subtrahend);
+    }
+
+    BENCHMARK(fmt::format("Brush::subtract ({} subtrahends)", subtrahends.size()))
+    {
+      return minuend.subtract(mdl::MapFormat::Valve, WorldBounds, "default", subtrahendPtrs);
+    };
+  }
+}
+
+} // namespace tb::bench
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "gl/PerspectiveCamera.h"
+#include "mdl/BrushNode.h"
+#include "mdl/WorldNode.h"
+#include "render/BrushRenderer.h"
+#include "render/ViewFrustum.h"
+
+#include "kd/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::bench
+{
+
+TEST_CASE("Brush rendering")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto brushCount = benchmarkBrushCount();
+  const auto world = readBenchmarkMap(makeBenchmarkMap(brushCount), taskManager);
+  const auto brushNodes = collectBrushNodes(*world);
+
+  // validating a brush renderer only fills the vertex and index arrays, so no Gl
+  // implementation is required here
+  auto brushRenderer = render::BrushRenderer{};
+  for (const auto* brushNode : brushNodes)
+  {
+    brushRenderer.addBrush(*brushNode);
+  }
+
+  BENCHMARK(fmt::format("BrushRenderer::validate ({} brushes)", brushNodes.size()))
+  {
+    for (auto* brushNode : brushNodes)
+    {
+      brushNode->invalidateVertexCache();
+    }
+    brushRenderer.invalidate();
+    brushRenderer.validate();
+    return brushRenderer.valid();
+  };
+
+  BENCHMARK(fmt::format(
+    "BrushRenderer::validate with cached vertices ({} brushes)", brushNodes.size()))
+  {
+    brushRenderer.invalidate();
+    brushRenderer.validate();
+    return brushRenderer.valid();
+  };
+
+  // alternate between two views so that every iteration recomputes the visible ranges
+  auto camera = gl::PerspectiveCamera{};
+  camera.setDirection(vm::vec3f{1, 0, 0}, vm::vec3f{0, 0, 1});
+  const auto frustum1 = render::ViewFrustum{camera};
+  camera.setDirection(vm::vec3f{-1, 0, 0}, vm::vec3f{0, 0, 1});
+  const auto frustum2 = render::ViewFrustum{camera};
+
+  auto useFirstFrustum = true;
+  BENCHMARK(fmt::format("BrushRenderer::cull ({} brushes)", brushNodes.size()))
+  {
+    brushRenderer.cull(useFirstFrustum ? frustum1 : frustum2);
+    useFirstFrustum = !useFirstFrustum;
+    return useFirstFrustum;
+  };
+}
+
+} // namespace tb::bench
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LinkedGroupUtils.h"
+#include "mdl/MapFormat.h"
+
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::bench
+{
+
+TEST_CASE("Linked groups")
+{
+  constexpr auto BrushesPerGroup = size_t(64);
+  constexpr auto LinkedGroupCount = size_t(64);
+
+  auto taskManager = kdl::task_manager{};
+
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Valve, WorldBounds};
+
+  auto sourceGroupNode = mdl::GroupNode{mdl::Group{"source"}};
+  for (size_t i = 0; i < BrushesPerGroup; ++i)
+  {
+    const auto min = vm::vec3d{double(i % 8), double(i / 8), 0} * 64.0;
+    auto brush = builder.createCuboid(vm::bbox3d{min, min + vm::vec3d{32, 32, 32}}, "brush")
+                 | kdl::value();
+    sourceGroupNode.addChild(new mdl::BrushNode{std::move(brush)});
+  }
+
+  // the linked groups are translated so that the children must be transformed when
+  // the linked groups are updated
+  auto linkedGroupNodes = std::vector<std::unique_ptr<mdl::GroupNode>>{};
+  auto targetGroupNodes = std::vector<mdl::GroupNode*>{};
+  for (size_t i = 0; i < LinkedGroupCount; ++i)
+  {
+    auto linkedGroupNode = std::unique_ptr<mdl::GroupNode>{
+      static_cast<mdl::GroupNode*>(sourceGroupNode.cloneRecursively(WorldBounds))};
+
+    auto group = linkedGroupNode->group();
+    group.setTransformation(
+      vm::translation_matrix(vm::vec3d{0, 0, double(i + 1) * 64.0}));
+    linkedGroupNode->setGroup(std::move(group));
+
+    targetGroupNodes.push_back(linkedGroupNode.get());
+    linkedGroupNodes.push_back(std::move(linkedGroupNode));
+  }
+
+  BENCHMARK(fmt::format(
+    "updateLinkedGroups ({} groups, {} brushes each)", LinkedGroupCount, BrushesPerGroup))
+  {
+    return mdl::updateLinkedGroups(sourceGroupNode, targetGroupNodes, WorldBounds, taskManager)
+           | kdl::value();
+  };
+}
+
+} // namespace tb::bench
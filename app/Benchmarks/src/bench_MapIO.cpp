@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/BrushNode.h"
+#include "mdl/NodeWriter.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <sstream>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::bench
+{
+
+TEST_CASE("Map IO")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto brushCount = benchmarkBrushCount();
+  const auto str = makeBenchmarkMap(brushCount);
+
+  BENCHMARK(fmt::format("WorldReader::tryRead ({} brushes)", brushCount))
+  {
+    return readBenchmarkMap(str, taskManager);
+  };
+
+  const auto world = readBenchmarkMap(str, taskManager);
+
+  const auto brushNodes = collectBrushNodes(*world);
+  REQUIRE(brushNodes.size() == brushCount);
+
+  const auto writeMap = [&]() {
+    auto stream = std::stringstream{};
+    auto writer = mdl::NodeWriter{*world, stream};
+    writer.writeMap(taskManager);
+    return stream.str().size();
+  };
+
+  // discards the text cached by the previous save so that every brush is formatted again
+  BENCHMARK(fmt::format("NodeWriter::writeMap ({} brushes)", brushCount))
+  {
+    for (const auto* brushNode : brushNodes)
+    {
+      brushNode->setCachedMapText(nullptr);
+    }
+    return writeMap();
+  };
+
+  BENCHMARK(fmt::format("NodeWriter::writeMap unchanged ({} brushes)", brushCount))
+  {
+    return writeMap();
+  };
+}
+
+} // namespace tb::bench
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkUtils.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/HitFilter.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/task_manager.h"
+
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::bench
+{
+namespace
+{
+
+constexpr auto RayCount = size_t(256);
+
+/**
+ * Rays that look down onto the generated map and rays that traverse it horizontally.
+ */
+std::vector<vm::ray3d> makeRays()
+{
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(2 * RayCount);
+
+  for (size_t i = 0; i < RayCount; ++i)
+  {
+    const auto x = double(i * 97 % 8192) - 4096.0 + 16.0;
+    const auto y = double(i * 61 % 8192) - 4096.0 + 16.0;
+    result.emplace_back(vm::vec3d{x, y, 4096.0}, vm::vec3d{0, 0, -1});
+    result.emplace_back(vm::vec3d{-8000.0, y, 16.0}, vm::normalize(vm::vec3d{1, 0.1, 0}));
+  }
+
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("Picking")
+{
+  auto taskManager = kdl::task_manager{};
+
+  const auto brushCount = benchmarkBrushCount();
+  const auto world = readBenchmarkMap(makeBenchmarkMap(brushCount), taskManager);
+
+  const auto editorContext = mdl::EditorContext{};
+  const auto rays = makeRays();
+
+  BENCHMARK(fmt::format("WorldNode::pick ({} rays, {} brushes)", rays.size(), brushCount))
+  {
+    auto hitCount = size_t(0);
+    for (const auto& ray : rays)
+    {
+      auto pickResult = mdl::PickResult::byDistance();
+      world->pick(editorContext, ray, pickResult);
+      hitCount += pickResult.size();
+    }
+    return hitCount;
+  };
+
+  BENCHMARK(
+    fmt::format("WorldNode::pickNearest ({} rays, {} brushes)", rays.size(), brushCount))
+  {
+    const auto hitFilter = mdl::HitFilters::type(mdl::BrushNode::BrushHitType);
+
+    auto hitCount = size_t(0);
+    for (const auto& ray : rays)
+    {
+      auto pickResult = mdl::PickResult::byDistance();
+      world->pickNearest(editorContext, ray, hitFilter, 1, pickResult);
+      hitCount += pickResult.size();
+    }
+    return hitCount;
+  };
+}
+
+} // namespace tb::bench
@@ -22,31 +22,283 @@
 
 #include "kd/ranges/to.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <optional>
 #include <ranges>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+
+/**
+ * A move only type erased nullary callable. Callables that fit into the inline buffer
+ * are stored without a heap allocation.
+ */
+class task
+{
+private:
+  static constexpr std::size_t buffer_size = 64;
+
+  struct vtable
+  {
+    void (*invoke)(void* storage);
+    void (*move)(void* from, void* to) noexcept;
+    void (*destroy)(void* storage) noexcept;
+  };
+
+  template <typename F>
+  static constexpr bool is_inline = sizeof(F) <= buffer_size
+                                    && alignof(F) <= alignof(std::max_align_t)
+                                    && std::is_nothrow_move_constructible_v<F>;
+
+  template <typename F>
+  static constexpr auto inline_vtable = vtable{
+    [](void* storage) { (*std::launder(reinterpret_cast<F*>(storage)))(); },
+    [](void* from, void* to) noexcept {
+      auto* f = std::launder(reinterpret_cast<F*>(from));
+      new (to) F{std::move(*f)};
+      f->~F();
+    },
+    [](void* storage) noexcept { std::launder(reinterpret_cast<F*>(storage))->~F(); },
+  };
+
+  template <typename F>
+  static constexpr auto heap_vtable = vtable{
+    [](void* storage) { (**reinterpret_cast<F**>(storage))(); },
+    [](void* from, void* to) noexcept {
+      new (to) F*{*reinterpret_cast<F**>(from)};
+    },
+    [](void* storage) noexcept { delete *reinterpret_cast<F**>(storage); },
+  };
+
+  alignas(std::max_align_t) std::byte m_storage[buffer_size];
+  const vtable* m_vtable = nullptr;
+
+public:
+  task() = default;
+
+  template <typename F>
+    requires(!std::same_as<std::remove_cvref_t<F>, task> && std::invocable<F&>)
+  task(F&& f) // NOLINT
+  {
+    using F_ = std::remove_cvref_t<F>;
+    if constexpr (is_inline<F_>)
+    {
+      new (m_storage) F_{std::forward<F>(f)};
+      m_vtable = &inline_vtable<F_>;
+    }
+    else
+    {
+      new (m_storage) F_*{new F_{std::forward<F>(f)}};
+      m_vtable = &heap_vtable<F_>;
+    }
+  }
+
+  task(task&& other) noexcept
+    : m_vtable{std::exchange(other.m_vtable, nullptr)}
+  {
+    if (m_vtable)
+    {
+      m_vtable->move(other.m_storage, m_storage);
+    }
+  }
+
+  task& operator=(task&& other) noexcept
+  {
+    if (this != &other)
+    {
+      reset();
+      m_vtable = std::exchange(other.m_vtable, nullptr);
+      if (m_vtable)
+      {
+        m_vtable->move(other.m_storage, m_storage);
+      }
+    }
+    return *this;
+  }
+
+  task(const task&) = delete;
+  task& operator=(const task&) = delete;
 
+  ~task() { reset(); }
+
+  explicit operator bool() const { return m_vtable != nullptr; }
+
+  void operator()() { m_vtable->invoke(m_storage); }
+
+private:
+  void reset() noexcept
+  {
+    if (m_vtable)
+    {
+      m_vtable->destroy(m_storage);
+      m_vtable = nullptr;
+    }
+  }
+};
+
+/**
+ * Tracks the completion of a batch of tasks so that the batch needs only one
+ * synchronization object instead of one promise per task.
+ */
+struct task_batch
+{
+  std::atomic<std::size_t> remaining;
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::exception_ptr exception;
+
+  explicit task_batch(std::size_t count);
+
+  bool done() const;
+  void fail(std::exception_ptr e);
+  void complete();
+};
+
+} // namespace detail
+
+/**
+ * Runs tasks on a fixed pool of worker threads.
+ *
+ * Every worker owns a task queue. Tasks submitted by a worker are pushed onto its own
+ * queue, and tasks submitted by other threads are distributed over the queues. Workers
+ * take tasks from the back of their own queue and steal from the front of the other
+ * queues when their own queue is empty, so there is no single lock that all workers
+ * contend for.
+ *
+ * A task manager without workers runs all tasks immediately on the calling thread.
+ */
 class task_manager
 {
 private:
-  using pending_task = std::function<void()>;
+  struct queued_task
+  {
+    detail::task task;
+    const detail::task_batch* batch = nullptr;
+  };
+
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<queued_task> tasks;
+  };
 
+  std::vector<std::unique_ptr<worker_queue>> m_queues;
   std::vector<std::thread> m_workers;
 
-  std::mutex m_pending_tasks_mutex;
-  std::condition_variable m_pending_tasks_cv;
-  std::queue<pending_task> m_pending_tasks;
+  std::atomic<std::size_t> m_pending_task_count = 0;
+  std::atomic<std::size_t> m_sleeping_worker_count = 0;
+  std::atomic<std::size_t> m_next_queue_index = 0;
+
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_cv;
   bool m_running = true;
 
-  std::function<void()> make_worker_func();
+  std::function<void()> make_worker_func(std::size_t worker_index);
+
+  std::optional<std::size_t> current_worker_index() const;
+
+  void push_task(detail::task task);
+  void push_tasks(std::vector<detail::task> tasks, const detail::task_batch& batch);
+  void wake_workers(std::size_t count);
+
+  /**
+   * Pops a task from the given queue or steals one from another queue. If a batch is
+   * given, only tasks belonging to that batch are considered.
+   */
+  std::optional<detail::task> pop_task(
+    std::size_t queue_index, const detail::task_batch* batch = nullptr);
+  bool run_pending_task(
+    std::size_t queue_index, const detail::task_batch* batch = nullptr);
+
+  void wait(detail::task_batch& batch);
+
+  std::size_t chunk_size(std::size_t size, std::size_t min_grain_size) const;
+
+  /**
+   * Splits the index range [0, size) into chunks and calls f(begin, end) for every chunk.
+   * The chunks are claimed dynamically by the workers and the calling thread, so threads
+   * that finish early pick up more work. Runs f(0, size) on the calling thread if the
+   * range is too small to be split.
+   */
+  template <typename F>
+  void for_each_chunk(const std::size_t size, const std::size_t min_grain_size, F&& f)
+  {
+    const auto chunk_size_ = chunk_size(size, min_grain_size);
+    if (m_workers.empty() || chunk_size_ >= size)
+    {
+      if (size > 0)
+      {
+        f(std::size_t{0}, size);
+      }
+      return;
+    }
+
+    auto next_chunk_begin = std::atomic<std::size_t>{0};
+    const auto run_chunks = [&]() {
+      for (auto begin = next_chunk_begin.fetch_add(chunk_size_); begin < size;
+           begin = next_chunk_begin.fetch_add(chunk_size_))
+      {
+        f(begin, std::min(begin + chunk_size_, size));
+      }
+    };
+
+    // the calling thread claims chunks, too
+    const auto chunk_count = (size + chunk_size_ - 1) / chunk_size_;
+    const auto task_count = std::min(m_workers.size(), chunk_count - 1);
+    auto batch = std::make_shared<detail::task_batch>(task_count);
+
+    auto tasks = std::vector<detail::task>{};
+    tasks.reserve(task_count);
+    for (std::size_t i = 0; i < task_count; ++i)
+    {
+      tasks.emplace_back([batch, &run_chunks]() {
+        try
+        {
+          run_chunks();
+        }
+        catch (...)
+        {
+          batch->fail(std::current_exception());
+        }
+        batch->complete();
+      });
+    }
+    push_tasks(std::move(tasks), *batch);
+
+    try
+    {
+      run_chunks();
+    }
+    catch (...)
+    {
+      batch->fail(std::current_exception());
+    }
+
+    wait(*batch);
+
+    if (batch->exception)
+    {
+      std::rethrow_exception(batch->exception);
+    }
+  }
 
 public:
   explicit task_manager(
@@ -54,26 +306,69 @@ public:
 
   ~task_manager();
 
-  template <typename task_result>
-  auto run_task(std::function<task_result()> task)
+  std::size_t concurrency() const;
+
+  /**
+   * Waits until the given future is ready. A worker thread runs pending tasks while
+   * waiting so that waiting for the result of a task on a worker thread cannot deadlock.
+   * Other threads just block, otherwise they could pick up an unrelated long running
+   * task.
+   */
+  template <typename T>
+  void wait(const std::future<T>& future)
   {
-    if (m_workers.empty())
+    const auto queue_index = current_worker_index();
+    if (!queue_index)
     {
-      auto promise = std::promise<task_result>{};
-      promise.set_value(task());
-      return promise.get_future();
+      future.wait();
+      return;
     }
 
-    auto promise = std::make_shared<std::promise<task_result>>();
-    auto future = promise->get_future();
+    while (future.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+    {
+      if (!run_pending_task(*queue_index))
+      {
+        // the task is already running
+        future.wait_for(std::chrono::milliseconds{1});
+      }
+    }
+  }
+
+  template <std::invocable F>
+  auto run_task(F&& task)
+  {
+    using task_result = std::invoke_result_t<F>;
+
+    auto promise = std::promise<task_result>{};
+    auto future = promise.get_future();
 
+    auto run = [task_ = std::forward<F>(task), promise_ = std::move(promise)]() mutable {
+      try
+      {
+        if constexpr (std::is_void_v<task_result>)
+        {
+          task_();
+          promise_.set_value();
+        }
+        else
+        {
+          promise_.set_value(task_());
+        }
+      }
+      catch (...)
+      {
+        promise_.set_exception(std::current_exception());
+      }
+    };
+
+    if (m_workers.empty())
     {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
-      m_pending_tasks.push([&, task_ = std::move(task), promise_ = std::move(promise)]() {
-        promise_->set_value(task_());
-      });
+      run();
+    }
+    else
+    {
+      push_task(std::move(run));
     }
-    m_pending_tasks_cv.notify_one();
 
     return future;
   }
@@ -90,10 +385,131 @@ public:
   template <std::ranges::range range>
   auto run_tasks_and_wait(range&& tasks)
   {
-    auto futures = run_tasks(std::forward<range>(tasks));
-    return futures | std::views::transform([](auto& future) { return future.get(); })
+    using task_type = std::remove_cvref_t<std::ranges::range_reference_t<range>>;
+    using task_result = std::invoke_result_t<task_type&>;
+
+    if (m_workers.empty())
+    {
+      return tasks | std::views::transform([](auto&& task) { return task(); })
+             | kdl::ranges::to<std::vector>();
+    }
+
+    auto pending_tasks = tasks | std::views::transform([](auto&& task) {
+                           return task_type{std::forward<decltype(task)>(task)};
+                         })
+                         | kdl::ranges::to<std::vector>();
+
+    auto results = std::vector<std::optional<task_result>>(pending_tasks.size());
+    auto batch = std::make_shared<detail::task_batch>(pending_tasks.size());
+
+    auto batch_tasks = std::vector<detail::task>{};
+    batch_tasks.reserve(pending_tasks.size());
+
+    for (std::size_t i = 0; i < pending_tasks.size(); ++i)
+    {
+      batch_tasks.emplace_back(
+        [batch, task = &pending_tasks[i], result = &results[i]]() {
+          try
+          {
+            result->emplace((*task)());
+          }
+          catch (...)
+          {
+            batch->fail(std::current_exception());
+          }
+          batch->complete();
+        });
+    }
+
+    push_tasks(std::move(batch_tasks), *batch);
+    wait(*batch);
+
+    if (batch->exception)
+    {
+      std::rethrow_exception(batch->exception);
+    }
+
+    return results | std::views::transform([](auto& result) {
+             return std::move(*result);
+           })
            | kdl::ranges::to<std::vector>();
   }
+
+  /**
+   * Calls f for every element of the given range in parallel.
+   *
+   * The range is split into chunks of at least min_grain_size elements. The chunk size is
+   * chosen so that every thread gets several chunks. If the range is not larger than one
+   * chunk, f is called for every element on the calling thread.
+   *
+   * f is called concurrently and must be safe to call from multiple threads.
+   */
+  template <std::ranges::random_access_range range, typename F>
+    requires std::ranges::sized_range<range>
+  void parallel_for(range&& r, F&& f, const std::size_t min_grain_size = 1)
+  {
+    const auto first = std::ranges::begin(r);
+    for_each_chunk(
+      static_cast<std::size_t>(std::ranges::size(r)),
+      min_grain_size,
+      [&](const std::size_t begin, const std::size_t end) {
+        for (auto i = begin; i < end; ++i)
+        {
+          std::invoke(f, first[static_cast<std::ranges::range_difference_t<range>>(i)]);
+        }
+      });
+  }
+
+  /**
+   * Applies f to every element of the given range in parallel and returns a vector of the
+   * results in the order of the range.
+   *
+   * The results are written directly into a preallocated vector, see parallel_for for
+   * the chunking and the serial fallback.
+   */
+  template <std::ranges::random_access_range range, typename F>
+    requires std::ranges::sized_range<range>
+  auto parallel_transform(range&& r, F&& f, const std::size_t min_grain_size = 1)
+  {
+    using result_type = std::remove_cvref_t<
+      std::invoke_result_t<F&, std::ranges::range_reference_t<range>>>;
+
+    const auto first = std::ranges::begin(r);
+    const auto size = static_cast<std::size_t>(std::ranges::size(r));
+    const auto at = [&](const std::size_t i) -> decltype(auto) {
+      return first[static_cast<std::ranges::range_difference_t<range>>(i)];
+    };
+
+    // std::vector<bool> packs its elements, so they cannot be written concurrently
+    if constexpr (
+      std::is_default_constructible_v<result_type>
+      && std::is_move_assignable_v<result_type> && !std::is_same_v<result_type, bool>)
+    {
+      auto results = std::vector<result_type>(size);
+      for_each_chunk(
+        size, min_grain_size, [&](const std::size_t begin, const std::size_t end) {
+          for (auto i = begin; i < end; ++i)
+          {
+            results[i] = std::invoke(f, at(i));
+          }
+        });
+      return results;
+    }
+    else
+    {
+      auto results = std::vector<std::optional<result_type>>(size);
+      for_each_chunk(
+        size, min_grain_size, [&](const std::size_t begin, const std::size_t end) {
+          for (auto i = begin; i < end; ++i)
+          {
+            results[i].emplace(std::invoke(f, at(i)));
+          }
+        });
+      return results
+             | std::views::transform([](auto& result) { return std::move(*result); })
+             | kdl::ranges::to<std::vector>();
+    }
+  }
 };
 
 } // namespace kdl
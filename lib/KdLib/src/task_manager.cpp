@@ -20,64 +20,310 @@
 
 #include "kd/task_manager.h"
 
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
-#include <future>
+#include <iterator>
 #include <mutex>
-#include <queue>
-#include <ranges>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace kdl
 {
+namespace
+{
+
+struct worker_identity
+{
+  const task_manager* manager = nullptr;
+  std::size_t index = 0;
+};
+
+thread_local auto current_worker = worker_identity{};
+
+} // namespace
+
+namespace detail
+{
+
+task_batch::task_batch(const std::size_t count)
+  : remaining{count}
+{
+}
+
+bool task_batch::done() const
+{
+  return remaining.load(std::memory_order_acquire) == 0;
+}
+
+void task_batch::fail(std::exception_ptr e)
+{
+  auto lock = std::lock_guard{mutex};
+  if (!exception)
+  {
+    exception = std::move(e);
+  }
+}
 
-std::function<void()> task_manager::make_worker_func()
+void task_batch::complete()
 {
-  return [&] {
+  if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+  {
+    // lock the mutex to ensure that a waiting thread is either already waiting on the
+    // condition variable or has yet to check the predicate
+    {
+      auto lock = std::lock_guard{mutex};
+    }
+    cv.notify_all();
+  }
+}
+
+} // namespace detail
+
+std::function<void()> task_manager::make_worker_func(const std::size_t worker_index)
+{
+  return [&, worker_index] {
+    current_worker = worker_identity{this, worker_index};
+
     while (true)
     {
-      auto lock = std::unique_lock{m_pending_tasks_mutex};
-      m_pending_tasks_cv.wait(
-        lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+      if (run_pending_task(worker_index))
+      {
+        continue;
+      }
+
+      auto lock = std::unique_lock{m_sleep_mutex};
+      m_sleeping_worker_count.fetch_add(1);
+      m_sleep_cv.wait(
+        lock, [&] { return !m_running || m_pending_task_count.load() > 0; });
+      m_sleeping_worker_count.fetch_sub(1);
 
       if (!m_running)
       {
         break;
       }
+    }
+  };
+}
 
-      if (!m_pending_tasks.empty())
-      {
-        auto task = std::move(m_pending_tasks.front());
-        m_pending_tasks.pop();
-        lock.unlock();
+std::optional<std::size_t> task_manager::current_worker_index() const
+{
+  return current_worker.manager == this ? std::optional{current_worker.index}
+                                        : std::nullopt;
+}
+
+void task_manager::push_task(detail::task task)
+{
+  const auto queue_index = current_worker_index().value_or(
+    m_next_queue_index.fetch_add(1, std::memory_order_relaxed) % m_queues.size());
+
+  // count the task before it becomes visible so that the count never drops below zero
+  m_pending_task_count.fetch_add(1);
+
+  {
+    auto& queue = *m_queues[queue_index];
+    auto lock = std::lock_guard{queue.mutex};
+    queue.tasks.push_back(queued_task{std::move(task)});
+  }
+
+  wake_workers(1);
+}
+
+void task_manager::push_tasks(
+  std::vector<detail::task> tasks, const detail::task_batch& batch)
+{
+  if (tasks.empty())
+  {
+    return;
+  }
+
+  const auto task_count = tasks.size();
+  m_pending_task_count.fetch_add(task_count);
 
-        task();
+  if (const auto worker_index = current_worker_index())
+  {
+    // keep the tasks local to this worker, idle workers will steal them
+    auto& queue = *m_queues[*worker_index];
+    auto lock = std::lock_guard{queue.mutex};
+    for (auto& task : tasks)
+    {
+      queue.tasks.push_back(queued_task{std::move(task), &batch});
+    }
+  }
+  else
+  {
+    // distribute contiguous chunks of tasks over all queues
+    const auto queue_count = m_queues.size();
+    const auto first_queue_index =
+      m_next_queue_index.fetch_add(1, std::memory_order_relaxed);
+    const auto chunk_size = (tasks.size() + queue_count - 1) / queue_count;
+
+    auto task_it = tasks.begin();
+    for (std::size_t i = 0; i < queue_count && task_it != tasks.end(); ++i)
+    {
+      auto& queue = *m_queues[(first_queue_index + i) % queue_count];
+      const auto chunk_end =
+        task_it
+        + static_cast<std::ptrdiff_t>(
+          std::min(chunk_size, static_cast<std::size_t>(tasks.end() - task_it)));
+
+      auto lock = std::lock_guard{queue.mutex};
+      for (; task_it != chunk_end; ++task_it)
+      {
+        queue.tasks.push_back(queued_task{std::move(*task_it), &batch});
       }
     }
+  }
+
+  wake_workers(task_count);
+}
+
+void task_manager::wake_workers(const std::size_t count)
+{
+  if (m_sleeping_worker_count.load() > 0)
+  {
+    {
+      auto lock = std::lock_guard{m_sleep_mutex};
+    }
+
+    if (count == 1)
+    {
+      m_sleep_cv.notify_one();
+    }
+    else
+    {
+      m_sleep_cv.notify_all();
+    }
+  }
+}
+
+std::optional<detail::task> task_manager::pop_task(
+  const std::size_t queue_index, const detail::task_batch* batch)
+{
+  if (m_pending_task_count.load() == 0)
+  {
+    return std::nullopt;
+  }
+
+  const auto take = [&](worker_queue& queue, const auto it) {
+    auto task = std::move(it->task);
+    queue.tasks.erase(it);
+    m_pending_task_count.fetch_sub(1);
+    return task;
   };
+
+  if (batch)
+  {
+    for (std::size_t i = 0; i < m_queues.size(); ++i)
+    {
+      auto& queue = *m_queues[(queue_index + i) % m_queues.size()];
+      auto lock = std::lock_guard{queue.mutex};
+      const auto it = std::ranges::find(queue.tasks, batch, &queued_task::batch);
+      if (it != queue.tasks.end())
+      {
+        return take(queue, it);
+      }
+    }
+    return std::nullopt;
+  }
+
+  {
+    auto& queue = *m_queues[queue_index];
+    auto lock = std::lock_guard{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      return take(queue, std::prev(queue.tasks.end()));
+    }
+  }
+
+  for (std::size_t i = 1; i < m_queues.size(); ++i)
+  {
+    auto& queue = *m_queues[(queue_index + i) % m_queues.size()];
+    auto lock = std::lock_guard{queue.mutex};
+    if (!queue.tasks.empty())
+    {
+      return take(queue, queue.tasks.begin());
+    }
+  }
+
+  return std::nullopt;
+}
+
+bool task_manager::run_pending_task(
+  const std::size_t queue_index, const detail::task_batch* batch)
+{
+  if (auto task = pop_task(queue_index, batch))
+  {
+    (*task)();
+    return true;
+  }
+  return false;
+}
+
+void task_manager::wait(detail::task_batch& batch)
+{
+  // help running tasks while waiting so that waiting on a worker thread cannot deadlock;
+  // other threads only help with the tasks of the batch so that they cannot pick up an
+  // unrelated long running task
+  const auto worker_index = current_worker_index();
+  const auto* only_batch = worker_index ? nullptr : &batch;
+  while (!batch.done())
+  {
+    if (!run_pending_task(worker_index.value_or(0), only_batch))
+    {
+      // the remaining tasks of the batch are already running
+      auto lock = std::unique_lock{batch.mutex};
+      batch.cv.wait(lock, [&] { return batch.done(); });
+    }
+  }
+}
+
+std::size_t task_manager::chunk_size(
+  const std::size_t size, const std::size_t min_grain_size) const
+{
+  // aim for several chunks per thread to balance the load if the elements take different
+  // amounts of time to process
+  constexpr auto chunks_per_thread = std::size_t{4};
+
+  const auto thread_count = m_workers.size() + 1;
+  const auto target_chunk_count = thread_count * chunks_per_thread;
+  const auto balanced_chunk_size = (size + target_chunk_count - 1) / target_chunk_count;
+  return std::max({std::size_t{1}, min_grain_size, balanced_chunk_size});
 }
 
 task_manager::task_manager(const std::size_t max_concurrent_tasks)
 {
   for (size_t i = 0; i < max_concurrent_tasks; ++i)
   {
-    m_workers.emplace_back(make_worker_func());
+    m_queues.push_back(std::make_unique<worker_queue>());
+  }
+
+  for (size_t i = 0; i < max_concurrent_tasks; ++i)
+  {
+    m_workers.emplace_back(make_worker_func(i));
   }
 }
 
 task_manager::~task_manager()
 {
   {
-    auto lock = std::lock_guard{m_pending_tasks_mutex};
+    auto lock = std::lock_guard{m_sleep_mutex};
     m_running = false;
   }
 
-  m_pending_tasks_cv.notify_all();
+  m_sleep_cv.notify_all();
   for (auto& worker : m_workers)
   {
     worker.join();
   }
 }
 
+std::size_t task_manager::concurrency() const
+{
+  return m_workers.size();
+}
+
 } // namespace kdl
@@ -23,6 +23,8 @@
 #include "kd/task_manager.h"
 
 #include <memory>
+#include <stdexcept>
+#include <thread>
 #include <tuple>
 
 #include <catch2/catch_test_macros.hpp>
@@ -83,6 +85,45 @@ TEST_CASE("task_manager")
     CHECK(future3.get() == 15);
   }
 
+  SECTION("run_task with exception")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    auto future = tm.run_task([]() -> int { throw std::runtime_error{"asdf"}; });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
+  SECTION("run_task with move only result")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    auto future = tm.run_task([]() { return std::make_unique<int>(7); });
+    CHECK(*future.get() == 7);
+  }
+
+  SECTION("wait for a task in a task")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    auto future = tm.run_task([&]() {
+      auto nested_future = tm.run_task([]() { return 7; });
+      tm.wait(nested_future);
+      return nested_future.get() + 1;
+    });
+
+    tm.wait(future);
+    CHECK(future.get() == 8);
+  }
+
   SECTION("run_tasks")
   {
     SECTION("basic")
@@ -173,6 +214,220 @@ TEST_CASE("task_manager")
     CHECK(task_ran2);
     CHECK(task_ran3);
   }
+
+  SECTION("run_tasks_and_wait preserves order")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u, 3u, 4u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    const auto tasks = std::views::iota(0, 10000) | std::views::transform([](int i) {
+                         return std::function{[i]() { return i * 2; }};
+                       });
+
+    const auto expected = std::views::iota(0, 10000)
+                          | std::views::transform([](int i) { return i * 2; })
+                          | kdl::ranges::to<std::vector>();
+
+    CHECK(tm.run_tasks_and_wait(tasks) == expected);
+  }
+
+  SECTION("run_tasks_and_wait in a task")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u, 3u, 4u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    const auto tasks = std::views::iota(0, 8) | std::views::transform([&](int i) {
+                         return std::function{[&, i]() {
+                           const auto nested_tasks =
+                             std::views::iota(0, 100) | std::views::transform([i](int j) {
+                               return std::function{[i, j]() { return i * 100 + j; }};
+                             });
+                           auto sum = 0;
+                           for (const auto result : tm.run_tasks_and_wait(nested_tasks))
+                           {
+                             sum += result;
+                           }
+                           return sum;
+                         }};
+                       });
+
+    const auto results = tm.run_tasks_and_wait(tasks);
+    REQUIRE(results.size() == 8);
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      CHECK(results[i] == static_cast<int>(i) * 100 * 100 + 4950);
+    }
+  }
+
+  SECTION("run_tasks_and_wait with exception")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    const auto tasks = std::views::iota(0, 10) | std::views::transform([](int i) {
+                         return std::function{[i]() {
+                           if (i == 5)
+                           {
+                             throw std::runtime_error{"asdf"};
+                           }
+                           return i;
+                         }};
+                       });
+
+    CHECK_THROWS_AS(tm.run_tasks_and_wait(tasks), std::runtime_error);
+  }
+
+  SECTION("parallel_for")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u, 3u, 4u);
+    const auto size = GENERATE(0u, 1u, 7u, 1000u);
+    const auto min_grain_size = GENERATE(1u, 16u);
+    CAPTURE(max_concurrent_tasks, size, min_grain_size);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    auto values = std::vector<int>(size, 0);
+    tm.parallel_for(values, [](int& value) { value += 1; }, min_grain_size);
+
+    CHECK(values == std::vector<int>(size, 1));
+  }
+
+  SECTION("parallel_for in a task")
+  {
+    const auto max_concurrent_tasks = GENERATE(1u, 2u, 4u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    auto values = std::vector<std::vector<int>>(8, std::vector<int>(100, 0));
+    tm.parallel_for(values, [&](auto& nested_values) {
+      tm.parallel_for(nested_values, [](int& value) { value += 1; });
+    });
+
+    CHECK(values == std::vector<std::vector<int>>(8, std::vector<int>(100, 1)));
+  }
+
+  SECTION("waiting for a batch does not run unrelated tasks")
+  {
+    auto tm = task_manager{1};
+
+    // keep the only worker busy so that the calling thread has to run the batch
+    auto started = std::promise<void>{};
+    auto release = std::promise<void>{};
+    auto blocker = tm.run_task(
+      [&started, released = release.get_future()]() {
+        started.set_value();
+        released.wait();
+      });
+    started.get_future().wait();
+
+    auto long_task_thread = std::thread::id{};
+    auto long_task = tm.run_task(
+      [&long_task_thread]() { long_task_thread = std::this_thread::get_id(); });
+
+    const auto tasks = std::views::iota(0, 4)
+                       | std::views::transform([](int i) {
+                           return std::function{[i]() { return i; }};
+                         });
+    CHECK(tm.run_tasks_and_wait(tasks) == std::vector<int>{0, 1, 2, 3});
+
+    auto values = std::vector<int>(100, 0);
+    tm.parallel_for(values, [](int& value) { value += 1; });
+    CHECK(values == std::vector<int>(100, 1));
+
+    CHECK(long_task.wait_for(std::chrono::seconds{0}) != std::future_status::ready);
+
+    release.set_value();
+    blocker.get();
+    long_task.get();
+    CHECK(long_task_thread != std::this_thread::get_id());
+  }
+
+  SECTION("parallel_for with exception")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u);
+    CAPTURE(max_concurrent_tasks);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    const auto values = std::views::iota(0, 100) | kdl::ranges::to<std::vector>();
+    CHECK_THROWS_AS(
+      tm.parallel_for(
+        values,
+        [](const int value) {
+          if (value == 50)
+          {
+            throw std::runtime_error{"asdf"};
+          }
+        }),
+      std::runtime_error);
+  }
+
+  SECTION("parallel_transform")
+  {
+    const auto max_concurrent_tasks = GENERATE(0u, 1u, 2u, 3u, 4u);
+    const auto size = GENERATE(0, 1, 7, 1000);
+    CAPTURE(max_concurrent_tasks, size);
+
+    auto tm = task_manager{max_concurrent_tasks};
+
+    const auto values = std::views::iota(0, size) | kdl::ranges::to<std::vector>();
+    const auto expected = values | std::views::transform([](int i) { return i * 2; })
+                          | kdl::ranges::to<std::vector>();
+
+    SECTION("default constructible results")
+    {
+      CHECK(tm.parallel_transform(values, [](int i) { return i * 2; }) == expected);
+    }
+
+    SECTION("non default constructible results")
+    {
+      struct wrapper
+      {
+        int value;
+        explicit wrapper(const int value_)
+          : value{value_}
+        {
+        }
+      };
+
+      const auto results =
+        tm.parallel_transform(values, [](int i) { return wrapper{i * 2}; });
+      CHECK(
+        (results | std::views::transform([](const auto& w) { return w.value; })
+         | kdl::ranges::to<std::vector>())
+        == expected);
+    }
+
+    SECTION("bool results")
+    {
+      const auto is_even = [](int i) { return i % 2 == 0; };
+      CHECK(
+        tm.parallel_transform(values, is_even)
+        == (values | std::views::transform(is_even) | kdl::ranges::to<std::vector>()));
+    }
+
+    SECTION("moving elements out of the range")
+    {
+      auto ptrs = values | std::views::transform([](int i) {
+                    return std::make_unique<int>(i);
+                  })
+                  | kdl::ranges::to<std::vector>();
+
+      const auto results =
+        tm.parallel_transform(ptrs, [](auto& ptr) { return std::move(ptr); });
+      CHECK(
+        (results | std::views::transform([](const auto& ptr) { return *ptr; })
+         | kdl::ranges::to<std::vector>())
+        == values);
+    }
+  }
 }
 
 } // namespace kdl
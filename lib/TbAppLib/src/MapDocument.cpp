@@ -192,6 +192,13 @@ void MapDocument::updateMapFromPreferences()
   m_map->editorContext().setShowPatches(pref(Preferences::ShowPatches));
   m_map->editorContext().setAlignmentLock(pref(Preferences::AlignmentLock));
   m_map->editorContext().setUvLock(pref(Preferences::UvLock));
+
+  const auto undoMemoryLimit = size_t(std::max(pref(Preferences::UndoMemoryLimit), 0));
+  m_map->commandProcessor().setUndoMemoryLimit(undoMemoryLimit * 1024u * 1024u);
+
+  const auto textureCacheSize = size_t(std::max(pref(Preferences::TextureCacheSize), 0));
+  m_map->setTextureCacheEnabled(pref(Preferences::EnableTextureCache));
+  m_map->setTextureCacheMaxSize(textureCacheSize * 1024u * 1024u);
 }
 
 mdl::Map& MapDocument::map()
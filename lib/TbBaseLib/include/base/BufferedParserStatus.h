@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "base/FileLocation.h"
+#include "base/Logger.h"
+#include "base/ParserStatus.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb
+{
+
+/**
+ * Records all logged messages so that they can be passed on to another status later.
+ *
+ * This is useful when parts of a file are parsed in parallel: Every part is parsed with
+ * its own buffered status, and the buffered messages are passed on in file order once all
+ * parts have been parsed. Progress is discarded.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  struct Message
+  {
+    LogLevel level;
+    std::optional<FileLocation> location;
+    std::string str;
+  };
+
+  static NullLogger s_logger;
+  std::vector<Message> m_messages;
+
+public:
+  BufferedParserStatus();
+
+  /**
+   * Passes all recorded messages on to the given status in the order in which they were
+   * logged and clears them.
+   */
+  void flush(ParserStatus& status);
+
+private:
+  void doProgress(double progress) override;
+  void doLogMessage(
+    LogLevel level,
+    const std::optional<FileLocation>& location,
+    const std::string& str) override;
+};
+
+} // namespace tb
@@ -56,15 +56,17 @@ public:
   void error(const std::string& str);
   [[noreturn]] void errorAndThrow(const std::string& str);
 
-private:
-  void log(LogLevel level, const FileLocation& location, const std::string& str);
-  void log(LogLevel level, const std::string& str);
+  void log(
+    LogLevel level, const std::optional<FileLocation>& location, const std::string& str);
 
+private:
   std::string buildMessage(
     const std::optional<FileLocation>& location, const std::string& str) const;
 
 private:
   virtual void doProgress(double progress) = 0;
+  virtual void doLogMessage(
+    LogLevel level, const std::optional<FileLocation>& location, const std::string& str);
   virtual void doLog(LogLevel level, const std::string& str);
 };
 
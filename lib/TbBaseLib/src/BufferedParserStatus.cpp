@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/BufferedParserStatus.h"
+
+#include <optional>
+#include <string>
+
+namespace tb
+{
+
+NullLogger BufferedParserStatus::s_logger;
+
+BufferedParserStatus::BufferedParserStatus()
+  : ParserStatus{s_logger, ""}
+{
+}
+
+void BufferedParserStatus::flush(ParserStatus& status)
+{
+  for (const auto& message : m_messages)
+  {
+    status.log(message.level, message.location, message.str);
+  }
+  m_messages.clear();
+}
+
+void BufferedParserStatus::doProgress(const double /* progress */) {}
+
+void BufferedParserStatus::doLogMessage(
+  const LogLevel level,
+  const std::optional<FileLocation>& location,
+  const std::string& str)
+{
+  m_messages.push_back(Message{level, location, str});
+}
+
+} // namespace tb
@@ -74,22 +74,22 @@ void ParserStatus::errorAndThrow(const FileLocation& location, const std::string
 
 void ParserStatus::debug(const std::string& str)
 {
-  log(LogLevel::Debug, str);
+  log(LogLevel::Debug, std::nullopt, str);
 }
 
 void ParserStatus::info(const std::string& str)
 {
-  log(LogLevel::Info, str);
+  log(LogLevel::Info, std::nullopt, str);
 }
 
 void ParserStatus::warn(const std::string& str)
 {
-  log(LogLevel::Warn, str);
+  log(LogLevel::Warn, std::nullopt, str);
 }
 
 void ParserStatus::error(const std::string& str)
 {
-  log(LogLevel::Error, str);
+  log(LogLevel::Error, std::nullopt, str);
 }
 
 void ParserStatus::errorAndThrow(const std::string& str)
@@ -99,14 +99,11 @@ void ParserStatus::errorAndThrow(const std::string& str)
 }
 
 void ParserStatus::log(
-  const LogLevel level, const FileLocation& location, const std::string& str)
+  const LogLevel level,
+  const std::optional<FileLocation>& location,
+  const std::string& str)
 {
-  doLog(level, buildMessage(location, str));
-}
-
-void ParserStatus::log(const LogLevel level, const std::string& str)
-{
-  doLog(level, buildMessage(std::nullopt, str));
+  doLogMessage(level, location, str);
 }
 
 std::string ParserStatus::buildMessage(
@@ -121,6 +118,14 @@ std::string ParserStatus::buildMessage(
   return msg.str();
 }
 
+void ParserStatus::doLogMessage(
+  const LogLevel level,
+  const std::optional<FileLocation>& location,
+  const std::string& str)
+{
+  doLog(level, buildMessage(location, str));
+}
+
 void ParserStatus::doLog(const LogLevel level, const std::string& str)
 {
   m_logger.log(level, str);
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/BufferedParserStatus.h"
+#include "base/FileLocation.h"
+#include "base/Logger.h"
+#include "base/SimpleParserStatus.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb
+{
+namespace
+{
+
+class TestLogger : public Logger
+{
+public:
+  std::vector<LogLevel> levels;
+  std::vector<std::string> messages;
+
+private:
+  void doLog(const LogLevel level, const std::string_view message) override
+  {
+    levels.push_back(level);
+    messages.emplace_back(message);
+  }
+};
+
+} // namespace
+
+TEST_CASE("BufferedParserStatus")
+{
+  auto logger = TestLogger{};
+  auto targetStatus = SimpleParserStatus{logger, "Map"};
+
+  SECTION("does not pass messages on before flushing")
+  {
+    auto status = BufferedParserStatus{};
+
+    status.warn(FileLocation{1, 2}, "with location");
+    status.error("without location");
+
+    CHECK(logger.messages.empty());
+  }
+
+  SECTION("flush passes messages on in order")
+  {
+    auto status = BufferedParserStatus{};
+
+    status.warn(FileLocation{1, 2}, "with location");
+    status.error("without location");
+    status.info(FileLocation{3}, "without column");
+
+    status.flush(targetStatus);
+
+    CHECK(logger.levels == std::vector{LogLevel::Warn, LogLevel::Error, LogLevel::Info});
+    CHECK(
+      logger.messages
+      == std::vector<std::string>{
+        "Map: At line 1, column 2: with location",
+        "Map: At unknown location: without location",
+        "Map: At line 3: without column",
+      });
+  }
+
+  SECTION("flush clears the messages")
+  {
+    auto status = BufferedParserStatus{};
+
+    status.warn(FileLocation{1, 2}, "asdf");
+    status.flush(targetStatus);
+    status.flush(targetStatus);
+
+    CHECK(logger.messages == std::vector<std::string>{"Map: At line 1, column 2: asdf"});
+  }
+}
+
+} // namespace tb
@@ -52,6 +52,12 @@ Result<std::vector<std::filesystem::path>> find(
 
 Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
 
+/**
+ * Maps the file at the given path into memory for reading. Prefer this over openFile when
+ * the entire file will be read, because it avoids copying the contents into a buffer.
+ */
+Result<std::shared_ptr<MappedFile>> mapFile(const std::filesystem::path& path);
+
 template <typename Stream, typename F>
 auto withStream(
   const std::filesystem::path& path, const std::ios::openmode mode, const F& function)
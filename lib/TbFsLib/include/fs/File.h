@@ -28,6 +28,7 @@
 #include <filesystem>
 #include <memory>
 #include <mutex>
+#include <string_view>
 
 namespace tb::fs
 {
@@ -119,6 +120,37 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a read only memory mapping of a physical file. The contents
+ * are paged in by the operating system when they are accessed and are never copied into
+ * a separate buffer. The mapping is released in the destructor.
+ */
+class MappedFile : public File
+{
+private:
+  kdl::resource<const char*> m_begin;
+  size_t m_size;
+
+  /**
+   * Creates a new file with the given mapped memory region and size in bytes.
+   */
+  MappedFile(kdl::resource<const char*> begin, size_t size);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Returns the mapped contents of this file.
+   */
+  std::string_view stringView() const;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
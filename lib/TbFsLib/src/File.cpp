@@ -27,6 +27,15 @@
 #include <cstdio>
 #include <cstring>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace tb::fs
 {
 
@@ -193,6 +202,141 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
          });
 }
 
+MappedFile::MappedFile(kdl::resource<const char*> begin, const size_t size)
+  : m_begin{std::move(begin)}
+  , m_size{size}
+{
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(*m_begin, *m_begin + m_size);
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+std::string_view MappedFile::stringView() const
+{
+  return m_size > 0 ? std::string_view{*m_begin, m_size} : std::string_view{};
+}
+
+#ifdef _WIN32
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  auto file = kdl::resource{
+    CreateFileW(
+      path.wstring().c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+      nullptr),
+    [](HANDLE h) {
+      if (h != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(h);
+      }
+    }};
+  if (*file == INVALID_HANDLE_VALUE)
+  {
+    return Error{fmt::format("Failed to open '{}': error {}", path, GetLastError())};
+  }
+
+  auto fileSize = LARGE_INTEGER{};
+  if (!GetFileSizeEx(*file, &fileSize))
+  {
+    return Error{
+      fmt::format("Failed to get size of '{}': error {}", path, GetLastError())};
+  }
+
+  const auto size = static_cast<size_t>(fileSize.QuadPart);
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{
+      new MappedFile{kdl::resource<const char*>{nullptr, [](auto) {}}, 0}};
+  }
+
+  // the view keeps the file and the mapping open, so their handles can be closed
+  const auto mapping = kdl::resource{
+    CreateFileMappingW(*file, nullptr, PAGE_READONLY, 0, 0, nullptr),
+    [](HANDLE h) {
+      if (h)
+      {
+        CloseHandle(h);
+      }
+    }};
+  if (!*mapping)
+  {
+    return Error{fmt::format("Failed to map '{}': error {}", path, GetLastError())};
+  }
+
+  const auto* begin =
+    static_cast<const char*>(MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!begin)
+  {
+    return Error{fmt::format("Failed to map '{}': error {}", path, GetLastError())};
+  }
+
+  // NOLINTNEXTLINE
+  return std::shared_ptr<MappedFile>{new MappedFile{
+    kdl::resource<const char*>{begin, [](const char* b) { UnmapViewOfFile(b); }}, size}};
+}
+
+#else
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  const auto fd = kdl::resource{open(path.c_str(), O_RDONLY), [](const int d) {
+                                  if (d >= 0)
+                                  {
+                                    close(d);
+                                  }
+                                }};
+  if (*fd < 0)
+  {
+    return Error{fmt::format("Failed to open '{}': {}", path, std::strerror(errno))};
+  }
+
+  struct stat stats;
+  if (fstat(*fd, &stats) != 0)
+  {
+    return Error{
+      fmt::format("Failed to get size of '{}': {}", path, std::strerror(errno))};
+  }
+
+  const auto size = static_cast<size_t>(stats.st_size);
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{
+      new MappedFile{kdl::resource<const char*>{nullptr, [](auto) {}}, 0}};
+  }
+
+  // the mapping keeps the file open, so the descriptor can be closed
+  auto* begin = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, *fd, 0);
+  if (begin == MAP_FAILED)
+  {
+    return Error{fmt::format("Failed to map '{}': {}", path, std::strerror(errno))};
+  }
+
+  // NOLINTNEXTLINE
+  return std::shared_ptr<MappedFile>{new MappedFile{
+    kdl::resource<const char*>{
+      static_cast<const char*>(begin),
+      [=](const char* b) { munmap(const_cast<char*>(b), size); }},
+    size}};
+}
+
+#endif
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
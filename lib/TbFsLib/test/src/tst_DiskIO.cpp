@@ -245,6 +245,20 @@ TEST_CASE("DiskIO")
     CHECK(fs::Disk::openFile(env.dir() / "linkedTest2.map"));
   }
 
+  SECTION("mapFile")
+  {
+    CHECK(
+      fs::Disk::mapFile(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<MappedFile>>{Error{fmt::format(
+        "Failed to open {}: path does not denote a file",
+        env.dir() / "does_not_exist.txt")}});
+    CHECK(fs::Disk::mapFile(env.dir() / "anotherDir").is_error());
+
+    const auto file = fs::Disk::mapFile(env.dir() / "test.txt") | kdl::value();
+    CHECK(file->stringView() == "some content");
+    CHECK(fs::Disk::mapFile(env.dir() / "linkedTest2.map"));
+  }
+
   SECTION("withStream")
   {
     SECTION("withInputStream")
@@ -105,6 +105,52 @@ TEST_CASE("CFile")
   }
 }
 
+TEST_CASE("MappedFile")
+{
+  auto env = TestEnvironment{};
+
+  SECTION("createMappedFile")
+  {
+    CHECK(createMappedFile(env.dir() / "does_not_exist.txt").is_error());
+
+    env.createFile("foo.txt", "hello world");
+    const auto file = createMappedFile(env.dir() / "foo.txt") | kdl::value();
+    CHECK(file->size() == 11);
+  }
+
+  SECTION("empty file")
+  {
+    env.createFile("empty.txt", "");
+    const auto file = createMappedFile(env.dir() / "empty.txt") | kdl::value();
+    CHECK(file->size() == 0);
+    CHECK(file->stringView().empty());
+    CHECK(file->reader().size() == 0);
+  }
+
+  SECTION("reader")
+  {
+    env.createFile("foo.txt", "hello world");
+    const auto file = createMappedFile(env.dir() / "foo.txt") | kdl::value();
+
+    auto reader = file->reader();
+    CHECK(reader.readString(reader.size()) == "hello world");
+  }
+
+  SECTION("stringView")
+  {
+    env.createFile("foo.txt", "hello world");
+    const auto file = createMappedFile(env.dir() / "foo.txt") | kdl::value();
+    CHECK(file->stringView() == "hello world");
+  }
+
+  SECTION("buffered reader does not copy the mapped contents")
+  {
+    env.createFile("foo.txt", "hello world");
+    const auto file = createMappedFile(env.dir() / "foo.txt") | kdl::value();
+    CHECK(file->reader().buffer().stringView().data() == file->stringView().data());
+  }
+}
+
 TEST_CASE("FileView")
 {
   auto env = TestEnvironment{};
@@ -61,6 +61,12 @@ public:
 
   const Material* materialByName(const std::string& name) const;
   Material* materialByName(const std::string& name);
+
+  /**
+   * Returns the number of bytes currently occupied by the textures of this collection.
+   * Textures that are not loaded or that were evicted do not count.
+   */
+  size_t memoryUsage() const;
 };
 
 } // namespace tb::gl
@@ -169,6 +169,25 @@ public:
    */
   void render(Gl& gl, VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Renders the primitives stored in this index range map once for each of the given
+   * number of instances. The given setup function is called with the index of an instance
+   * before its primitives are rendered, e.g. to set its transformation. Every material is
+   * activated only once for all instances.
+   *
+   * @param gl the GL interface
+   * @param vertexArray the vertex array to render with
+   * @param func the material callbacks
+   * @param instanceCount the number of instances to render
+   * @param setupInstance the function to call before rendering an instance
+   */
+  void renderInstances(
+    Gl& gl,
+    VertexArray& vertexArray,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -22,6 +22,7 @@
 #include "gl/MaterialIndexRangeMap.h"
 #include "gl/VertexArray.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -43,6 +44,19 @@ public:
   virtual void prepare(Gl& gl, VboManager& vboManager) = 0;
   virtual void render(
     Gl& gl, ShaderProgram& currentProgram, MaterialRenderFunc& func) = 0;
+
+  /**
+   * Renders the geometry once for each of the given number of instances, calling
+   * `setupInstance` with the index of an instance before it is rendered. Unlike calling
+   * render() once per instance, the vertex array is set up and every material is
+   * activated only once for all instances.
+   */
+  virtual void renderInstances(
+    Gl& gl,
+    ShaderProgram& currentProgram,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) = 0;
 };
 
 class MaterialIndexRangeRenderer : public MaterialRenderer
@@ -62,6 +76,12 @@ public:
 
   void prepare(Gl& gl, VboManager& vboManager) override;
   void render(Gl& gl, ShaderProgram& currentProgram, MaterialRenderFunc& func) override;
+  void renderInstances(
+    Gl& gl,
+    ShaderProgram& currentProgram,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) override;
 };
 
 class MultiMaterialIndexRangeRenderer : public MaterialRenderer
@@ -78,6 +98,12 @@ public:
 
   void prepare(Gl& gl, VboManager& vboManager) override;
   void render(Gl& gl, ShaderProgram& currentProgram, MaterialRenderFunc& func) override;
+  void renderInstances(
+    Gl& gl,
+    ShaderProgram& currentProgram,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance) override;
 };
 
 } // namespace tb::gl
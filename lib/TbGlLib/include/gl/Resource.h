@@ -27,10 +27,13 @@
 #include "kd/reflection_impl.h"
 #include "kd/result.h"
 
+#include <chrono>
+#include <concepts>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <variant>
 
 namespace tb::gl
@@ -72,6 +75,18 @@ public:
 using Task = std::function<std::unique_ptr<TaskResult>()>;
 using TaskRunner = std::function<std::future<std::unique_ptr<TaskResult>>(Task)>;
 
+/**
+ * A hint that tells the resource manager which resources to process first. Resources that
+ * are currently visible, e.g. in the 3D view or in the material browser, should be made
+ * ready before any others. The resource manager resets the hint whenever it processes
+ * the pending resources, so it must be renewed every frame.
+ */
+enum class ResourcePriority
+{
+  Normal,
+  Visible,
+};
+
 template <typename T>
 struct ResourceUnloaded
 {
@@ -104,6 +119,14 @@ struct ResourceReady
   kdl_reflect_inline(ResourceReady, resource);
 };
 
+template <typename T>
+struct ResourceEvicted
+{
+  T resource;
+
+  kdl_reflect_inline(ResourceEvicted, resource);
+};
+
 template <typename T>
 struct ResourceDropping
 {
@@ -132,7 +155,8 @@ using ResourceState = std::variant<
   ResourceReady<T>,
   ResourceDropping<T>,
   ResourceDropped,
-  ResourceFailed>;
+  ResourceFailed,
+  ResourceEvicted<T>>;
 
 template <typename T>
 std::ostream& operator<<(std::ostream& lhs, const ResourceState<T>& rhs)
@@ -185,6 +209,13 @@ ResourceState<T> upload(ResourceLoaded<T> state, Gl& gl)
   return ResourceReady<T>{std::move(state.resource)};
 }
 
+template <typename T>
+ResourceState<T> evict(ResourceReady<T> state, Gl& gl)
+{
+  state.resource.drop(gl);
+  return ResourceEvicted<T>{std::move(state.resource)};
+}
+
 template <typename T>
 ResourceState<T> triggerDropping(ResourceReady<T> state)
 {
@@ -218,9 +249,17 @@ ResourceState<T> drop(ResourceDropping<T> state, Gl& gl)
  * | Loading        | process          | Loaded or Failed|
  * | Loaded         | process          | Ready           |
  * | Ready          | drop             | Dropping        |
+ * | Ready          | evict            | Evicted         |
+ * | Evicted        | reload           | Unloaded        |
+ * | Evicted        | drop             | Dropped         |
  * | Dropping       | process          | Dropped         |
  * | Dropped        | -                | -               |
  * | Failed         | -                | -               |
+ *
+ * Evicting a resource releases its GPU data, and reloading it runs its loader again. The
+ * evicted resource remains accessible until the reloaded resource has been loaded, so
+ * that its metadata, e.g. the size of a texture, does not change in the meantime. Only
+ * resources that were created with a loader can be evicted.
  */
 template <typename T>
 class Resource
@@ -228,12 +267,19 @@ class Resource
 private:
   ResourceId m_id;
   ResourceState<T> m_state;
+  ResourceLoader<T> m_loader;
+  std::optional<T> m_evictedResource;
+  ResourcePriority m_priority = ResourcePriority::Normal;
+  std::chrono::steady_clock::time_point m_lastUse;
+  std::function<void()> m_useCallback;
+  std::function<void()> m_reloadCallback;
 
   kdl_reflect_inline(Resource, m_state);
 
 public:
   explicit Resource(ResourceLoader<T> loader)
-    : m_state(ResourceUnloaded<T>{std::move(loader)})
+    : m_state(ResourceUnloaded<T>{loader})
+    , m_loader{std::move(loader)}
   {
   }
 
@@ -248,13 +294,68 @@ public:
 
   const ResourceState<T>& state() const { return m_state; }
 
+  ResourcePriority priority() const { return m_priority; }
+  void setPriority(const ResourcePriority priority) { m_priority = priority; }
+
+  std::chrono::steady_clock::time_point lastUse() const { return m_lastUse; }
+  void markUsed()
+  {
+    m_lastUse = std::chrono::steady_clock::now();
+    if (m_useCallback)
+    {
+      m_useCallback();
+    }
+  }
+
+  /**
+   * Sets a function to call whenever this resource is marked as used.
+   */
+  void setUseCallback(std::function<void()> useCallback)
+  {
+    m_useCallback = std::move(useCallback);
+  }
+
+  /**
+   * Sets a function to call whenever this resource is reloaded after it was evicted.
+   */
+  void setReloadCallback(std::function<void()> reloadCallback)
+  {
+    m_reloadCallback = std::move(reloadCallback);
+  }
+
+  /**
+   * Returns the number of bytes occupied by the loaded or uploaded resource, or 0 if the
+   * resource type does not report its memory usage.
+   */
+  std::size_t memoryUsage() const
+  {
+    if constexpr (requires(const T& t) {
+                    { t.memoryUsage() } -> std::convertible_to<std::size_t>;
+                  })
+    {
+      return std::visit(
+        kdl::overload(
+          [](const ResourceLoaded<T>& state) { return state.resource.memoryUsage(); },
+          [](const ResourceReady<T>& state) { return state.resource.memoryUsage(); },
+          [](const auto&) -> std::size_t { return 0; }),
+        m_state);
+    }
+    else
+    {
+      return 0;
+    }
+  }
+
   const T* get() const
   {
     return std::visit(
       kdl::overload(
         [](const ResourceLoaded<T>& state) -> const T* { return &state.resource; },
         [](const ResourceReady<T>& state) -> const T* { return &state.resource; },
-        [](const auto&) -> const T* { return nullptr; }),
+        [](const ResourceEvicted<T>& state) -> const T* { return &state.resource; },
+        [&](const auto&) -> const T* {
+          return m_evictedResource ? &*m_evictedResource : nullptr;
+        }),
       m_state);
   }
 
@@ -264,16 +365,25 @@ public:
       kdl::overload(
         [](ResourceLoaded<T>& state) -> T* { return &state.resource; },
         [](ResourceReady<T>& state) -> T* { return &state.resource; },
-        [](auto&) -> T* { return nullptr; }),
+        [](ResourceEvicted<T>& state) -> T* { return &state.resource; },
+        [&](auto&) -> T* { return m_evictedResource ? &*m_evictedResource : nullptr; }),
       m_state);
   }
 
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
+  bool isEvicted() const { return std::holds_alternative<ResourceEvicted<T>>(m_state); }
+
+  bool canEvict() const
+  {
+    return m_loader && std::holds_alternative<ResourceReady<T>>(m_state);
+  }
+
   bool needsProcessing() const
   {
     return !std::holds_alternative<ResourceReady<T>>(m_state)
-           && !std::holds_alternative<ResourceFailed>(m_state);
+           && !std::holds_alternative<ResourceFailed>(m_state)
+           && !std::holds_alternative<ResourceEvicted<T>>(m_state);
   }
 
   bool process(TaskRunner taskRunner, const ProcessContext& context)
@@ -298,6 +408,13 @@ public:
 
     if (previousStateIndex != m_state.index())
     {
+      if (
+        !std::holds_alternative<ResourceUnloaded<T>>(m_state)
+        && !std::holds_alternative<ResourceLoading<T>>(m_state))
+      {
+        m_evictedResource = std::nullopt;
+      }
+
       if (const auto* failedState = std::get_if<ResourceFailed>(&m_state))
       {
         context.errorHandler(m_id, failedState->error);
@@ -308,8 +425,33 @@ public:
     return false;
   }
 
+  void evict(Gl& gl)
+  {
+    m_state = std::visit(
+      kdl::overload(
+        [&](ResourceReady<T> state) -> ResourceState<T> {
+          return detail::evict(std::move(state), gl);
+        },
+        [](auto state) -> ResourceState<T> { return state; }),
+      std::move(m_state));
+  }
+
+  void reload()
+  {
+    if (auto* evictedState = std::get_if<ResourceEvicted<T>>(&m_state))
+    {
+      m_evictedResource = std::move(evictedState->resource);
+      m_state = ResourceUnloaded<T>{m_loader};
+      if (m_reloadCallback)
+      {
+        m_reloadCallback();
+      }
+    }
+  }
+
   void drop()
   {
+    m_evictedResource = std::nullopt;
     m_state = std::visit(
       kdl::overload(
         [](ResourceLoaded<T>) -> ResourceState<T> { return ResourceDropped{}; },
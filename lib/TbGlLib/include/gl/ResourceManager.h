@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "base/Macros.h"
 #include "base/Notifier.h"
 #include "gl/Resource.h"
 #include "gl/ResourceId.h"
@@ -28,7 +29,11 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
+#include <limits>
+#include <list>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <vector>
 
@@ -45,8 +50,19 @@ public:
   virtual long useCount() const = 0;
 
   virtual bool isDropped() const = 0;
+  virtual bool isEvicted() const = 0;
+  virtual bool canEvict() const = 0;
   virtual bool needsProcessing() const = 0;
 
+  virtual ResourcePriority priority() const = 0;
+  virtual void setPriority(ResourcePriority priority) = 0;
+
+  virtual std::chrono::steady_clock::time_point lastUse() const = 0;
+  virtual void setUseCallback(std::function<void()> useCallback) = 0;
+  virtual void setReloadCallback(std::function<void()> reloadCallback) = 0;
+  virtual std::size_t memoryUsage() const = 0;
+
+  virtual void evict(Gl& gl) = 0;
   virtual void drop() = 0;
   virtual bool process(TaskRunner taskRunner, const ProcessContext& processContext) = 0;
 };
@@ -68,7 +84,28 @@ public:
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
   bool isDropped() const override { return m_resource->isDropped(); }
+  bool isEvicted() const override { return m_resource->isEvicted(); }
+  bool canEvict() const override { return m_resource->canEvict(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
+  ResourcePriority priority() const override { return m_resource->priority(); }
+  void setPriority(const ResourcePriority priority) override
+  {
+    m_resource->setPriority(priority);
+  }
+  std::chrono::steady_clock::time_point lastUse() const override
+  {
+    return m_resource->lastUse();
+  }
+  void setUseCallback(std::function<void()> useCallback) override
+  {
+    m_resource->setUseCallback(std::move(useCallback));
+  }
+  void setReloadCallback(std::function<void()> reloadCallback) override
+  {
+    m_resource->setReloadCallback(std::move(reloadCallback));
+  }
+  std::size_t memoryUsage() const override { return m_resource->memoryUsage(); }
+  void evict(Gl& gl) override { m_resource->evict(gl); }
   void drop() override { m_resource->drop(); }
   bool process(TaskRunner taskRunner, const ProcessContext& processContext) override
   {
@@ -84,26 +121,110 @@ public:
   };
 };
 
+/**
+ * Owns the resources and drives their state transitions.
+ *
+ * The resources that need processing are kept in a separate pending queue so that a call
+ * to process only visits the resources that have work to do. Resources with the visible
+ * priority hint are processed first, and the order of the others is preserved.
+ *
+ * A resource that is no longer used by anyone but this manager is dropped. Since the use
+ * counts cannot be observed, they are checked for a bounded number of resources per call
+ * to process, continuing where the previous call left off.
+ *
+ * The manager keeps track of the memory occupied by its resources. If it exceeds the
+ * memory budget, the least recently used resources are evicted until the budget is met
+ * again. The resources are kept in the order of their last use, so that eviction only
+ * visits the resources that it evicts or skips. Resources that were used since the
+ * previous call to process are never evicted. The evicted resources are reported as
+ * processed. An evicted resource is reloaded once it is requested again, and it notifies
+ * this manager so that it becomes pending again.
+ */
 class ResourceManager
 {
 public:
+  static constexpr std::size_t MaxUseCountChecksPerProcess = 512;
+
   Notifier<const std::vector<ResourceId>&> resourcesWereProcessedNotifier;
 
 private:
-  std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
+
+  struct ResourceEntry;
+  using ResourceList = std::list<ResourceEntry>;
+  using UseOrder = std::list<ResourceList::iterator>;
+
+  struct ResourceEntry
+  {
+    std::unique_ptr<ResourceWrapperBase> wrapper;
+    bool pending = false;
+    std::size_t memoryUsage = 0;
+    std::optional<UseOrder::iterator> usePosition = std::nullopt;
+  };
+
+  // in the order in which the resources were added
+  ResourceList m_resources;
+
+  // the resources that can be evicted, least recently used first; resources that were
+  // never used come first
+  UseOrder m_useOrder;
+  std::vector<ResourceList::iterator> m_pendingResources;
+  ResourceList::iterator m_nextUseCountCheck = m_resources.end();
+
+  std::size_t m_memoryBudget = std::numeric_limits<std::size_t>::max();
+  std::size_t m_memoryUsage = 0;
+  std::size_t m_memoryUsageAfterEviction = 0;
+  std::chrono::steady_clock::time_point m_lastProcessTime;
 
 public:
+  ResourceManager() = default;
+
+  ~ResourceManager()
+  {
+    for (auto& entry : m_resources)
+    {
+      entry.wrapper->setUseCallback({});
+      entry.wrapper->setReloadCallback({});
+    }
+  }
+
+  deleteCopyAndMove(ResourceManager);
+
+  /**
+   * Indicates whether the next call to process has any work to do. Only the pending
+   * resources and the resources whose use counts are checked next are visited.
+   *
+   * If there are more than MaxUseCountChecksPerProcess resources, an unused resource
+   * whose use count is not checked by the next call to process is not reported. It is
+   * found by a later call once the use count checks reach it. So if this returns false,
+   * no resource is pending, but there may still be unused resources to release.
+   */
   bool needsProcessing() const
   {
-    return std::ranges::any_of(m_resources, [](const auto& resourceWrapper) {
-      return resourceWrapper->useCount() == 1 || resourceWrapper->needsProcessing();
-    });
+    return !m_pendingResources.empty() || needsUseCountCheck();
+  }
+
+  std::size_t memoryUsage() const { return m_memoryUsage; }
+
+  std::size_t memoryBudget() const { return m_memoryBudget; }
+
+  /**
+   * Sets the number of bytes that the resources may occupy. The budget is not clamped, so
+   * a budget of 0 evicts every resource that was not used since the previous call to
+   * process.
+   */
+  void setMemoryBudget(const std::size_t memoryBudget)
+  {
+    if (memoryBudget != m_memoryBudget)
+    {
+      m_memoryBudget = memoryBudget;
+      m_memoryUsageAfterEviction = 0;
+    }
   }
 
   std::vector<const ResourceWrapperBase*> resources() const
   {
-    return m_resources | std::views::transform([](const auto& resourceWrapper) {
-             return static_cast<const ResourceWrapperBase*>(resourceWrapper.get());
+    return m_resources | std::views::transform([](const auto& entry) {
+             return static_cast<const ResourceWrapperBase*>(entry.wrapper.get());
            })
            | kdl::ranges::to<std::vector>();
   }
@@ -111,8 +232,19 @@ public:
   template <typename ResourceT>
   void addResource(std::shared_ptr<Resource<ResourceT>> resource)
   {
-    m_resources.push_back(
-      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
+    m_resources.push_back(ResourceEntry{
+      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)),
+    });
+
+    const auto it = std::prev(m_resources.end());
+    it->usePosition = m_useOrder.insert(m_useOrder.begin(), it);
+    it->wrapper->setUseCallback([this, it]() { markUsed(it); });
+    it->wrapper->setReloadCallback([this, it]() { addPendingResource(it); });
+    updateMemoryUsage(it);
+    if (it->wrapper->needsProcessing())
+    {
+      addPendingResource(it);
+    }
   }
 
   void process(
@@ -127,34 +259,207 @@ public:
       }}
               : std::function{[]() { return true; }};
 
+    checkUseCounts();
+
+    std::ranges::stable_partition(m_pendingResources, [](const auto& it) {
+      return it->wrapper->priority() == ResourcePriority::Visible;
+    });
+    for (auto& it : m_pendingResources)
+    {
+      it->wrapper->setPriority(ResourcePriority::Normal);
+    }
+
     auto processedResourceIds = std::vector<ResourceId>{};
+    auto remainingResources = std::vector<ResourceList::iterator>{};
 
-    for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
+    auto next = m_pendingResources.begin();
+    for (; next != m_pendingResources.end() && checkTimeout(); ++next)
     {
-      auto& resourceWrapper = *it;
-      if (resourceWrapper->useCount() == 1 && !resourceWrapper->isDropped())
+      const auto it = *next;
+      auto& resourceWrapper = *it->wrapper;
+      if (resourceWrapper.useCount() == 1 && !resourceWrapper.isDropped())
       {
-        resourceWrapper->drop();
+        resourceWrapper.drop();
       }
 
-      if (resourceWrapper->needsProcessing())
+      if (resourceWrapper.needsProcessing())
       {
-        if (resourceWrapper->process(taskRunner, processContext))
+        if (resourceWrapper.process(taskRunner, processContext))
         {
-          processedResourceIds.push_back(resourceWrapper->id());
+          processedResourceIds.push_back(resourceWrapper.id());
         }
       }
 
-      it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
-             ? m_resources.erase(it)
-             : std::next(it);
+      updateMemoryUsage(it);
+
+      if (resourceWrapper.useCount() == 1 && resourceWrapper.isDropped())
+      {
+        removeResource(it);
+      }
+      else if (resourceWrapper.needsProcessing())
+      {
+        remainingResources.push_back(it);
+      }
+      else
+      {
+        it->pending = false;
+      }
     }
 
+    remainingResources.insert(remainingResources.end(), next, m_pendingResources.end());
+    m_pendingResources = std::move(remainingResources);
+
+    evictLeastRecentlyUsedResources(processContext.gl, processedResourceIds);
+    m_lastProcessTime = std::chrono::steady_clock::now();
+
     if (!processedResourceIds.empty())
     {
       resourcesWereProcessedNotifier(processedResourceIds);
     }
   }
+
+private:
+  void addPendingResource(const ResourceList::iterator it)
+  {
+    if (!it->pending)
+    {
+      it->pending = true;
+      m_pendingResources.push_back(it);
+    }
+  }
+
+  void removeResource(const ResourceList::iterator it)
+  {
+    if (m_nextUseCountCheck == it)
+    {
+      ++m_nextUseCountCheck;
+    }
+    it->wrapper->setUseCallback({});
+    it->wrapper->setReloadCallback({});
+    removeFromUseOrder(it);
+    m_memoryUsage -= it->memoryUsage;
+    m_resources.erase(it);
+  }
+
+  void markUsed(const ResourceList::iterator it)
+  {
+    if (it->usePosition)
+    {
+      m_useOrder.splice(m_useOrder.end(), m_useOrder, *it->usePosition);
+    }
+    else
+    {
+      it->usePosition = m_useOrder.insert(m_useOrder.end(), it);
+    }
+  }
+
+  void removeFromUseOrder(const ResourceList::iterator it)
+  {
+    if (it->usePosition)
+    {
+      m_useOrder.erase(*it->usePosition);
+      it->usePosition = std::nullopt;
+    }
+  }
+
+  void updateMemoryUsage(const ResourceList::iterator it)
+  {
+    m_memoryUsage -= it->memoryUsage;
+    it->memoryUsage = it->wrapper->memoryUsage();
+    m_memoryUsage += it->memoryUsage;
+  }
+
+  void evictLeastRecentlyUsedResources(
+    Gl& gl, std::vector<ResourceId>& evictedResourceIds)
+  {
+    // don't search for resources to evict again unless the memory usage has grown
+    m_memoryUsageAfterEviction = std::min(m_memoryUsageAfterEviction, m_memoryUsage);
+    if (m_memoryUsage <= m_memoryBudget || m_memoryUsage <= m_memoryUsageAfterEviction)
+    {
+      return;
+    }
+
+    auto next = m_useOrder.begin();
+    while (next != m_useOrder.end() && m_memoryUsage > m_memoryBudget)
+    {
+      const auto it = *next++;
+      auto& resourceWrapper = *it->wrapper;
+      if (resourceWrapper.lastUse() >= m_lastProcessTime)
+      {
+        // this and all remaining resources were used since the previous call
+        break;
+      }
+
+      if (it->pending)
+      {
+        // the resource can be evicted once it has been processed
+        continue;
+      }
+
+      if (it->memoryUsage > 0 && resourceWrapper.canEvict())
+      {
+        resourceWrapper.evict(gl);
+        updateMemoryUsage(it);
+        evictedResourceIds.push_back(resourceWrapper.id());
+      }
+
+      // the resource is added again when it is used
+      removeFromUseOrder(it);
+    }
+
+    m_memoryUsageAfterEviction = m_memoryUsage;
+  }
+
+  /**
+   * Indicates whether any of the resources whose use counts are checked by the next call
+   * to checkUseCounts is unused or needs processing.
+   */
+  bool needsUseCountCheck() const
+  {
+    auto next = ResourceList::const_iterator{m_nextUseCountCheck};
+    const auto count = std::min(m_resources.size(), MaxUseCountChecksPerProcess);
+    for (std::size_t i = 0; i < count; ++i, ++next)
+    {
+      if (next == m_resources.end())
+      {
+        next = m_resources.begin();
+      }
+
+      if (next->wrapper->useCount() == 1 || next->wrapper->needsProcessing())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Drops the unused resources among the next MaxUseCountChecksPerProcess resources and
+   * adds them to the pending resources so that they are released in the next pass.
+   */
+  void checkUseCounts()
+  {
+    const auto count = std::min(m_resources.size(), MaxUseCountChecksPerProcess);
+    for (std::size_t i = 0; i < count; ++i, ++m_nextUseCountCheck)
+    {
+      if (m_nextUseCountCheck == m_resources.end())
+      {
+        m_nextUseCountCheck = m_resources.begin();
+      }
+
+      auto& resourceWrapper = *m_nextUseCountCheck->wrapper;
+      if (resourceWrapper.useCount() == 1 && !resourceWrapper.isDropped())
+      {
+        resourceWrapper.drop();
+      }
+
+      if (resourceWrapper.needsProcessing())
+      {
+        addPendingResource(m_nextUseCountCheck);
+      }
+      updateMemoryUsage(m_nextUseCountCheck);
+    }
+  }
 };
 
 } // namespace tb::gl
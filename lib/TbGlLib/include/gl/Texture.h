@@ -72,8 +72,9 @@ struct TextureReadyState
 {
   GLuint textureId;
   bool useMipmap;
+  size_t memoryUsage = 0;
 
-  kdl_reflect_decl(TextureReadyState, textureId, useMipmap);
+  kdl_reflect_decl(TextureReadyState, textureId, useMipmap, memoryUsage);
 };
 
 struct TextureDroppedState
@@ -157,6 +158,12 @@ public:
   void upload(Gl& gl);
   void drop(Gl& gl);
 
+  /**
+   * Returns the number of bytes occupied by the texture data, i.e. the buffers if the
+   * texture is loaded, or the texture memory on the GPU if it is uploaded.
+   */
+  size_t memoryUsage() const;
+
   const std::vector<TextureBuffer>& buffersIfLoaded() const;
 
 private:
@@ -227,6 +227,18 @@ void Material::decUsageCount() const
 
 void Material::activate(Gl& gl, const int minFilter, const int magFilter) const
 {
+  m_textureResource->markUsed();
+  if (m_textureResource->isEvicted())
+  {
+    m_textureResource->reload();
+  }
+
+  if (m_textureResource->needsProcessing())
+  {
+    // this material is being rendered, so its texture should be made ready first
+    m_textureResource->setPriority(ResourcePriority::Visible);
+  }
+
   if (const auto* texture = m_textureResource->get();
       texture && texture->activate(gl, minFilter, magFilter))
   {
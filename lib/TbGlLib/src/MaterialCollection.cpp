@@ -92,4 +92,14 @@ Material* MaterialCollection::materialByName(const std::string& name)
   return KDL_CONST_OVERLOAD(materialByName(name));
 }
 
+size_t MaterialCollection::memoryUsage() const
+{
+  auto result = size_t(0);
+  for (const auto& material : m_materials)
+  {
+    result += material.textureResource().memoryUsage();
+  }
+  return result;
+}
+
 } // namespace tb::gl
@@ -141,6 +141,25 @@ void MaterialIndexRangeMap::render(
   }
 }
 
+void MaterialIndexRangeMap::renderInstances(
+  Gl& gl,
+  VertexArray& vertexArray,
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& setupInstance)
+{
+  for (const auto& [material, indexArray] : *m_data)
+  {
+    func.before(gl, material);
+    for (size_t i = 0; i < instanceCount; ++i)
+    {
+      setupInstance(i);
+      indexArray.render(gl, vertexArray);
+    }
+    func.after(gl, material);
+  }
+}
+
 void MaterialIndexRangeMap::forEachPrimitive(
   std::function<void(const Material*, PrimType, size_t, size_t)> func) const
 {
@@ -64,6 +64,20 @@ void MaterialIndexRangeRenderer::render(
   }
 }
 
+void MaterialIndexRangeRenderer::renderInstances(
+  Gl& gl,
+  ShaderProgram& currentProgram,
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& setupInstance)
+{
+  if (instanceCount > 0 && m_vertexArray.setup(gl, currentProgram))
+  {
+    m_indexRange.renderInstances(gl, m_vertexArray, func, instanceCount, setupInstance);
+    m_vertexArray.cleanup(gl, currentProgram);
+  }
+}
+
 MultiMaterialIndexRangeRenderer::MultiMaterialIndexRangeRenderer(
   std::vector<std::unique_ptr<MaterialIndexRangeRenderer>> renderers)
   : m_renderers{std::move(renderers)}
@@ -101,4 +115,17 @@ void MultiMaterialIndexRangeRenderer::render(
   }
 }
 
+void MultiMaterialIndexRangeRenderer::renderInstances(
+  Gl& gl,
+  ShaderProgram& currentProgram,
+  MaterialRenderFunc& func,
+  const size_t instanceCount,
+  const std::function<void(size_t)>& setupInstance)
+{
+  for (auto& renderer : m_renderers)
+  {
+    renderer->renderInstances(gl, currentProgram, func, instanceCount, setupInstance);
+  }
+}
+
 } // namespace tb::gl
@@ -69,6 +69,7 @@ auto uploadTexture(
 {
   const auto compressed = isCompressedFormat(format);
   auto useMipmap = false;
+  auto memoryUsage = size_t(0);
 
   auto textureId = GLuint(0);
   gl.genTextures(1, &textureId);
@@ -118,6 +119,8 @@ auto uploadTexture(
         0,
         dataSize,
         data);
+
+      memoryUsage += buffers[j].size();
     }
     else
     {
@@ -131,10 +134,13 @@ auto uploadTexture(
         format,
         GL_UNSIGNED_BYTE,
         data);
+
+      // uncompressed textures are stored as RGBA regardless of the source format
+      memoryUsage += mipSize.x() * mipSize.y() * 4;
     }
   }
 
-  return std::tuple{textureId, useMipmap};
+  return std::tuple{textureId, useMipmap, memoryUsage};
 }
 
 void dropTexture(Gl& gl, GLuint textureId)
@@ -315,9 +321,9 @@ void Texture::upload(Gl& gl)
   m_state = std::visit(
     kdl::overload(
       [&](const TextureLoadedState& textureLoadedState) -> TextureState {
-        const auto [textureId, useMipmap] = uploadTexture(
+        const auto [textureId, useMipmap, memoryUsage] = uploadTexture(
           gl, m_format, m_mask, textureLoadedState.buffers, m_width, m_height);
-        return TextureReadyState{textureId, useMipmap};
+        return TextureReadyState{textureId, useMipmap, memoryUsage};
       },
       [](TextureReadyState textureReadyState) -> TextureState {
         return textureReadyState;
@@ -341,6 +347,23 @@ void Texture::drop(Gl& gl)
     std::move(m_state));
 }
 
+size_t Texture::memoryUsage() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const TextureLoadedState& state) {
+        auto result = size_t(0);
+        for (const auto& buffer : state.buffers)
+        {
+          result += buffer.size();
+        }
+        return result;
+      },
+      [](const TextureReadyState& state) { return state.memoryUsage; },
+      [](const TextureDroppedState&) { return size_t(0); }),
+    m_state);
+}
+
 const std::vector<TextureBuffer>& Texture::buffersIfLoaded() const
 {
   static const auto empty = std::vector<TextureBuffer>{};
@@ -28,8 +28,14 @@ namespace tb::gl
 void processResourcesSync(
   ResourceManager& resourceManager, const ProcessContext& processContext)
 {
-  while (resourceManager.needsProcessing())
+  // needsProcessing only checks the use counts of the next few resources, so keep going
+  // until the use counts of all resources were checked without finding any work
+  auto idleProcessCalls = std::size_t{0};
+  while (resourceManager.needsProcessing()
+         || idleProcessCalls * ResourceManager::MaxUseCountChecksPerProcess
+              < resourceManager.resources().size())
   {
+    idleProcessCalls = resourceManager.needsProcessing() ? 0 : idleProcessCalls + 1;
     resourceManager.process(
       [](auto task) {
         auto promise = std::promise<std::unique_ptr<TaskResult>>{};
@@ -107,6 +107,25 @@ TEST_CASE("MaterialCollection")
 
     CHECK(std::as_const(collection).materialByName("a")->name() == "a");
   }
+
+  SECTION("memoryUsage")
+  {
+    auto collection = MaterialCollection{makeMaterials({"a"})};
+    CHECK(collection.memoryUsage() == 0u);
+
+    collection.materials().emplace_back(
+      "b",
+      createTextureResource(Texture{
+        4,
+        4,
+        RgbaF{},
+        GL_RGBA,
+        TextureMask::Off,
+        NoEmbeddedDefaults{},
+        TextureBuffer{4 * 4 * 4}}));
+
+    CHECK(collection.memoryUsage() == 64u);
+  }
 }
 
 } // namespace tb::gl
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/IndexRangeMap.h"
+#include "gl/MaterialIndexRangeRenderer.h"
+#include "gl/MaterialRenderFunc.h"
+#include "gl/MockGl.h"
+#include "gl/PrimType.h"
+#include "gl/ShaderProgram.h"
+#include "gl/TestUtils.h"
+#include "gl/VboManager.h"
+#include "gl/VertexArray.h"
+#include "gl/VertexType.h"
+
+#include "vm/vec.h"
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::gl
+{
+namespace
+{
+
+class CountingMaterialRenderFunc : public MaterialRenderFunc
+{
+public:
+  size_t beforeCount = 0;
+  size_t afterCount = 0;
+
+  void before(Gl&, const Material*) override { ++beforeCount; }
+  void after(Gl&, const Material*) override { ++afterCount; }
+};
+
+MaterialIndexRangeRenderer makeTriangleRenderer()
+{
+  auto vertices = std::vector<VertexTypes::P3::Vertex>{
+    VertexTypes::P3::Vertex{vm::vec3f{0, 0, 0}},
+    VertexTypes::P3::Vertex{vm::vec3f{1, 0, 0}},
+    VertexTypes::P3::Vertex{vm::vec3f{0, 1, 0}},
+  };
+  return MaterialIndexRangeRenderer{
+    VertexArray::move(std::move(vertices)),
+    nullptr,
+    IndexRangeMap{PrimType::Triangles, 0, 3}};
+}
+
+} // namespace
+
+TEST_CASE("MaterialIndexRangeRenderer")
+{
+  auto gl = MockGl{};
+  installVboSupport(gl);
+  auto vboManager = VboManager{};
+  auto shaderProgram = ShaderProgram{"test", 1u};
+
+  gl.onBindBuffer = [](GLenum, GLuint) {};
+  gl.onDisableClientState = [](GLenum) {};
+
+  auto vertexArraySetupCount = 0u;
+  gl.onVertexPointer = [&](GLint, GLenum, GLsizei, const GLvoid*) {
+    ++vertexArraySetupCount;
+  };
+  gl.onEnableClientState = [](GLenum) {};
+
+  auto drawCount = 0u;
+  gl.onDrawArrays = [&](GLenum, GLint, GLsizei) { ++drawCount; };
+  gl.onMultiDrawArrays = [&](GLenum, const GLint*, const GLsizei*, GLsizei) {
+    ++drawCount;
+  };
+
+  auto func = CountingMaterialRenderFunc{};
+
+  SECTION("renderInstances")
+  {
+    auto renderer = makeTriangleRenderer();
+    renderer.prepare(gl, vboManager);
+
+    SECTION("sets up the vertex array and the material once for all instances")
+    {
+      auto setupInstances = std::vector<size_t>{};
+      renderer.renderInstances(
+        gl, shaderProgram, func, 3, [&](const size_t i) { setupInstances.push_back(i); });
+
+      CHECK(setupInstances == std::vector<size_t>{0, 1, 2});
+      CHECK(drawCount == 3u);
+      CHECK(vertexArraySetupCount == 1u);
+      CHECK(func.beforeCount == 1u);
+      CHECK(func.afterCount == 1u);
+    }
+
+    SECTION("with no instances issues no calls")
+    {
+      renderer.renderInstances(gl, shaderProgram, func, 0, [](size_t) {});
+
+      CHECK(drawCount == 0u);
+      CHECK(vertexArraySetupCount == 0u);
+      CHECK(func.beforeCount == 0u);
+    }
+
+    SECTION("issues the same draw calls as rendering each instance separately")
+    {
+      for (size_t i = 0; i < 3; ++i)
+      {
+        renderer.render(gl, shaderProgram, func);
+      }
+
+      CHECK(drawCount == 3u);
+      CHECK(vertexArraySetupCount == 3u);
+      CHECK(func.beforeCount == 3u);
+    }
+  }
+
+  SECTION("MultiMaterialIndexRangeRenderer::renderInstances")
+  {
+    auto renderers = std::vector<std::unique_ptr<MaterialIndexRangeRenderer>>{};
+    for (size_t i = 0; i < 2; ++i)
+    {
+      renderers.push_back(
+        std::make_unique<MaterialIndexRangeRenderer>(makeTriangleRenderer()));
+    }
+
+    auto renderer = MultiMaterialIndexRangeRenderer{std::move(renderers)};
+    renderer.prepare(gl, vboManager);
+
+    renderer.renderInstances(gl, shaderProgram, func, 4, [](size_t) {});
+
+    CHECK(drawCount == 8u);
+    CHECK(vertexArraySetupCount == 2u);
+    CHECK(func.beforeCount == 2u);
+  }
+
+  vboManager.destroyPendingVbos(gl);
+}
+
+} // namespace tb::gl
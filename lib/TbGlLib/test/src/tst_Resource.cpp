@@ -746,6 +746,64 @@ TEST_CASE("Resource")
       CHECK(resource.needsProcessing());
     }
   }
+
+  SECTION("eviction")
+  {
+    SECTION("Resource without loader cannot be evicted")
+    {
+      auto resource = ResourceT{MockResource{}};
+      resource.uploadSync(testGl);
+      REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource.state()));
+      CHECK(!resource.canEvict());
+    }
+
+    SECTION("Resource with loader")
+    {
+      auto mockDropCall = false;
+
+      auto resource = ResourceT{[&]() {
+        return Result<MockResource>{MockResource{
+          [](auto&) {},
+          [&](auto&) { mockDropCall = true; },
+        }};
+      }};
+
+      setResourceState<ResourceReady<MockResource>>(
+        resource, mockTaskRunner, processContext);
+      CHECK(resource.canEvict());
+
+      resource.evict(testGl);
+      CHECK(resource.isEvicted());
+      CHECK(mockDropCall);
+      CHECK(!resource.canEvict());
+      CHECK(!resource.needsProcessing());
+      CHECK(resource.get() != nullptr);
+
+      SECTION("reload")
+      {
+        resource.reload();
+        CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource.state()));
+        CHECK(resource.needsProcessing());
+        CHECK(resource.get() != nullptr);
+
+        resource.process(taskRunner, processContext);
+        CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource.state()));
+        CHECK(resource.get() != nullptr);
+
+        mockTaskRunner.resolveNextPromise();
+        resource.process(taskRunner, processContext);
+        CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource.state()));
+        CHECK(resource.get() != nullptr);
+      }
+
+      SECTION("drop")
+      {
+        resource.drop();
+        CHECK(resource.isDropped());
+        CHECK(resource.get() == nullptr);
+      }
+    }
+  }
 }
 
 } // namespace tb::gl
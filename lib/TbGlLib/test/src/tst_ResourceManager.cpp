@@ -23,10 +23,12 @@
 #include "gl/Resource.h"
 #include "gl/ResourceManager.h"
 #include "gl/TestGl.h"
+#include "gl/TestUtils.h"
 
 #include "kd/ranges/to.h"
 #include "kd/reflection_impl.h"
 
+#include <algorithm>
 #include <ranges>
 
 #include <catch2/catch_test_macros.hpp>
@@ -41,9 +43,11 @@ struct MockResource
 {
   void upload(Gl& gl) const { mockUpload(gl); }
   void drop(Gl& gl) const { mockDrop(gl); }
+  size_t memoryUsage() const { return mockMemoryUsage; }
 
   std::function<void(Gl&)> mockUpload = [](auto&) {};
   std::function<void(Gl&)> mockDrop = [](auto&) {};
+  size_t mockMemoryUsage = 0;
 
   kdl_reflect_inline_empty(MockResource);
 };
@@ -253,6 +257,135 @@ TEST_CASE("ResourceManager")
       }
     }
 
+    SECTION("visible resources are processed first")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resource3->setPriority(ResourcePriority::Visible);
+      resourceManager.process(taskRunner, processContext);
+
+      CHECK(
+        resourcesWereProcessed.notifications
+        == std::vector<std::vector<ResourceId>>{
+          {resource3->id(), resource1->id(), resource2->id()}});
+      CHECK(resource3->priority() == ResourcePriority::Normal);
+
+      SECTION("resources finish loading")
+      {
+        mockTaskRunner.resolveNextPromise();
+        mockTaskRunner.resolveNextPromise();
+        mockTaskRunner.resolveNextPromise();
+
+        resource2->setPriority(ResourcePriority::Visible);
+        resourcesWereProcessed.reset();
+        resourceManager.process(taskRunner, processContext);
+
+        CHECK(
+          resourcesWereProcessed.notifications
+          == std::vector<std::vector<ResourceId>>{
+            {resource2->id(), resource3->id(), resource1->id()}});
+      }
+    }
+
+    SECTION("memory budget")
+    {
+      const auto sizedResourceLoader = [&]() {
+        return Result<MockResource>{MockResource{
+          [](auto&) {},
+          [](auto&) {},
+          10,
+        }};
+      };
+
+      auto resource1 = std::make_shared<ResourceT>(sizedResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(sizedResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(sizedResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resourceManager.process(taskRunner, processContext);
+      mockTaskRunner.resolveNextPromise();
+      mockTaskRunner.resolveNextPromise();
+      mockTaskRunner.resolveNextPromise();
+      resourceManager.process(taskRunner, processContext);
+      resourceManager.process(taskRunner, processContext);
+      REQUIRE(!resourceManager.needsProcessing());
+      CHECK(resourceManager.memoryUsage() == 30u);
+
+      resource2->markUsed();
+      resourceManager.process(taskRunner, processContext);
+
+      // resource3 was used since the previous call to process, so it is not evicted
+      resource3->markUsed();
+
+      resourcesWereProcessed.reset();
+      resourceManager.setMemoryBudget(20);
+      resourceManager.process(taskRunner, processContext);
+
+      CHECK(
+        resourcesWereProcessed.notifications
+        == std::vector<std::vector<ResourceId>>{{resource1->id()}});
+      CHECK(resource1->isEvicted());
+      CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
+      CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource3->state()));
+      CHECK(resourceManager.memoryUsage() == 20u);
+      CHECK(!resourceManager.needsProcessing());
+
+      SECTION("resources are evicted in the order of their last use")
+      {
+        resourceManager.setMemoryBudget(30);
+        resource1->reload();
+        resource1->markUsed();
+        resourceManager.process(taskRunner, processContext);
+        mockTaskRunner.resolveNextPromise();
+        resourceManager.process(taskRunner, processContext);
+        resourceManager.process(taskRunner, processContext);
+        REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource1->state()));
+
+        resource3->markUsed();
+        resource1->markUsed();
+        resource2->markUsed();
+        resourceManager.process(taskRunner, processContext);
+
+        resourceManager.setMemoryBudget(10);
+        resourceManager.process(taskRunner, processContext);
+
+        CHECK(resource3->isEvicted());
+        CHECK(resource1->isEvicted());
+        CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource2->state()));
+        CHECK(resourceManager.memoryUsage() == 10u);
+      }
+
+      SECTION("evicted resources are reloaded when requested")
+      {
+        REQUIRE(!resourceManager.needsProcessing());
+
+        resource1->reload();
+        CHECK(resourceManager.needsProcessing());
+
+        resource1->markUsed();
+
+        resourceManager.process(taskRunner, processContext);
+        CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      }
+
+      SECTION("evicted resources are dropped when unused")
+      {
+        resource1.reset();
+        CHECK(resourceManager.needsProcessing());
+
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resourceManager.resources() == std::vector{resource2, resource3});
+        CHECK(!resourceManager.needsProcessing());
+      }
+    }
+
     SECTION("dropping resources")
     {
       auto mockDropCalls = std::array{false, false};
@@ -313,6 +446,57 @@ TEST_CASE("ResourceManager")
       CHECK(resourceManager.resources().empty());
       CHECK(mockDropCalls[1]);
     }
+
+    SECTION("use counts are checked in batches")
+    {
+      const auto resourceCount = ResourceManager::MaxUseCountChecksPerProcess + 10;
+
+      auto sharedResources = std::vector<std::shared_ptr<ResourceT>>{};
+      for (size_t i = 0; i < resourceCount; ++i)
+      {
+        sharedResources.push_back(std::make_shared<ResourceT>(mockResourceLoader));
+        resourceManager.addResource(sharedResources.back());
+      }
+
+      processResourcesSync(resourceManager, processContext);
+      REQUIRE(std::ranges::all_of(sharedResources, [](const auto& resource) {
+        return std::holds_alternative<ResourceReady<MockResource>>(resource->state());
+      }));
+      REQUIRE(!resourceManager.needsProcessing());
+
+      SECTION("each call to process checks a bounded number of resources")
+      {
+        sharedResources.clear();
+
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resourceManager.resources().size() == 10);
+
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resourceManager.resources().empty());
+      }
+
+      SECTION("processResourcesSync releases unused resources that are not checked next")
+      {
+        const auto isCheckedNext = [&](const size_t i) {
+          // the resource manager keeps the resource alive while it is unused
+          const auto resource = std::weak_ptr{sharedResources[i]};
+          sharedResources[i].reset();
+          const auto result = resourceManager.needsProcessing();
+          sharedResources[i] = resource.lock();
+          return result;
+        };
+
+        const auto indices = std::views::iota(size_t(0), resourceCount);
+        const auto i = std::ranges::find_if_not(indices, isCheckedNext);
+        REQUIRE(i != indices.end());
+
+        sharedResources[*i].reset();
+        CHECK(!resourceManager.needsProcessing());
+
+        processResourcesSync(resourceManager, processContext);
+        CHECK(resourceManager.resources().size() == resourceCount - 1);
+      }
+    }
   }
 }
 
@@ -102,10 +102,12 @@ TEST_CASE("Texture")
     CHECK(!texture.activate(gl, GL_LINEAR, GL_LINEAR));
     CHECK(!texture.deactivate(gl));
     CHECK(texture.buffersIfLoaded().size() == 1u);
+    CHECK(texture.memoryUsage() == 4u * 4u * 4u);
 
     texture.upload(gl);
     CHECK(texture.isReady());
     CHECK(texture.buffersIfLoaded().empty());
+    CHECK(texture.memoryUsage() == 4u * 4u * 4u);
 
     auto boundTextures = std::vector<GLuint>{};
     gl.onBindTexture = [&](GLenum, const GLuint id) { boundTextures.push_back(id); };
@@ -126,6 +128,7 @@ TEST_CASE("Texture")
     CHECK(!texture.activate(gl, GL_LINEAR, GL_LINEAR));
     CHECK(!texture.deactivate(gl));
     CHECK(texture.buffersIfLoaded().empty());
+    CHECK(texture.memoryUsage() == 0u);
 
     // dropping an already-dropped texture is a no-op
     texture.drop(gl);
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <filesystem>
+#include <memory>
 
 namespace tb::mdl
 {
@@ -30,11 +31,20 @@ class Map;
 
 fs::PathMatcher makeBackupPathMatcher(std::filesystem::path mapBasename);
 
+/**
+ * Periodically saves backups of a map.
+ *
+ * A backup is written on a worker thread from a snapshot of the map, so the map can be
+ * edited while the backup is being written. At most one backup is written at a time. The
+ * result of a backup is reported when the autosave is triggered the next time.
+ */
 class Autosaver
 {
 private:
   using Clock = std::chrono::system_clock;
 
+  struct PendingAutosave;
+
   Map& m_map;
 
   /**
@@ -58,16 +68,32 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * The backup that is currently being written, if any.
+   */
+  std::unique_ptr<PendingAutosave> m_pendingAutosave;
+
 public:
   explicit Autosaver(
     Map& map,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
 
+  /**
+   * Waits until a pending backup has been written.
+   */
+  ~Autosaver();
+
   void triggerAutosave();
 
+  /**
+   * Waits until a pending backup has been written and reports its result.
+   */
+  void waitForPendingAutosave();
+
 private:
   void autosave();
+  void finishPendingAutosave();
 };
 
 } // namespace tb::mdl
@@ -75,6 +75,19 @@ public:
   static Result<Brush> create(
     const vm::bbox3d& worldBounds, std::vector<BrushFace> faces);
 
+  /**
+   * Creates a brush from the given faces and previously computed geometry without
+   * clipping. Each face of the geometry is linked to the given face whose boundary is
+   * equal to the face's plane, and the given faces that are not part of the geometry are
+   * discarded.
+   *
+   * If a face of the geometry has no matching face, an error is returned and the given
+   * faces are left unchanged so that the caller can fall back to create. Otherwise, the
+   * faces are moved into the returned brush.
+   */
+  static Result<Brush> createFromGeometry(
+    std::vector<BrushFace>& faces, BrushGeometry geometry);
+
 private:
   explicit Brush(std::vector<BrushFace> faces);
 
@@ -164,6 +177,8 @@ public:
 
   std::vector<const BrushFace*> incidentFaces(const BrushVertex* vertex) const;
 
+  size_t geometryAllocatedBytes() const;
+
   // vertex operations
   bool canTransformVertices(
     const vm::bbox3d& worldBounds,
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/SurfaceAttributes.h"
+#include "mdl/UvCoordSystem.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb::mdl
+{
+class Brush;
+
+/**
+ * The difference between two brushes that have the same geometry and whose faces only
+ * differ in their materials, UV coordinate systems or surface attributes, e.g. after the
+ * UV alignment of some faces was changed.
+ *
+ * A delta is created from a brush and a base brush. Applying it to the base brush
+ * recreates the brush exactly. Since a delta only stores the attributes of the faces that
+ * differ from the base brush, it uses much less memory than a copy of the brush.
+ */
+class BrushDelta
+{
+private:
+  struct FaceAttributes
+  {
+    size_t faceIndex;
+    std::string materialName;
+    UvCoordSystem uvCoordSystem;
+    SurfaceAttributes surfaceAttributes;
+  };
+
+  std::vector<FaceAttributes> m_faces;
+
+  explicit BrushDelta(std::vector<FaceAttributes> faces);
+
+public:
+  /**
+   * Creates a delta that recreates the given brush when it is applied to the given base
+   * brush.
+   *
+   * Returns nullopt if the brushes differ in anything other than the attributes of their
+   * faces.
+   */
+  static std::optional<BrushDelta> create(const Brush& brush, const Brush& base);
+
+  /**
+   * Recreates the brush from which this delta was created.
+   *
+   * The given base brush must be equal to the base brush that was passed to create.
+   */
+  Brush apply(const Brush& base) const;
+
+  /**
+   * Returns the number of faces whose attributes are stored in this delta.
+   */
+  size_t faceCount() const;
+
+  /**
+   * Returns an estimate of the number of bytes of memory used by this delta.
+   */
+  size_t memoryUsage() const;
+};
+
+} // namespace tb::mdl
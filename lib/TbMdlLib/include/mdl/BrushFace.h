@@ -244,6 +244,12 @@ public:
   void resetUvCoordSystemCache();
   const UvCoordSystem& uvCoordSystem() const;
 
+  /**
+   * Replaces the UV coordinate system of this face. The given UV coordinate system must
+   * have been taken from a face with the same points as this face.
+   */
+  void setUvCoordSystem(UvCoordSystem uvCoordSystem);
+
   const gl::Material* material() const;
   vm::vec2f textureSize() const;
   vm::vec2f modOffset(const vm::vec2f& offset) const;
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/ray.h"
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace tb::mdl
+{
+class Brush;
+
+/**
+ * The boundary planes of the faces of a brush, packed into contiguous arrays of normal
+ * components and distances.
+ *
+ * Since a brush is the intersection of the half spaces below its face planes, a ray can
+ * be intersected with the brush by clipping it against all planes in a single tight loop,
+ * without visiting the faces' polygons. The plane with the largest entry distance is the
+ * face that the ray hits.
+ */
+class BrushFacePlanes
+{
+private:
+  size_t m_count = 0;
+  // the x, y and z components of the plane normals followed by the plane distances, each
+  // stored as a block of m_count values
+  std::vector<double> m_values;
+
+public:
+  BrushFacePlanes();
+  explicit BrushFacePlanes(const Brush& brush);
+
+  size_t count() const;
+
+  /**
+   * Returns the number of bytes allocated on the heap for the planes.
+   */
+  size_t allocatedBytes() const;
+
+  /**
+   * Returns the distance from the ray origin to the point where the given ray enters the
+   * brush and the index of the face through which it enters.
+   *
+   * Returns nullopt if the ray misses the brush or if its origin is inside of the brush.
+   */
+  std::optional<std::tuple<double, size_t>> intersect(const vm::ray3d& ray) const;
+};
+
+} // namespace tb::mdl
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "base/Result.h"
+#include "mdl/BrushGeometry.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+#include "vm/vec.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class BrushFace;
+class WorldNode;
+
+/**
+ * Caches the geometry of the brushes of a map file so that the brushes can be created
+ * without clipping when the file is loaded again.
+ *
+ * Brushes are identified by a key that is computed from the points of their faces, so
+ * brushes that were not changed since the cache was created are found even if other
+ * brushes of the map file were edited, added or removed. The cache as a whole is
+ * identified by a key that is computed from the other inputs that affect the brush
+ * geometry. A cache must only be used when its key matches the key computed for the file
+ * that is being loaded.
+ */
+class BrushGeometryCache
+{
+public:
+  struct Face
+  {
+    std::vector<size_t> vertexIndices;
+    vm::plane3d plane;
+  };
+
+  struct Entry
+  {
+    std::vector<vm::vec3d> vertexPositions;
+    std::vector<Face> faces;
+  };
+
+private:
+  uint64_t m_key;
+  std::unordered_map<uint64_t, Entry> m_entries;
+
+public:
+  explicit BrushGeometryCache(uint64_t key);
+
+  /**
+   * Computes a cache key from the inputs other than the brush faces that affect the
+   * geometry of the brushes.
+   */
+  static uint64_t computeKey(std::string_view gameName, const vm::bbox3d& worldBounds);
+
+  /**
+   * Computes the key of a brush with the given faces. The key does not depend on the
+   * order of the faces.
+   */
+  static uint64_t computeBrushKey(const std::vector<BrushFace>& faces);
+
+  /**
+   * Creates a cache that contains the geometry of every brush of the given world node.
+   */
+  static BrushGeometryCache create(uint64_t key, const WorldNode& worldNode);
+
+  /**
+   * Creates a cache that contains the geometry of every brush of the given world node.
+   * If the key of the given previous cache matches the given key, its entries are reused
+   * for the brushes that it contains, so only the geometry of the brushes that were
+   * changed or added since the previous cache was created is collected.
+   */
+  static BrushGeometryCache create(
+    uint64_t key, const WorldNode& worldNode, BrushGeometryCache previous);
+
+  uint64_t key() const;
+  size_t size() const;
+
+  void add(uint64_t brushKey, Entry entry);
+
+  /**
+   * Returns the cached geometry of the brush with the given faces, or std::nullopt if
+   * there is no such brush or if the cached geometry is invalid. A cached brush is only
+   * used if it has as many faces as the given faces and if its face planes match the
+   * planes of the given faces.
+   */
+  std::optional<BrushGeometry> geometry(const std::vector<BrushFace>& faces) const;
+
+  const std::unordered_map<uint64_t, Entry>& entries() const;
+};
+
+/**
+ * Returns the path of the brush geometry cache file for the map file at the given path.
+ * There is at most one cache file per map file path.
+ */
+std::filesystem::path makeBrushGeometryCachePath(
+  const std::filesystem::path& cacheFolderPath, const std::filesystem::path& mapPath);
+
+/**
+ * Reads a brush geometry cache from the given file. Returns an error if the file cannot
+ * be read, if it is corrupt, or if its key does not match the given key.
+ */
+Result<BrushGeometryCache> readBrushGeometryCache(
+  const std::filesystem::path& path, uint64_t key);
+
+/**
+ * Writes the given brush geometry cache to the given file, replacing it atomically.
+ */
+Result<void> writeBrushGeometryCache(
+  const std::filesystem::path& path, const BrushGeometryCache& cache);
+
+} // namespace tb::mdl
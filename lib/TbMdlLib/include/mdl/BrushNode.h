@@ -21,6 +21,7 @@
 
 #include "base/Macros.h"
 #include "mdl/Brush.h"
+#include "mdl/BrushFacePlanes.h"
 #include "mdl/BrushGeometry.h"
 #include "mdl/HitType.h"
 #include "mdl/Node.h"
@@ -48,6 +49,7 @@ class BrushRendererBrushCache;
 class GroupNode;
 class LayerNode;
 class ModelFactory;
+struct SurfaceAttributes;
 
 class BrushNode : public Node, public Object
 {
@@ -61,6 +63,7 @@ public:
 private:
   mutable std::unique_ptr<BrushRendererBrushCache> m_brushRendererBrushCache;
   Brush m_brush; // must be destroyed before the brush renderer cache
+  BrushFacePlanes m_facePlanes;
   size_t m_selectedFaceCount = 0u;
 
 public:
@@ -74,6 +77,8 @@ public:
   const Brush& brush() const;
   Brush setBrush(Brush brush);
 
+  const BrushFacePlanes& facePlanes() const;
+
   bool hasSelectedFaces() const;
   void selectFace(size_t faceIndex);
   void deselectFace(size_t faceIndex);
@@ -81,6 +86,8 @@ public:
   void updateFaceTags(size_t faceIndex, TagManager& tagManager);
 
   void setFaceMaterial(size_t faceIndex, gl::Material* material);
+  void setFaceSurfaceAttributes(
+    size_t faceIndex, const SurfaceAttributes& surfaceAttributes);
 
   bool contains(const Node& node) const;
   bool intersects(const Node& node) const;
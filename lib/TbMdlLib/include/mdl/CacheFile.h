@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "base/Result.h"
+
+#include "vm/vec.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace tb::mdl
+{
+
+/**
+ * 64 bit FNV-1a hash. Unlike std::hash, the result does not depend on the platform or
+ * the standard library implementation.
+ */
+class Fnv1aHash
+{
+private:
+  uint64_t m_hash = 0xcbf29ce484222325;
+
+public:
+  void update(const char* data, const size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      m_hash ^= uint64_t(static_cast<unsigned char>(data[i]));
+      m_hash *= 0x100000001b3;
+    }
+  }
+
+  void update(const std::string_view str) { update(str.data(), str.size()); }
+
+  template <typename T>
+  void update(const T& value)
+    requires std::is_arithmetic_v<T>
+  {
+    update(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  uint64_t value() const { return m_hash; }
+};
+
+/**
+ * Writes the contents of a cache file into a buffer. The buffer is terminated by a
+ * checksum of its contents.
+ */
+class CacheWriter
+{
+private:
+  std::string m_buffer;
+
+public:
+  template <typename T>
+  void write(const T& value)
+    requires std::is_arithmetic_v<T>
+  {
+    m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <size_t S>
+  void write(const vm::vec<double, S>& vec)
+  {
+    for (size_t i = 0; i < S; ++i)
+    {
+      write(vec[i]);
+    }
+  }
+
+  std::string finish()
+  {
+    auto hash = Fnv1aHash{};
+    hash.update(m_buffer);
+    write(hash.value());
+    return std::move(m_buffer);
+  }
+};
+
+/**
+ * Writes a cache file by writing its contents to a temporary file in the same folder and
+ * then replacing the given file with it. Concurrent writers and interrupted writes never
+ * leave a partially written cache file behind. Creates the folder if necessary.
+ */
+Result<void> writeCacheFile(
+  const std::filesystem::path& path, const std::function<void(std::ostream&)>& write);
+
+} // namespace tb::mdl
@@ -0,0 +1,46 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/MapFormat.h"
+
+#include <string>
+
+namespace tb::mdl
+{
+
+/**
+ * The text that was last written to a map file for a brush or a patch, without the comment
+ * that precedes it. The text is kept with the node and discarded when the node changes, so
+ * that saving a map again only serializes the nodes that have changed since.
+ *
+ * Saving a map keeps at most MaxCachedMapTextSize bytes of text. The nodes written after
+ * that limit was reached release their text and are serialized again on the next save.
+ */
+struct CachedMapText
+{
+  MapFormat format;
+  std::string text;
+  size_t lineCount;
+};
+
+constexpr size_t MaxCachedMapTextSize = 64u * 1024u * 1024u;
+
+} // namespace tb::mdl
@@ -50,6 +50,10 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory retained by the commands on the undo and redo stacks can be limited. When
+ * the limit is exceeded, the oldest commands are removed from the undo stack, so that
+ * they can no longer be undone.
  */
 class CommandProcessor
 {
@@ -78,6 +82,22 @@ private:
    */
   std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+  /**
+   * The maximum number of bytes of memory that the commands on the undo and redo stacks
+   * should retain.
+   */
+  size_t m_undoMemoryLimit;
+
+  /**
+   * The number of bytes of memory retained by the commands on the undo stack.
+   */
+  size_t m_undoStackMemoryUsage;
+
+  /**
+   * The number of bytes of memory retained by the commands on the redo stack.
+   */
+  size_t m_redoStackMemoryUsage;
+
   /**
    * The time stamp of when the last command was executed.
    */
@@ -175,6 +195,29 @@ public:
    * no command can be redone.
    */
   const std::string* redoCommandName() const;
+
+  /**
+   * Returns the maximum number of bytes of memory that the commands on the undo and redo
+   * stacks should retain.
+   */
+  size_t undoMemoryLimit() const;
+
+  /**
+   * Sets the maximum number of bytes of memory that the commands on the undo and redo
+   * stacks should retain. If the commands retain more memory than that, the oldest
+   * commands are removed from the undo stack until the limit is met. The most recently
+   * executed command is never removed, even if it exceeds the limit on its own.
+   *
+   * By default, the memory is not limited.
+   */
+  void setUndoMemoryLimit(size_t undoMemoryLimit);
+
+  /**
+   * Returns an estimate of the number of bytes of memory retained by the commands on the
+   * undo and redo stacks.
+   */
+  size_t undoMemoryUsage() const;
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -388,6 +431,13 @@ private:
 
   bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
+  /**
+   * Removes the oldest commands from the undo stack until the memory retained by the
+   * commands on the undo and redo stacks does not exceed the undo memory limit anymore,
+   * or until only one command is left on the undo stack.
+   */
+  void enforceUndoMemoryLimit();
+
   /**
    * Pushes the given command onto the redo stack. Takes ownership of the given command.
    *
@@ -403,6 +453,11 @@ private:
    * @return the topmost command of the redo stack
    */
   std::unique_ptr<UndoableCommand> popFromRedoStack();
+
+  /**
+   * Removes all commands from the redo stack.
+   */
+  void clearRedoStack();
 };
 
 } // namespace tb::mdl
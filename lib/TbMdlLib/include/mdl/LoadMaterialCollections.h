@@ -51,6 +51,7 @@ class FileSystem;
 namespace mdl
 {
 struct MaterialConfig;
+class TextureCache;
 
 Result<gl::Material> loadMaterial(
   const fs::FileSystem& fs,
@@ -60,12 +61,17 @@ Result<gl::Material> loadMaterial(
   const std::vector<Quake3Shader>& shaders,
   const std::optional<Palette>& palette);
 
+/**
+ * Loads the material collections. If a texture cache is given, the image textures are
+ * loaded via the cache.
+ */
 Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
   const gl::CreateTextureResource& createResource,
   kdl::task_manager& taskManager,
-  Logger& logger);
+  Logger& logger,
+  const TextureCache* textureCache = nullptr);
 
 } // namespace mdl
 } // namespace tb
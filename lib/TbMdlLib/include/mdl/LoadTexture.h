@@ -40,12 +40,18 @@ class FileSystem;
 
 namespace mdl
 {
+class TextureCache;
 
+/**
+ * Loads the texture at the given path. If a texture cache is given, image textures are
+ * loaded via the cache.
+ */
 Result<gl::Texture> loadTexture(
   const std::filesystem::path& path,
   const std::string& name,
   const fs::FileSystem& fs,
-  const std::optional<Palette>& palette = std::nullopt);
+  const std::optional<Palette>& palette = std::nullopt,
+  const TextureCache* textureCache = nullptr);
 
 } // namespace mdl
 } // namespace tb
@@ -24,6 +24,7 @@
 #include "base/Result.h"
 #include "gl/ResourceId.h"
 #include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushGeometryCache.h"
 #include "mdl/ExportOptions.h"
 #include "mdl/NodeHandleManager.h"
 #include "mdl/NodeIndex.h"
@@ -32,6 +33,8 @@
 #include "vm/bbox.h"
 
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -81,6 +84,7 @@ class PointTrace;
 class RepeatStack;
 class SmartTag;
 class TagManager;
+class TextureCache;
 class UndoableCommand;
 class WorldNode;
 
@@ -109,6 +113,8 @@ private:
   std::unique_ptr<EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<EntityModelManager> m_entityModelManager;
   std::unique_ptr<gl::MaterialManager> m_materialManager;
+  std::unique_ptr<TextureCache> m_textureCache;
+  std::optional<size_t> m_textureCacheMaxSize;
   std::unique_ptr<TagManager> m_tagManager;
 
   std::unique_ptr<EditorContext> m_editorContext;
@@ -117,6 +123,9 @@ private:
   std::unique_ptr<WorldNode> m_worldNode;
   vm::bbox3d m_worldBounds;
 
+  // the brush geometry cache that was last written, reused when the map is saved again
+  mutable std::future<BrushGeometryCache> m_brushGeometryCache;
+
   std::unique_ptr<NodeIndex> m_nodeIndex;
   std::unique_ptr<EntityLinkManager> m_entityLinkManager;
 
@@ -287,12 +296,30 @@ public: // game path
   const std::filesystem::path& gamePath() const;
   void setGamePath(std::filesystem::path gamePath);
 
+public: // texture cache
+  // These are updated whenever the texture cache settings are changed via the preferences
+  void setTextureCacheEnabled(bool textureCacheEnabled);
+
+  /**
+   * Sets the maximum size of the texture cache files in bytes. When the size changes,
+   * the least recently used cache files are deleted in the background.
+   */
+  void setTextureCacheMaxSize(size_t textureCacheMaxSize);
+
 public: // persistence
   Result<std::unique_ptr<Map>> reload();
 
   Result<void> save();
   Result<void> saveAs(const std::filesystem::path& path);
   Result<void> saveTo(const std::filesystem::path& path) const;
+
+  /**
+   * Takes a snapshot of the current state of the world and returns a function that
+   * writes the snapshot to a given path in the same way as saveTo. The returned function
+   * does not refer to this map, so it can be called on any thread while the map is being
+   * edited or after it was destroyed.
+   */
+  std::function<Result<void>(const std::filesystem::path&)> snapshotForSaving() const;
   Result<void> exportAs(const ExportOptions& options) const;
 
   bool persistent() const;
@@ -317,6 +344,9 @@ public: // selection management
   const std::optional<vm::bbox3d>& lastSelectionBounds() const;
   const std::optional<vm::bbox3d>& selectionBounds() const;
 
+private:
+  void updateSelection(const SelectionChange& selectionChange);
+
 public: // tag management
   void registerSmartTags();
   const std::vector<SmartTag>& smartTags() const;
@@ -22,9 +22,14 @@
 #include "mdl/MapFormat.h"
 #include "mdl/NodeSerializer.h"
 
+#include <deque>
+#include <future>
 #include <iosfwd>
 #include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 
@@ -37,6 +42,7 @@ class Brush;
 class BrushNode;
 class BrushFace;
 class EntityProperty;
+struct CachedMapText;
 class Node;
 class PatchNode;
 
@@ -47,17 +53,39 @@ private:
   LineStack m_startLineStack;
   size_t m_line;
   std::ostream& m_stream;
+  MapFormat m_format = MapFormat::Unknown;
 
-  struct PrecomputedString
+  using PrecomputedString = std::shared_ptr<const CachedMapText>;
+
+  /**
+   * A range of consecutive nodes whose strings are computed by a single task.
+   */
+  struct PrecomputedChunk
   {
-    std::string string;
-    size_t lineCount;
+    size_t begin;
+    size_t end;
+    std::future<std::vector<PrecomputedString>> future;
+    std::vector<PrecomputedString> strings;
   };
-  std::unordered_map<const Node*, PrecomputedString> m_nodeToPrecomputedString;
+
+  using NodeToSerialize = std::variant<const BrushNode*, const PatchNode*>;
+
+  // Brushes and patches are rendered to strings in parallel, but only within a bounded
+  // window of chunks ahead of the node that is currently being written to the stream.
+  kdl::task_manager* m_taskManager = nullptr;
+  std::vector<NodeToSerialize> m_nodesToSerialize;
+  std::unordered_map<const Node*, size_t> m_nodeIndices;
+  std::deque<PrecomputedChunk> m_precomputedChunks;
+  size_t m_nextNodeToPrecompute = 0;
+
+  // the total size of the text kept by the nodes written so far
+  size_t m_cachedMapTextSize = 0;
 
 public:
   static std::unique_ptr<NodeSerializer> create(MapFormat format, std::ostream& stream);
 
+  ~MapFileSerializer() override;
+
 protected:
   explicit MapFileSerializer(std::ostream& stream);
 
@@ -76,12 +104,23 @@ private:
 
 private:
   void setFilePosition(const Node& node);
+  void keepCachedMapText(const Node& node, PrecomputedString cachedMapText);
   size_t startLine();
 
+  /**
+   * Returns the string for the given node. If the node is part of the window of
+   * precomputed chunks, waits for its chunk to complete and advances the window.
+   * Otherwise, the string is computed on the calling thread.
+   */
+  PrecomputedString takePrecomputedString(const NodeToSerialize& node);
+  void precomputeStrings();
+  void discardPrecomputedStrings();
+
 private: // threadsafe
   virtual void doWriteBrushFace(std::ostream& stream, const BrushFace& face) const = 0;
-  PrecomputedString writeBrushFaces(const Brush& brush) const;
-  PrecomputedString writePatch(const BezierPatch& patch) const;
+  PrecomputedString writeNode(const NodeToSerialize& node) const;
+  CachedMapText writeBrushFaces(const Brush& brush) const;
+  CachedMapText writePatch(const BezierPatch& patch) const;
 };
 
 } // namespace mdl
@@ -45,6 +45,7 @@ class ParserStatus;
 
 namespace mdl
 {
+class BrushGeometryCache;
 class BrushNode;
 class EntityNode;
 class EntityNodeBase;
@@ -65,7 +66,8 @@ class WorldNode;
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). Large inputs are split into chunks of whole entities which are
+ * parsed in parallel (parseEntityChunks).
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -104,8 +106,12 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class EntityChunkReader;
+
+  std::string_view m_str;
   EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
+  const BrushGeometryCache* m_brushGeometryCache = nullptr;
 
 private: // data populated in response to MapParser callbacks
   std::vector<ObjectInfo> m_objectInfos;
@@ -128,6 +134,22 @@ protected:
     MapFormat targetMapFormat,
     EntityPropertyConfig entityPropertyConfig);
 
+private:
+  MapReader(
+    std::string_view str,
+    const FileLocation& startLocation,
+    MapFormat sourceMapFormat,
+    MapFormat targetMapFormat,
+    EntityPropertyConfig entityPropertyConfig);
+
+protected:
+  /**
+   * Sets a cache of previously computed brush geometry. If a cached geometry exists for a
+   * brush, the brush is created from it instead of by clipping. The cache must have been
+   * created for the string that is being parsed.
+   */
+  void setBrushGeometryCache(const BrushGeometryCache* brushGeometryCache);
+
   /**
    * Attempts to parse as one or more entities.
    */
@@ -143,6 +165,20 @@ protected:
    */
   Result<void> readBrushFaces(const vm::bbox3d& worldBounds, ParserStatus& status);
 
+  /**
+   * Returns the given formats reordered so that the formats that can parse a small prefix
+   * of the given string come first. A format that fails to parse the prefix would also
+   * fail to parse the entire string, so the first format that parses the entire string
+   * is found after fewer attempts. The order of the given formats is kept otherwise.
+   *
+   * If the string is not much larger than the prefix, the given formats are returned
+   * unchanged.
+   */
+  static std::vector<MapFormat> sniffFormats(
+    std::string_view str,
+    const std::vector<MapFormat>& formats,
+    const EntityPropertyConfig& entityPropertyConfig);
+
 protected: // implement MapParser interface
   void onBeginEntity(
     const FileLocation& location,
@@ -184,6 +220,17 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  /**
+   * Splits the input into chunks of whole entities and parses them in parallel. The
+   * recorded object infos and the messages logged while parsing are merged in file order.
+   *
+   * Returns false if the input is too small to be split or if any chunk could not be
+   * parsed. In that case, nothing was recorded or logged and the caller must parse the
+   * input serially. This guarantees that parse errors are reported exactly as if the
+   * input had been parsed serially.
+   */
+  bool parseEntityChunks(ParserStatus& status, kdl::task_manager& taskManager);
+
   void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
 
 private: // subclassing interface - these will be called in the order that nodes should be
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "mdl/HitFilter.h"
+
 #include "vm/ray.h"
 
 #include <vector>
@@ -30,6 +32,20 @@ class Node;
 class PickResult;
 
 void pick(Map& map, const vm::ray3d& pickRay, PickResult& pickResult);
+
+/**
+ * Like pick, but stops once the given number of hits matching the given filter have been
+ * found and no other node can be hit closer. Use this if only the closest matching hits
+ * are needed.
+ *
+ * See WorldNode::pickNearest.
+ */
+void pickNearest(
+  Map& map,
+  const vm::ray3d& pickRay,
+  const HitFilter& hitFilter,
+  size_t count,
+  PickResult& pickResult);
 std::vector<Node*> findNodesContaining(Map& map, const vm::vec3d& point);
 
 } // namespace tb::mdl
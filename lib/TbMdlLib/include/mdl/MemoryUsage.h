@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace tb::mdl
+{
+class BezierPatch;
+class Brush;
+class Entity;
+class Group;
+class Layer;
+class Node;
+class NodeContents;
+
+/**
+ * Functions that estimate the number of bytes of memory used by map objects. The
+ * estimates include the heap memory owned by the objects, but not any shared resources
+ * such as materials, entity definitions or models.
+ */
+
+size_t memoryUsage(const Layer& layer);
+size_t memoryUsage(const Group& group);
+size_t memoryUsage(const Entity& entity);
+size_t memoryUsage(const Brush& brush);
+size_t memoryUsage(const BezierPatch& patch);
+size_t memoryUsage(const NodeContents& contents);
+
+/**
+ * Returns an estimate of the memory used by the given node and all of its descendants.
+ */
+size_t memoryUsage(const Node& node);
+
+} // namespace tb::mdl
@@ -98,6 +98,15 @@ std::vector<Node*> collectTouchingNodes(
 std::vector<Node*> collectContainedNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes);
 
+/**
+ * Like the above, but only visits the nodes in `nodeTree` that are near the given
+ * brushes instead of searching every node.
+ */
+std::vector<Node*> collectTouchingNodes(
+  const NodeTree& nodeTree, const std::vector<BrushNode*>& brushes);
+std::vector<Node*> collectContainedNodes(
+  const NodeTree& nodeTree, const std::vector<BrushNode*>& brushes);
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes);
 
 std::vector<Node*> collectSelectableNodes(
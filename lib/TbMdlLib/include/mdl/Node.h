@@ -39,6 +39,7 @@
 namespace tb::mdl
 {
 
+struct CachedMapText;
 class EditorContext;
 class EntityNodeBase;
 struct EntityPropertyConfig;
@@ -73,6 +74,7 @@ private:
 
   mutable size_t m_lineNumber = 0;
   mutable size_t m_lineCount = 0;
+  mutable std::shared_ptr<const CachedMapText> m_cachedMapText;
 
   mutable std::vector<std::unique_ptr<Issue>> m_issues;
   mutable bool m_issuesValid = false;
@@ -349,6 +351,13 @@ public: // file position
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
+  /**
+   * The text that was last written to a map file for this node, if the node hasn't changed
+   * since. The text is copied to clones of this node.
+   */
+  const std::shared_ptr<const CachedMapText>& cachedMapText() const;
+  void setCachedMapText(std::shared_ptr<const CachedMapText> cachedMapText) const;
+
 public: // issue management
   std::vector<const Issue*> issues(const std::vector<const Validator*>& validators);
 
@@ -27,11 +27,15 @@
 #include <vm/vec.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <ranges>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 #pragma once
 
@@ -66,12 +70,19 @@ class Node;
  * This means that adding a "bridge" handle that is close to two previously separate
  * clumps will merge them into one, and removing it later will split them apart again.
  *
+ * To find the clumps near a handle without visiting every clump, the handles are indexed
+ * in a uniform grid whose cells are as large as the clump distance. Handles that belong
+ * to the same clump are therefore always in the same or in adjacent cells.
+ *
  * ## Handle types
  *
  * A handle type `H` must satisfy the following static interface:
  * - `static auto H::getHandles(const Node&)`: returns a range of handles for a node.
  * - `static double H::distance(const H& a, const H& b)`: returns the distance between
  *   two handles, used to determine whether they belong to the same clump.
+ * - `static vm::vec3d H::anchor(const H&)`: returns the point by which a handle is
+ *   indexed. The distance between the anchors of two handles must not exceed their
+ *   distance as returned by `H::distance`.
  * - `auto H::pick(...)`: returns an `std::optional<Hit>` for a pick ray query.
  */
 class NodeHandleManager
@@ -96,6 +107,9 @@ private:
       size_t count = 0u;
       bool selected = false;
 
+      // the position of this clump in m_handleClumps
+      size_t index = 0u;
+
       void addHandle(const HandleType& handle, size_t handleCount = 1u)
       {
         handles[handle] += handleCount;
@@ -117,19 +131,25 @@ private:
 
       bool select() { return !std::exchange(selected, true); }
       bool deselect() { return std::exchange(selected, false); }
+    };
 
-      bool shouldContain(const HandleType& handle, const double clumpDistance) const
+    using CellKey = std::array<std::int64_t, 3>;
+
+    struct CellKeyHash
+    {
+      size_t operator()(const CellKey& key) const
       {
-        const auto shouldClump = [&](const auto& candidate) {
-          return HandleType::distance(handle, candidate) < clumpDistance;
+        const auto hash = [](const std::int64_t k, const std::uint64_t p) {
+          return static_cast<std::uint64_t>(k) * p;
         };
-
-        return std::ranges::any_of(handles | std::views::keys, shouldClump);
+        return static_cast<size_t>(
+          hash(key[0], 73856093u) ^ hash(key[1], 19349663u) ^ hash(key[2], 83492791u));
       }
     };
 
     std::vector<std::unique_ptr<HandleClump>> m_handleClumps;
     std::map<HandleType, HandleClump*> m_handles;
+    std::unordered_map<CellKey, std::vector<HandleType>, CellKeyHash> m_cells;
     size_t numSelectedHandleClumps = 0;
     double m_clumpDistance;
 
@@ -220,6 +240,7 @@ private:
     {
       m_handleClumps.clear();
       m_handles.clear();
+      m_cells.clear();
       numSelectedHandleClumps = 0u;
     }
 
@@ -252,6 +273,64 @@ private:
     }
 
   private:
+    CellKey cellKey(const vm::vec3d& position) const
+    {
+      return {
+        static_cast<std::int64_t>(std::floor(position.x() / m_clumpDistance)),
+        static_cast<std::int64_t>(std::floor(position.y() / m_clumpDistance)),
+        static_cast<std::int64_t>(std::floor(position.z() / m_clumpDistance))};
+    }
+
+    /**
+     * Calls the given function for every indexed handle in the cell of the given handle
+     * and in its adjacent cells, i.e. for every handle that could be within the clump
+     * distance of the given handle.
+     */
+    template <typename F>
+    void forEachNearbyHandle(const HandleType& handle, const F& f) const
+    {
+      const auto key = cellKey(HandleType::anchor(handle));
+      for (std::int64_t x = -1; x <= 1; ++x)
+      {
+        for (std::int64_t y = -1; y <= 1; ++y)
+        {
+          for (std::int64_t z = -1; z <= 1; ++z)
+          {
+            const auto iCell = m_cells.find({key[0] + x, key[1] + y, key[2] + z});
+            if (iCell != m_cells.end())
+            {
+              for (const auto& nearbyHandle : iCell->second)
+              {
+                f(nearbyHandle);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    void indexHandle(const HandleType& handle)
+    {
+      m_cells[cellKey(HandleType::anchor(handle))].push_back(handle);
+    }
+
+    void unindexHandle(const HandleType& handle)
+    {
+      auto iCell = m_cells.find(cellKey(HandleType::anchor(handle)));
+      contract_assert(iCell != m_cells.end());
+
+      auto& cellHandles = iCell->second;
+      auto iHandle = std::ranges::find(cellHandles, handle);
+      contract_assert(iHandle != cellHandles.end());
+
+      *iHandle = std::move(cellHandles.back());
+      cellHandles.pop_back();
+      if (cellHandles.empty())
+      {
+        m_cells.erase(iCell);
+      }
+    }
+
     auto findHandleEntry(const HandleType& handle) const
     {
       auto iEntry = m_handles.find(handle);
@@ -262,9 +341,15 @@ private:
 
       // A handle may be reconstructed after a geometric edit with small floating-point
       // differences, so fall back to the first handle in the same clump distance.
-      return std::ranges::find_if(m_handles, [&](const auto& entry) {
-        return HandleType::distance(handle, entry.first) < m_clumpDistance;
+      forEachNearbyHandle(handle, [&](const auto& nearbyHandle) {
+        if (
+          HandleType::distance(handle, nearbyHandle) < m_clumpDistance
+          && (iEntry == m_handles.end() || nearbyHandle < iEntry->first))
+        {
+          iEntry = m_handles.find(nearbyHandle);
+        }
       });
+      return iEntry;
     }
 
     auto findHandleEntry(const HandleType& handle)
@@ -277,24 +362,29 @@ private:
       auto newHandleClump = std::make_unique<HandleClump>();
       newHandleClump->addHandle(handle, count);
 
-      for (auto iHandleClump = m_handleClumps.begin();
-           iHandleClump != m_handleClumps.end();)
-      {
-        auto& handleClump = *iHandleClump;
-        if (handleClump->shouldContain(handle, m_clumpDistance))
+      auto handleClumpsToMerge = std::vector<HandleClump*>{};
+      forEachNearbyHandle(handle, [&](const auto& nearbyHandle) {
+        if (HandleType::distance(handle, nearbyHandle) < m_clumpDistance)
         {
-          for (const auto& [clumpedHandle, clumpedHandleCount] : handleClump->handles)
+          auto* handleClump = m_handles.at(nearbyHandle);
+          if (
+            std::ranges::find(handleClumpsToMerge, handleClump)
+            == handleClumpsToMerge.end())
           {
-            newHandleClump->addHandle(clumpedHandle, clumpedHandleCount);
+            handleClumpsToMerge.push_back(handleClump);
           }
-          newHandleClump->selected = newHandleClump->selected || handleClump->selected;
-
-          iHandleClump = removeHandleClump(iHandleClump).first;
         }
-        else
+      });
+
+      for (auto* handleClump : handleClumpsToMerge)
+      {
+        for (const auto& [clumpedHandle, clumpedHandleCount] : handleClump->handles)
         {
-          ++iHandleClump;
+          newHandleClump->addHandle(clumpedHandle, clumpedHandleCount);
         }
+        newHandleClump->selected = newHandleClump->selected || handleClump->selected;
+
+        removeHandleClump(*handleClump);
       }
 
       addHandleClump(std::move(newHandleClump));
@@ -302,12 +392,10 @@ private:
 
     void removeHandle(const HandleType& handle)
     {
-      auto iHandleClump = std::ranges::find_if(
-        m_handleClumps,
-        [&](const auto& handleClump) { return handleClump->handles.contains(handle); });
-      contract_assert(iHandleClump != m_handleClumps.end());
+      auto iEntry = m_handles.find(handle);
+      contract_assert(iEntry != m_handles.end());
 
-      auto handleClump = removeHandleClump(iHandleClump).second;
+      auto handleClump = removeHandleClump(*iEntry->second);
 
       handleClump->removeHandle(handle);
 
@@ -332,6 +420,7 @@ private:
       for (const auto& [handle, count] : handleClump->handles)
       {
         m_handles.emplace(handle, handleClump.get());
+        indexHandle(handle);
       }
 
       if (handleClump->selected)
@@ -339,24 +428,36 @@ private:
         ++numSelectedHandleClumps;
       }
 
+      handleClump->index = m_handleClumps.size();
       m_handleClumps.push_back(std::move(handleClump));
     }
 
-    auto removeHandleClump(auto iHandleClump)
+    std::unique_ptr<HandleClump> removeHandleClump(HandleClump& handleClump)
     {
-      auto handleClump = std::move(*iHandleClump);
-      if (handleClump->selected)
+      const auto index = handleClump.index;
+      contract_assert(m_handleClumps[index].get() == &handleClump);
+
+      auto result = std::move(m_handleClumps[index]);
+      if (result->selected)
       {
         --numSelectedHandleClumps;
       }
 
-      for (const auto& [handle, count] : handleClump->handles)
+      for (const auto& [handle, count] : result->handles)
       {
         m_handles.erase(handle);
+        unindexHandle(handle);
+      }
+
+      // move the last clump into the gap to avoid shifting the remaining clumps
+      if (index + 1u < m_handleClumps.size())
+      {
+        m_handleClumps[index] = std::move(m_handleClumps.back());
+        m_handleClumps[index]->index = index;
       }
+      m_handleClumps.pop_back();
 
-      auto iNextHandleClump = m_handleClumps.erase(iHandleClump);
-      return std::pair{iNextHandleClump, std::move(handleClump)};
+      return result;
     }
 
     void selectHandleClump(HandleClump& handleClump)
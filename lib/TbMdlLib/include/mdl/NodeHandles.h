@@ -69,6 +69,7 @@ struct VertexHandle
   }
 
   static double distance(const VertexHandle& lhs, const VertexHandle& rhs);
+  static vm::vec3d anchor(const VertexHandle& handle);
 
   /**
    * Pick this handle.
@@ -119,6 +120,7 @@ struct EdgeHandle
   }
 
   static double distance(const EdgeHandle& lhs, const EdgeHandle& rhs);
+  static vm::vec3d anchor(const EdgeHandle& handle);
 
   /**
    * Pick the center point of this handle.
@@ -173,6 +175,7 @@ struct FaceHandle
   }
 
   static double distance(const FaceHandle& lhs, const FaceHandle& rhs);
+  static vm::vec3d anchor(const FaceHandle& handle);
 
   /**
    * Pick the center point of this handle.
@@ -222,6 +225,7 @@ struct ControlPointHandle
   }
 
   static double distance(const ControlPointHandle& lhs, const ControlPointHandle& rhs);
+  static vm::vec3d anchor(const ControlPointHandle& handle);
 
   /**
    * Pick this handle.
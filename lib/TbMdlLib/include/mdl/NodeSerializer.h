@@ -69,6 +69,7 @@ private:
   bool m_stripTbProperties = false;
   std::optional<std::string> m_stripEntityPattern;
   std::optional<Entity> m_entityToAdd;
+  std::optional<size_t> m_maxCachedMapTextSize;
 
 public:
   virtual ~NodeSerializer();
@@ -90,6 +91,14 @@ public:
   const std::optional<Entity>& entityToAdd() const;
   void setEntityToAdd(std::optional<Entity> entityToAdd);
 
+  /**
+   * If set, the written brushes and patches keep their text until they change, but only
+   * up to the given total number of bytes. The text of the nodes written after that is
+   * released. If not set, the cached text of the written nodes is left as it is.
+   */
+  const std::optional<size_t>& maxCachedMapTextSize() const;
+  void setMaxCachedMapTextSize(std::optional<size_t> maxCachedMapTextSize);
+
 public:
   /**
    * Prepares to serialize the given nodes and all of their children.
@@ -59,6 +59,7 @@ public:
   void setStripTbProperties(bool stripTbProperties);
   void setStripEntityPattern(std::optional<std::string> stripEntityPattern);
   void setEntityToAdd(std::optional<Entity> entityToAdd);
+  void setMaxCachedMapTextSize(std::optional<size_t> maxCachedMapTextSize);
   void writeMap(kdl::task_manager& taskManager);
 
 private:
@@ -27,6 +27,7 @@
 
 #include "vm/bbox.h"
 #include "vm/intersection.h"
+#include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/scalar.h"
 
@@ -34,7 +35,9 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <optional>
+#include <queue>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -554,6 +557,76 @@ public:
     }
   }
 
+  /**
+   * Visits every data item in this tree whose bounding box intersects with the given ray
+   * in the order in which the ray enters the bounding boxes, i.e., front to back.
+   *
+   * The visitor is called with each data item and returns the distance along the ray
+   * beyond which the caller is no longer interested in any data items. The traversal
+   * stops once the ray enters every remaining bounding box beyond that distance. Since
+   * the bounds of a data item are contained in the bounding box it is stored in, none of
+   * the skipped data items can intersect the ray closer than that.
+   *
+   * To visit every data item, the visitor can return
+   * std::numeric_limits<T>::max().
+   *
+   * @tparam V the visitor type
+   * @param ray the ray to test
+   * @param visitor the visitor to call for each data item
+   */
+  template <typename V>
+  void visit_intersectors(const vm::ray<T, 3>& ray, const V& visitor) const
+  {
+    if (!m_root)
+    {
+      return;
+    }
+
+    using entry = std::pair<T, const node*>;
+    const auto compare = [](const entry& lhs, const entry& rhs) {
+      return lhs.first > rhs.first;
+    };
+
+    auto queue =
+      std::priority_queue<entry, std::vector<entry>, decltype(compare)>{compare};
+    const auto push = [&](const node& node) {
+      const auto bounds = get_address(node).to_bounds(m_min_size);
+      if (bounds.contains(ray.origin))
+      {
+        queue.emplace(T(0), &node);
+      }
+      else if (const auto distance = vm::intersect_ray_bbox(ray, bounds))
+      {
+        queue.emplace(*distance, &node);
+      }
+    };
+
+    push(*m_root);
+
+    auto max_distance = std::numeric_limits<T>::max();
+    while (!queue.empty() && queue.top().first <= max_distance)
+    {
+      const auto* node = queue.top().second;
+      queue.pop();
+
+      for (const auto& data : get_data(*node))
+      {
+        max_distance = std::min(max_distance, visitor(data));
+      }
+
+      if (const auto* inner = std::get_if<inner_node>(node))
+      {
+        for (const auto& child : inner->children)
+        {
+          if (!is_empty(child))
+          {
+            push(child);
+          }
+        }
+      }
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box intersects with the given bbox
    * and returns a list of those items.
@@ -594,6 +667,52 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree whose bounding box may intersect the convex volume
+   * bounded by the given planes, e.g. a view frustum, and returns a list of those items.
+   *
+   * The normals of the planes must point out of the volume. The test is conservative:
+   * every item that intersects the volume is found, but some of the found items may lie
+   * outside of the volume near its edges.
+   *
+   * @param planes the planes bounding the volume
+   * @return a list containing all found data items
+   */
+  std::vector<U> find_in_frustum(const std::vector<vm::plane<T, 3>>& planes) const
+  {
+    auto result = std::vector<U>{};
+    find_in_frustum(planes, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box may intersect the convex volume
+   * bounded by the given planes and appends it to the given output iterator.
+   *
+   * @tparam O the output iterator type
+   * @param planes the planes bounding the volume, with normals pointing outwards
+   * @param out the output iterator to append to
+   */
+  template <typename O>
+  void find_in_frustum(const std::vector<vm::plane<T, 3>>& planes, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::ranges::copy(data, out);
+        },
+        [&](const auto& node) {
+          const auto bounds = get_address(node).to_bounds(m_min_size);
+          return std::ranges::none_of(planes, [&](const auto& plane) {
+            return vm::bbox_above_plane(bounds, plane);
+          });
+        });
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box contains the given point and
    * returns a list of those items.
@@ -27,8 +27,12 @@
 #include "kd/reflection_decl.h"
 
 #include "vm/bbox.h"
+#include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <optional>
+#include <vector>
+
 namespace tb
 {
 namespace gl
@@ -64,6 +68,45 @@ struct PatchGrid
   kdl_reflect_decl(PatchGrid, pointRowCount, pointColumnCount, points, bounds);
 };
 
+/**
+ * A bounding volume hierarchy over the quads of a patch grid. It allows finding the quads
+ * hit by a ray without testing every quad of the grid.
+ *
+ * Every cell covers a rectangular range of quads and stores their bounds. The range of an
+ * inner cell is split in half along its longer side, and each half is covered by a child
+ * cell. The cells are stored in depth first order, so the first child of an inner cell
+ * immediately follows it.
+ */
+struct PatchGridBvh
+{
+  struct Cell
+  {
+    vm::bbox3d bounds;
+    size_t rowBegin;
+    size_t rowEnd;
+    size_t columnBegin;
+    size_t columnEnd;
+    // the index of the second child, or 0 if this cell is a leaf
+    size_t secondChild;
+
+    kdl_reflect_decl(
+      Cell, bounds, rowBegin, rowEnd, columnBegin, columnEnd, secondChild);
+  };
+
+  std::vector<Cell> cells;
+
+  /**
+   * Returns the distance from the ray origin to the closest point where the given ray
+   * hits the given grid, which must be the grid that this hierarchy was built for.
+   */
+  std::optional<double> intersect(const vm::ray3d& ray, const PatchGrid& grid) const;
+
+  kdl_reflect_decl(PatchGridBvh, cells);
+};
+
+// public for testing
+PatchGridBvh makePatchGridBvh(const PatchGrid& grid);
+
 // public for testing
 std::vector<vm::vec3d> computeGridNormals(
   std::vector<BezierPatch::Point> patchGrid,
@@ -81,6 +124,8 @@ public:
 private:
   BezierPatch m_patch;
   PatchGrid m_grid;
+  // built on demand when the patch is picked
+  std::optional<PatchGridBvh> m_gridBvh;
 
 public:
   explicit PatchNode(BezierPatch patch);
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "kd/intrusive_circular_list.h"
+#include "mdl/PolyhedronArena.h"
 
 #include "vm/bbox.h"
 #include "vm/plane.h"
@@ -78,7 +79,7 @@ struct Polyhedron_GetVertexLink
  * The payload of a vertex can be used to store user data.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Vertex
+class Polyhedron_Vertex : public PolyhedronArenaElement
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -233,7 +234,7 @@ struct Polyhedron_GetEdgeLink
  * intrusive circular list.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Edge
+class Polyhedron_Edge : public PolyhedronArenaElement
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -549,7 +550,7 @@ struct Polyhedron_GetHalfEdgeLink
  * boundary the half edge belongs to.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_HalfEdge
+class Polyhedron_HalfEdge : public PolyhedronArenaElement
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -774,7 +775,7 @@ struct Polyhedron_GetFaceLink
  * intrusive circular list.
  */
 template <typename T, typename FP, typename VP>
-class Polyhedron_Face
+class Polyhedron_Face : public PolyhedronArenaElement
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -1194,6 +1195,13 @@ public:
   };
 
 private:
+  /**
+   * The arena from which the vertices, edges, half edges and faces of this polyhedron are
+   * allocated. Created on demand, and declared before the lists so that it is released
+   * after they were cleared.
+   */
+  PolyhedronArena::Ptr m_arena;
+
   /**
    * The vertices of this polyhedron, stored in a circular list that owns them.
    */
@@ -1258,6 +1266,29 @@ public: // Constructors
    */
   Polyhedron(Polyhedron<T, FP, VP>&& other) noexcept;
 
+  /**
+   * Destructor.
+   */
+  ~Polyhedron();
+
+  /**
+   * Constructs a polyhedron with the given vertices and faces. Unlike the other
+   * constructors, this does not compute any geometry, it only links the given faces.
+   *
+   * Each face is given by the indices of its vertices in the given positions, in the
+   * same order as the vertices of the faces of this polyhedron, and by its plane.
+   * Returns std::nullopt if an index is out of bounds, if a vertex is not used by any
+   * face, or if the faces do not form a closed polyhedron.
+   *
+   * @param positions the vertex positions
+   * @param faceVertexIndices the vertex indices of each face
+   * @param facePlanes the plane of each face
+   */
+  static std::optional<Polyhedron<T, FP, VP>> fromFaces(
+    const std::vector<vm::vec<T, 3>>& positions,
+    const std::vector<std::vector<size_t>>& faceVertexIndices,
+    const std::vector<vm::plane<T, 3>>& facePlanes);
+
 public: // copy and move assignment
   /**
    * Copy assignment operator.
@@ -1276,6 +1307,7 @@ public: // swap function, must be implemented here because it's a public templat
   friend void swap(Polyhedron<T, FP, VP>& first, Polyhedron<T, FP, VP>& second)
   {
     using std::swap;
+    swap(first.m_arena, second.m_arena);
     swap(first.m_vertices, second.m_vertices);
     swap(first.m_edges, second.m_edges);
     swap(first.m_faces, second.m_faces);
@@ -1374,6 +1406,12 @@ public: // Accessors
    */
   const vm::bbox<T, 3>& bounds() const;
 
+  /**
+   * Returns the number of bytes allocated for the vertices, edges, half edges and faces
+   * of this polyhedron.
+   */
+  std::size_t allocatedBytes() const;
+
   /**
    * Indicates whether this polyhedron is empty.
    *
@@ -1581,6 +1619,12 @@ private:
    */
   void updateBounds();
 
+  /**
+   * Returns the arena from which new elements of this polyhedron are allocated. The arena
+   * is created if this polyhedron does not have one yet.
+   */
+  PolyhedronArena& arena();
+
 public: // Vertex correction and edge healing
   /**
    * Rounds each component of position of every vertex to the nearest integer if the
@@ -1991,14 +2035,15 @@ private:
    * Weaves a cone, the tip of which will be a newly created vertex at the given position.
    *
    * The returned cone may have coplanar adjacent faces. The caller is responsible for
-   * merging those.
+   * merging those. The elements of the cone are allocated from the arena of this
+   * polyhedron.
    *
    * @param seam the seam to weave a cone onto
    * @param position the position of the cone's tip
    * @return the components of the newly created cone or an empty optional if the
    * operation fails
    */
-  static std::optional<WeaveConeResult> weaveCone(
+  std::optional<WeaveConeResult> weaveCone(
     const Seam& seam, const vm::vec<T, 3>& position);
 
   /**
@@ -0,0 +1,179 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+namespace tb::mdl
+{
+
+/**
+ * Allocates the vertices, edges, half edges and faces of a polyhedron.
+ *
+ * The memory is taken from a small number of blocks which are filled front to back, so
+ * that the elements of a polyhedron are stored close to each other and are freed
+ * together. Freed elements are put on a free list per element size and reused by later
+ * allocations. This avoids most calls to the global allocator when a polyhedron is
+ * clipped repeatedly.
+ *
+ * Every allocation is prefixed with a pointer to the arena, so an element can be freed
+ * without knowing its polyhedron. An arena is reference counted: it stays alive while
+ * it is owned by a polyhedron or while any of its allocations is alive. An arena is not
+ * thread safe, but it is only ever used by the polyhedron that owns it.
+ *
+ * The reference count is not atomic for the same reason. Every polyhedron has a single
+ * owner and is used from one thread at a time, and a copy of a polyhedron allocates its
+ * elements from its own arena, so no two threads ever change the reference count of the
+ * same arena.
+ */
+class PolyhedronArena
+{
+public:
+  /**
+   * The alignment of every allocation.
+   */
+  static constexpr auto Alignment = alignof(void*);
+
+  /**
+   * The size of the first block of an arena, unless a different size is reserved.
+   */
+  static constexpr auto DefaultBlockSize = size_t(4096);
+
+  /**
+   * The maximum size of a block that is allocated when an arena grows.
+   */
+  static constexpr auto MaxBlockSize = size_t(65536);
+
+  struct Release
+  {
+    void operator()(PolyhedronArena* arena) const;
+  };
+
+  using Ptr = std::unique_ptr<PolyhedronArena, Release>;
+
+private:
+  struct Block;
+
+  struct FreeList
+  {
+    size_t slotSize = 0;
+    void* first = nullptr;
+  };
+
+  Block* m_blocks = nullptr;
+  std::byte* m_current = nullptr;
+  std::byte* m_end = nullptr;
+  size_t m_nextBlockSize = DefaultBlockSize;
+  size_t m_allocatedBytes = 0;
+  std::array<FreeList, 4> m_freeLists;
+  size_t m_referenceCount = 1;
+
+  PolyhedronArena();
+  ~PolyhedronArena();
+
+public:
+  PolyhedronArena(const PolyhedronArena&) = delete;
+  PolyhedronArena& operator=(const PolyhedronArena&) = delete;
+
+  /**
+   * Creates a new arena. No memory is allocated until the first allocation or
+   * reservation.
+   */
+  static Ptr create();
+
+  /**
+   * Returns the arena from which the given pointer was allocated.
+   */
+  static PolyhedronArena& of(const void* ptr);
+
+  /**
+   * Returns the number of bytes taken from a block by an allocation of the given size.
+   */
+  static constexpr size_t slotSize(const size_t size)
+  {
+    return sizeof(PolyhedronArena*) + (size + Alignment - 1) / Alignment * Alignment;
+  }
+
+  /**
+   * Allocates memory for an object of the given size.
+   */
+  void* allocate(size_t size);
+
+  /**
+   * Frees the given pointer, which must have been returned by allocate for the given
+   * size.
+   */
+  static void deallocate(void* ptr, size_t size);
+
+  /**
+   * Frees the given pointer, which must have been returned by allocate. The memory is not
+   * reused until the arena is destroyed.
+   */
+  static void deallocate(void* ptr);
+
+  /**
+   * Ensures that the given number of bytes can be allocated without allocating more
+   * than one additional block. Use slotSize to compute the number of bytes that are
+   * required for an allocation.
+   */
+  void reserve(size_t size);
+
+  /**
+   * Returns the number of blocks allocated by this arena.
+   */
+  size_t blockCount() const;
+
+  /**
+   * Returns the number of bytes allocated by this arena, including the memory that is
+   * not yet used or that was freed for reuse.
+   */
+  size_t allocatedBytes() const;
+
+  /**
+   * Returns the number of live allocations of this arena, plus one if the arena is owned
+   * by a polyhedron.
+   */
+  size_t referenceCount() const;
+
+private:
+  void addBlock(size_t size);
+  FreeList* findFreeList(size_t slotSize);
+  void retain();
+  void release();
+};
+
+/**
+ * Base class of the elements of a polyhedron. Provides the allocation functions that
+ * create the elements in a PolyhedronArena.
+ *
+ * Elements must be created using placement new syntax, e.g. new (arena) Vertex{p}, but
+ * they are deleted using regular delete expressions.
+ */
+class PolyhedronArenaElement
+{
+public:
+  static void* operator new(std::size_t size, PolyhedronArena& arena);
+  static void operator delete(void* ptr, PolyhedronArena& arena);
+  static void operator delete(void* ptr, std::size_t size);
+};
+
+} // namespace tb::mdl
@@ -459,16 +459,16 @@ void Polyhedron<T, FP, VP>::intersectWithPlane(
 {
   auto* newBoundaryLast = oldBoundaryFirst->previous();
 
-  auto* oldBoundarySplitter = new HalfEdge{newBoundaryFirst->origin()};
-  auto* newBoundarySplitter = new HalfEdge{oldBoundaryFirst->origin()};
+  auto* oldBoundarySplitter = new (arena()) HalfEdge{newBoundaryFirst->origin()};
+  auto* newBoundarySplitter = new (arena()) HalfEdge{oldBoundaryFirst->origin()};
 
   auto* oldFace = oldBoundaryFirst->face();
   oldFace->insertIntoBoundaryAfter(newBoundaryLast, HalfEdgeList({newBoundarySplitter}));
   auto newBoundary = oldFace->replaceBoundary(
     newBoundaryFirst, newBoundarySplitter, HalfEdgeList({oldBoundarySplitter}));
 
-  auto* newFace = new Face{std::move(newBoundary), oldFace->plane()};
-  auto* newEdge = new Edge{oldBoundarySplitter, newBoundarySplitter};
+  auto* newFace = new (arena()) Face{std::move(newBoundary), oldFace->plane()};
+  auto* newEdge = new (arena()) Edge{oldBoundarySplitter, newBoundarySplitter};
 
   m_edges.push_back(newEdge);
   m_faces.push_back(newFace);
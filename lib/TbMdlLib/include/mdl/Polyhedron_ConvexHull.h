@@ -117,7 +117,7 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addFirstPoint(
 {
   contract_pre(empty());
 
-  auto* newVertex = new Vertex{position};
+  auto* newVertex = new (arena()) Vertex{position};
   m_vertices.push_back(newVertex);
   return newVertex;
 }
@@ -131,12 +131,12 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addSecondPoint(
   auto* onlyVertex = *m_vertices.begin();
   if (position != onlyVertex->position())
   {
-    auto* newVertex = new Vertex{position};
+    auto* newVertex = new (arena()) Vertex{position};
     m_vertices.push_back(newVertex);
 
-    auto* halfEdge1 = new HalfEdge{onlyVertex};
-    auto* halfEdge2 = new HalfEdge{newVertex};
-    auto* edge = new Edge{halfEdge1, halfEdge2};
+    auto* halfEdge1 = new (arena()) HalfEdge{onlyVertex};
+    auto* halfEdge2 = new (arena()) HalfEdge{newVertex};
+    auto* edge = new (arena()) Edge{halfEdge1, halfEdge2};
     m_edges.push_back(edge);
     return newVertex;
   }
@@ -205,8 +205,8 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addNonColinearThi
 
   if (const auto plane = vm::from_points(v2->position(), v1->position(), position))
   {
-    auto* v3 = new Vertex{position};
-    auto* h3 = new HalfEdge{v3};
+    auto* v3 = new (arena()) Vertex{position};
+    auto* h3 = new (arena()) HalfEdge{v3};
 
     auto* e1 = m_edges.front();
     e1->makeFirstEdge(h1);
@@ -217,10 +217,10 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addNonColinearThi
     boundary.push_back(h2);
     boundary.push_back(h3);
 
-    auto* face = new Face{std::move(boundary), *plane};
+    auto* face = new (arena()) Face{std::move(boundary), *plane};
 
-    auto* e2 = new Edge{h2};
-    auto* e3 = new Edge{h3};
+    auto* e2 = new (arena()) Edge{h2};
+    auto* e3 = new (arena()) Edge{h3};
 
     m_vertices.push_back(v3);
     m_edges.push_back(e2);
@@ -319,9 +319,9 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPointToPolygon
 
   // Now we know which edges are visible from the point. These will have to be replaced
   // with two new edges.
-  auto* newVertex = new Vertex{position};
-  auto* h1 = new HalfEdge{firstVisibleEdge->origin()};
-  auto* h2 = new HalfEdge{newVertex};
+  auto* newVertex = new (arena()) Vertex{position};
+  auto* h1 = new (arena()) HalfEdge{firstVisibleEdge->origin()};
+  auto* h2 = new (arena()) HalfEdge{newVertex};
 
   face->insertIntoBoundaryAfter(lastVisibleEdge, HalfEdgeList{h1});
   face->insertIntoBoundaryAfter(h1, HalfEdgeList{h2});
@@ -329,8 +329,8 @@ typename Polyhedron<T, FP, VP>::Vertex* Polyhedron<T, FP, VP>::addPointToPolygon
 
   h1->setAsLeaving();
 
-  auto* e1 = new Edge{h1};
-  auto* e2 = new Edge{h2};
+  auto* e1 = new (arena()) Edge{h1};
+  auto* e2 = new (arena()) Edge{h2};
 
   // delete the visible vertices and edges.
   // the visible half edges are deleted when visibleEdges goes out of scope
@@ -794,12 +794,12 @@ typename Polyhedron<T, FP, VP>::Face* Polyhedron<T, FP, VP>::sealWithSinglePolyg
     contract_assert(!seamEdge->fullySpecified());
 
     auto* origin = seamEdge->secondVertex();
-    auto* boundaryEdge = new HalfEdge{origin};
+    auto* boundaryEdge = new (arena()) HalfEdge{origin};
     boundary.push_back(boundaryEdge);
     seamEdge->setSecondEdge(boundaryEdge);
   }
 
-  auto* face = new Face{std::move(boundary), plane};
+  auto* face = new (arena()) Face{std::move(boundary), plane};
   m_faces.push_back(face);
   return face;
 }
@@ -838,7 +838,7 @@ std::optional<typename Polyhedron<T, FP, VP>::WeaveConeResult> Polyhedron<T, FP,
   auto faces = FaceList{};
   HalfEdge* firstSeamEdge = nullptr;
 
-  auto* top = new Vertex{position};
+  auto* top = new (arena()) Vertex{position};
   vertices.push_back(top);
 
   HalfEdge* first = nullptr;
@@ -849,9 +849,9 @@ std::optional<typename Polyhedron<T, FP, VP>::WeaveConeResult> Polyhedron<T, FP,
     auto* v1 = edge->secondVertex();
     auto* v2 = edge->firstVertex();
 
-    auto* h1 = new HalfEdge{top};
-    auto* h2 = new HalfEdge{v1};
-    auto* h3 = new HalfEdge{v2};
+    auto* h1 = new (arena()) HalfEdge{top};
+    auto* h2 = new (arena()) HalfEdge{v1};
+    auto* h3 = new (arena()) HalfEdge{v2};
     auto* h = h3;
 
     auto boundary = HalfEdgeList{};
@@ -870,11 +870,11 @@ std::optional<typename Polyhedron<T, FP, VP>::WeaveConeResult> Polyhedron<T, FP,
       return std::nullopt;
     }
 
-    faces.push_back(new Face{std::move(boundary), *plane});
+    faces.push_back(new (arena()) Face{std::move(boundary), *plane});
 
     if (last)
     {
-      edges.push_back(new Edge{h1, last});
+      edges.push_back(new (arena()) Edge{h1, last});
     }
 
     if (!first)
@@ -886,7 +886,7 @@ std::optional<typename Polyhedron<T, FP, VP>::WeaveConeResult> Polyhedron<T, FP,
   }
 
   contract_assert(first->face() != last->face());
-  edges.push_back(new Edge(first, last));
+  edges.push_back(new (arena()) Edge(first, last));
 
   return WeaveConeResult{
     std::move(vertices), std::move(edges), std::move(faces), firstSeamEdge};
@@ -274,12 +274,15 @@ Polyhedron_Edge<T, FP, VP>* Polyhedron_Edge<T, FP, VP>::insertVertex(
 
   using HalfEdgeList = Polyhedron_HalfEdgeList<T, FP, VP>;
 
+  // the new elements belong to the same polyhedron as this edge
+  auto& arena = PolyhedronArena::of(this);
+
   // create new vertices and new half edges originating from it
   // the caller is responsible for storing the newly created vertex!
-  auto* newVertex = new Vertex{position};
-  auto* newFirstEdge = new HalfEdge{newVertex};
+  auto* newVertex = new (arena) Vertex{position};
+  auto* newFirstEdge = new (arena) HalfEdge{newVertex};
   auto* oldFirstEdge = firstEdge();
-  auto* newSecondEdge = new HalfEdge{newVertex};
+  auto* newSecondEdge = new (arena) HalfEdge{newVertex};
   auto* oldSecondEdge = secondEdge();
 
   // insert the new half edges into the corresponding faces
@@ -295,7 +298,7 @@ Polyhedron_Edge<T, FP, VP>* Polyhedron_Edge<T, FP, VP>::insertVertex(
   // and replace it with new2nd
   setSecondEdge(newSecondEdge);
 
-  return new Edge{newFirstEdge, oldSecondEdge};
+  return new (arena) Edge{newFirstEdge, oldSecondEdge};
 }
 
 template <typename T, typename FP, typename VP>
@@ -33,6 +33,8 @@
 #include "vm/vec_io.h" // IWYU pragma: keep
 
 #include <algorithm>
+#include <map>
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -102,71 +104,77 @@ Polyhedron<T, FP, VP>::Polyhedron(const vm::bbox<T, 3>& bounds)
   const auto p7 = vm::vec<T, 3>{m_bounds.max.x(), m_bounds.max.y(), m_bounds.min.z()};
   const auto p8 = vm::vec<T, 3>{m_bounds.max.x(), m_bounds.max.y(), m_bounds.max.z()};
 
-  auto* v1 = new Vertex{p1};
-  auto* v2 = new Vertex{p2};
-  auto* v3 = new Vertex{p3};
-  auto* v4 = new Vertex{p4};
-  auto* v5 = new Vertex{p5};
-  auto* v6 = new Vertex{p6};
-  auto* v7 = new Vertex{p7};
-  auto* v8 = new Vertex{p8};
+  auto* v1 = new (arena()) Vertex{p1};
+  auto* v2 = new (arena()) Vertex{p2};
+  auto* v3 = new (arena()) Vertex{p3};
+  auto* v4 = new (arena()) Vertex{p4};
+  auto* v5 = new (arena()) Vertex{p5};
+  auto* v6 = new (arena()) Vertex{p6};
+  auto* v7 = new (arena()) Vertex{p7};
+  auto* v8 = new (arena()) Vertex{p8};
 
   m_vertices = VertexList{v1, v2, v3, v4, v5, v6, v7, v8};
 
   // Front face
-  auto* f1h1 = new HalfEdge{v1};
-  auto* f1h2 = new HalfEdge{v5};
-  auto* f1h3 = new HalfEdge{v6};
-  auto* f1h4 = new HalfEdge{v2};
-  m_faces.push_back(new Face{HalfEdgeList{f1h1, f1h2, f1h3, f1h4}, {p1, {0, -1, 0}}});
+  auto* f1h1 = new (arena()) HalfEdge{v1};
+  auto* f1h2 = new (arena()) HalfEdge{v5};
+  auto* f1h3 = new (arena()) HalfEdge{v6};
+  auto* f1h4 = new (arena()) HalfEdge{v2};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f1h1, f1h2, f1h3, f1h4}, {p1, {0, -1, 0}}});
 
   // Left face
-  auto* f2h1 = new HalfEdge{v1};
-  auto* f2h2 = new HalfEdge{v2};
-  auto* f2h3 = new HalfEdge{v4};
-  auto* f2h4 = new HalfEdge{v3};
-  m_faces.push_back(new Face{HalfEdgeList{f2h1, f2h2, f2h3, f2h4}, {p1, {-1, 0, 0}}});
+  auto* f2h1 = new (arena()) HalfEdge{v1};
+  auto* f2h2 = new (arena()) HalfEdge{v2};
+  auto* f2h3 = new (arena()) HalfEdge{v4};
+  auto* f2h4 = new (arena()) HalfEdge{v3};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f2h1, f2h2, f2h3, f2h4}, {p1, {-1, 0, 0}}});
 
   // Bottom face
-  auto* f3h1 = new HalfEdge{v1};
-  auto* f3h2 = new HalfEdge{v3};
-  auto* f3h3 = new HalfEdge{v7};
-  auto* f3h4 = new HalfEdge{v5};
-  m_faces.push_back(new Face{HalfEdgeList{f3h1, f3h2, f3h3, f3h4}, {p1, {0, 0, -1}}});
+  auto* f3h1 = new (arena()) HalfEdge{v1};
+  auto* f3h2 = new (arena()) HalfEdge{v3};
+  auto* f3h3 = new (arena()) HalfEdge{v7};
+  auto* f3h4 = new (arena()) HalfEdge{v5};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f3h1, f3h2, f3h3, f3h4}, {p1, {0, 0, -1}}});
 
   // Top face
-  auto* f4h1 = new HalfEdge{v2};
-  auto* f4h2 = new HalfEdge{v6};
-  auto* f4h3 = new HalfEdge{v8};
-  auto* f4h4 = new HalfEdge{v4};
-  m_faces.push_back(new Face{HalfEdgeList{f4h1, f4h2, f4h3, f4h4}, {p8, {0, 0, 1}}});
+  auto* f4h1 = new (arena()) HalfEdge{v2};
+  auto* f4h2 = new (arena()) HalfEdge{v6};
+  auto* f4h3 = new (arena()) HalfEdge{v8};
+  auto* f4h4 = new (arena()) HalfEdge{v4};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f4h1, f4h2, f4h3, f4h4}, {p8, {0, 0, 1}}});
 
   // Back face
-  auto* f5h1 = new HalfEdge{v3};
-  auto* f5h2 = new HalfEdge{v4};
-  auto* f5h3 = new HalfEdge{v8};
-  auto* f5h4 = new HalfEdge{v7};
-  m_faces.push_back(new Face{HalfEdgeList{f5h1, f5h2, f5h3, f5h4}, {p8, {0, 1, 0}}});
+  auto* f5h1 = new (arena()) HalfEdge{v3};
+  auto* f5h2 = new (arena()) HalfEdge{v4};
+  auto* f5h3 = new (arena()) HalfEdge{v8};
+  auto* f5h4 = new (arena()) HalfEdge{v7};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f5h1, f5h2, f5h3, f5h4}, {p8, {0, 1, 0}}});
 
   // Right face
-  auto* f6h1 = new HalfEdge{v5};
-  auto* f6h2 = new HalfEdge{v7};
-  auto* f6h3 = new HalfEdge{v8};
-  auto* f6h4 = new HalfEdge{v6};
-  m_faces.push_back(new Face{HalfEdgeList{f6h1, f6h2, f6h3, f6h4}, {p8, {1, 0, 0}}});
-
-  m_edges.push_back(new Edge{f1h4, f2h1}); // v1, v2
-  m_edges.push_back(new Edge{f2h4, f3h1}); // v1, v3
-  m_edges.push_back(new Edge{f1h1, f3h4}); // v1, v5
-  m_edges.push_back(new Edge{f2h2, f4h4}); // v2, v4
-  m_edges.push_back(new Edge{f4h1, f1h3}); // v2, v6
-  m_edges.push_back(new Edge{f2h3, f5h1}); // v3, v4
-  m_edges.push_back(new Edge{f3h2, f5h4}); // v3, v7
-  m_edges.push_back(new Edge{f4h3, f5h2}); // v4, v8
-  m_edges.push_back(new Edge{f1h2, f6h4}); // v5, v6
-  m_edges.push_back(new Edge{f6h1, f3h3}); // v5, v7
-  m_edges.push_back(new Edge{f6h3, f4h2}); // v6, v8
-  m_edges.push_back(new Edge{f6h2, f5h3}); // v7, v8
+  auto* f6h1 = new (arena()) HalfEdge{v5};
+  auto* f6h2 = new (arena()) HalfEdge{v7};
+  auto* f6h3 = new (arena()) HalfEdge{v8};
+  auto* f6h4 = new (arena()) HalfEdge{v6};
+  m_faces.push_back(
+    new (arena()) Face{HalfEdgeList{f6h1, f6h2, f6h3, f6h4}, {p8, {1, 0, 0}}});
+
+  m_edges.push_back(new (arena()) Edge{f1h4, f2h1}); // v1, v2
+  m_edges.push_back(new (arena()) Edge{f2h4, f3h1}); // v1, v3
+  m_edges.push_back(new (arena()) Edge{f1h1, f3h4}); // v1, v5
+  m_edges.push_back(new (arena()) Edge{f2h2, f4h4}); // v2, v4
+  m_edges.push_back(new (arena()) Edge{f4h1, f1h3}); // v2, v6
+  m_edges.push_back(new (arena()) Edge{f2h3, f5h1}); // v3, v4
+  m_edges.push_back(new (arena()) Edge{f3h2, f5h4}); // v3, v7
+  m_edges.push_back(new (arena()) Edge{f4h3, f5h2}); // v4, v8
+  m_edges.push_back(new (arena()) Edge{f1h2, f6h4}); // v5, v6
+  m_edges.push_back(new (arena()) Edge{f6h1, f3h3}); // v5, v7
+  m_edges.push_back(new (arena()) Edge{f6h3, f4h2}); // v6, v8
+  m_edges.push_back(new (arena()) Edge{f6h2, f5h3}); // v7, v8
 }
 
 template <typename T, typename FP, typename VP>
@@ -190,13 +198,102 @@ Polyhedron<T, FP, VP>::Polyhedron(
 
 template <typename T, typename FP, typename VP>
 Polyhedron<T, FP, VP>::Polyhedron(Polyhedron<T, FP, VP>&& other) noexcept
-  : m_vertices{std::move(other.m_vertices)}
+  : m_arena{std::move(other.m_arena)}
+  , m_vertices{std::move(other.m_vertices)}
   , m_edges{std::move(other.m_edges)}
   , m_faces{std::move(other.m_faces)}
   , m_bounds{std::move(other.m_bounds)}
 {
 }
 
+template <typename T, typename FP, typename VP>
+Polyhedron<T, FP, VP>::~Polyhedron()
+{
+  clear();
+}
+
+template <typename T, typename FP, typename VP>
+std::optional<Polyhedron<T, FP, VP>> Polyhedron<T, FP, VP>::fromFaces(
+  const std::vector<vm::vec<T, 3>>& positions,
+  const std::vector<std::vector<size_t>>& faceVertexIndices,
+  const std::vector<vm::plane<T, 3>>& facePlanes)
+{
+  contract_pre(faceVertexIndices.size() == facePlanes.size());
+
+  if (positions.size() < 4 || faceVertexIndices.size() < 4)
+  {
+    return std::nullopt;
+  }
+
+  auto result = Polyhedron<T, FP, VP>{};
+  auto& arena = result.arena();
+
+  auto vertices = std::vector<Vertex*>{};
+  vertices.reserve(positions.size());
+  for (const auto& position : positions)
+  {
+    auto* vertex = new (arena) Vertex{position};
+    result.m_vertices.push_back(vertex);
+    vertices.push_back(vertex);
+  }
+
+  // maps the indices of the origin and destination vertices to the half edge
+  auto halfEdges = std::map<std::pair<size_t, size_t>, HalfEdge*>{};
+  for (size_t i = 0; i < faceVertexIndices.size(); ++i)
+  {
+    const auto& indices = faceVertexIndices[i];
+    if (indices.size() < 3)
+    {
+      return std::nullopt;
+    }
+
+    auto boundary = HalfEdgeList{};
+    for (size_t j = 0; j < indices.size(); ++j)
+    {
+      const auto origin = indices[j];
+      const auto destination = indices[(j + 1) % indices.size()];
+      if (origin >= vertices.size() || destination >= vertices.size())
+      {
+        return std::nullopt;
+      }
+
+      auto* halfEdge = new (arena) HalfEdge{vertices[origin]};
+      boundary.push_back(halfEdge);
+      if (!halfEdges.emplace(std::pair{origin, destination}, halfEdge).second)
+      {
+        return std::nullopt;
+      }
+    }
+
+    result.m_faces.push_back(new (arena) Face{std::move(boundary), facePlanes[i]});
+  }
+
+  for (const auto& [indices, halfEdge] : halfEdges)
+  {
+    const auto& [origin, destination] = indices;
+    const auto twin = halfEdges.find(std::pair{destination, origin});
+    if (twin == halfEdges.end())
+    {
+      return std::nullopt;
+    }
+
+    if (origin < destination)
+    {
+      result.m_edges.push_back(new (arena) Edge{halfEdge, twin->second});
+    }
+  }
+
+  if (!std::ranges::all_of(vertices, [](const auto* vertex) {
+        return vertex->leaving() != nullptr;
+      }))
+  {
+    return std::nullopt;
+  }
+
+  result.updateBounds();
+  return result;
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron<T, FP, VP>& Polyhedron<T, FP, VP>::operator=(
   const Polyhedron<T, FP, VP>& other)
@@ -207,8 +304,13 @@ Polyhedron<T, FP, VP>& Polyhedron<T, FP, VP>::operator=(
 }
 
 template <typename T, typename FP, typename VP>
-Polyhedron<T, FP, VP>& Polyhedron<T, FP, VP>::operator=(Polyhedron<T, FP, VP>&& other) =
-  default;
+Polyhedron<T, FP, VP>& Polyhedron<T, FP, VP>::operator=(Polyhedron<T, FP, VP>&& other)
+{
+  // the previous contents are destroyed with the moved polyhedron
+  auto moved = Polyhedron<T, FP, VP>{std::move(other)};
+  swap(*this, moved);
+  return *this;
+}
 
 /**
  * Copies a polyhedron.
@@ -253,6 +355,11 @@ private:
    */
   Polyhedron& m_destination;
 
+  /**
+   * The arena of the destination polyhedron.
+   */
+  PolyhedronArena& m_arena;
+
 public:
   /**
    * Copies a polyhedron with the given faces, edges and vertices into the given
@@ -272,7 +379,9 @@ public:
     Polyhedron& destination,
     const CopyCallback& callback)
     : m_destination{destination}
+    , m_arena{destination.arena()}
   {
+    reserve(originalFaces, originalEdges, originalVertices);
     copyVertices(originalVertices, callback);
     copyFaces(originalFaces, callback);
     copyEdges(originalEdges);
@@ -280,11 +389,36 @@ public:
   }
 
 private:
+  /**
+   * Reserves the memory for all elements of the copy so that they are allocated in a
+   * single block of the destination's arena.
+   */
+  void reserve(
+    const FaceList& originalFaces,
+    const EdgeList& originalEdges,
+    const VertexList& originalVertices)
+  {
+    auto halfEdgeCount = size_t(0);
+    for (const auto* face : originalFaces)
+    {
+      halfEdgeCount += face->boundary().size();
+    }
+
+    m_arena.reserve(
+      originalVertices.size() * PolyhedronArena::slotSize(sizeof(Vertex))
+      + originalEdges.size() * PolyhedronArena::slotSize(sizeof(Edge))
+      + halfEdgeCount * PolyhedronArena::slotSize(sizeof(HalfEdge))
+      + originalFaces.size() * PolyhedronArena::slotSize(sizeof(Face)));
+
+    m_vertexMap.reserve(originalVertices.size());
+    m_halfEdgeMap.reserve(halfEdgeCount);
+  }
+
   void copyVertices(const VertexList& originalVertices, const CopyCallback& callback)
   {
     for (const auto* currentVertex : originalVertices)
     {
-      auto* copy = new Vertex{currentVertex->position()};
+      auto* copy = new (m_arena) Vertex{currentVertex->position()};
       callback.vertexWasCopied(currentVertex, copy);
       assert(m_vertexMap.count(currentVertex) == 0u);
 
@@ -310,7 +444,7 @@ private:
       myBoundary.push_back(copyHalfEdge(currentHalfEdge));
     }
 
-    auto* copy = new Face{std::move(myBoundary), originalFace->plane()};
+    auto* copy = new (m_arena) Face{std::move(myBoundary), originalFace->plane()};
     callback.faceWasCopied(originalFace, copy);
     m_faces.push_back(copy);
   }
@@ -320,7 +454,7 @@ private:
     const auto* originalOrigin = original->origin();
 
     auto* myOrigin = findVertex(originalOrigin);
-    auto* copy = new HalfEdge{myOrigin};
+    auto* copy = new (m_arena) HalfEdge{myOrigin};
     assert(m_halfEdgeMap.count(original) == 0u);
     m_halfEdgeMap.emplace(original, copy);
     return copy;
@@ -347,11 +481,11 @@ private:
     auto* myFirst = findOrCopyHalfEdge(original->firstEdge());
     if (!original->fullySpecified())
     {
-      return new Edge{myFirst};
+      return new (m_arena) Edge{myFirst};
     }
 
     auto* mySecond = findOrCopyHalfEdge(original->secondEdge());
-    return new Edge{myFirst, mySecond};
+    return new (m_arena) Edge{myFirst, mySecond};
   }
 
   HalfEdge* findOrCopyHalfEdge(const HalfEdge* original)
@@ -363,7 +497,7 @@ private:
 
     const auto* originalOrigin = original->origin();
     auto* myOrigin = findVertex(originalOrigin);
-    auto* copy = new HalfEdge{myOrigin};
+    auto* copy = new (m_arena) HalfEdge{myOrigin};
     m_halfEdgeMap.emplace(original, copy);
     return copy;
   }
@@ -502,6 +636,12 @@ const vm::bbox<T, 3>& Polyhedron<T, FP, VP>::bounds() const
   return m_bounds;
 }
 
+template <typename T, typename FP, typename VP>
+std::size_t Polyhedron<T, FP, VP>::allocatedBytes() const
+{
+  return m_arena ? m_arena->allocatedBytes() : 0u;
+}
+
 template <typename T, typename FP, typename VP>
 bool Polyhedron<T, FP, VP>::empty() const
 {
@@ -541,6 +681,14 @@ bool Polyhedron<T, FP, VP>::closed() const
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::clear()
 {
+  // the half edges of an edge polyhedron are not owned by any face
+  if (edge())
+  {
+    auto* onlyEdge = m_edges.front();
+    delete onlyEdge->firstEdge();
+    delete onlyEdge->secondEdge();
+  }
+
   m_faces.clear();
   m_edges.clear();
   m_vertices.clear();
@@ -743,6 +891,21 @@ typename Polyhedron<T, FP, VP>::Face* Polyhedron<T, FP, VP>::findClosestFace(
   return closestFace;
 }
 
+template <typename T, typename FP, typename VP>
+PolyhedronArena& Polyhedron<T, FP, VP>::arena()
+{
+  static_assert(alignof(Vertex) <= PolyhedronArena::Alignment);
+  static_assert(alignof(Edge) <= PolyhedronArena::Alignment);
+  static_assert(alignof(HalfEdge) <= PolyhedronArena::Alignment);
+  static_assert(alignof(Face) <= PolyhedronArena::Alignment);
+
+  if (!m_arena)
+  {
+    m_arena = PolyhedronArena::create();
+  }
+  return *m_arena;
+}
+
 template <typename T, typename FP, typename VP>
 void Polyhedron<T, FP, VP>::updateBounds()
 {
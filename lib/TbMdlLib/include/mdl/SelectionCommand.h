@@ -65,6 +65,8 @@ public:
     Action action, std::vector<Node*> nodes, std::vector<BrushFaceHandle> faces);
   ~SelectionCommand() override;
 
+  size_t memoryUsage() const override;
+
 private:
   static std::string makeName(Action action, size_t nodeCount, size_t faceCount);
 
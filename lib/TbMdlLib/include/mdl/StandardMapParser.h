@@ -69,7 +69,7 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -104,6 +104,22 @@ public:
   StandardMapParser(
     std::string_view str, MapFormat sourceMapFormat, MapFormat targetMapFormat);
 
+  /**
+   * Creates a new parser for a part of a larger string. The given start location is the
+   * location of the first character of the given string within the larger string, and
+   * all reported file locations are relative to the larger string.
+   *
+   * @param str the string to parse
+   * @param startLocation the location of the given string within the larger string
+   * @param sourceMapFormat the expected format of the given string
+   * @param targetMapFormat the format to convert the created objects to
+   */
+  StandardMapParser(
+    std::string_view str,
+    const FileLocation& startLocation,
+    MapFormat sourceMapFormat,
+    MapFormat targetMapFormat);
+
   ~StandardMapParser() override;
 
 protected:
@@ -20,10 +20,12 @@
 #pragma once
 
 #include "base/Macros.h"
+#include "mdl/BrushDelta.h"
 #include "mdl/NodeContents.h"
 #include "mdl/UpdateLinkedGroupsCommandBase.h"
 
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace tb::mdl
@@ -33,7 +35,12 @@ class Node;
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
-  std::vector<std::pair<Node*, NodeContents>> m_nodes;
+  /**
+   * The contents to swap with the current contents of each node. If a swap only changed
+   * the face attributes of a brush, the other brush is stored as a delta relative to the
+   * brush node's current brush, and it is recreated when it is swapped back.
+   */
+  std::vector<std::pair<Node*, std::variant<NodeContents, BrushDelta>>> m_nodes;
 
 public:
   SwapNodeContentsCommand(
@@ -45,6 +52,11 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t memoryUsage() const override;
+
+private:
+  void rebaseBrushDeltas(SwapNodeContentsCommand& other);
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
@@ -0,0 +1,130 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "base/Result.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace tb
+{
+namespace fs
+{
+class FileSystem;
+} // namespace fs
+
+namespace gl
+{
+class Texture;
+} // namespace gl
+
+namespace mdl
+{
+
+/**
+ * Caches decoded image textures on disk so that the image files need not be decoded again
+ * when their textures are loaded in another session.
+ *
+ * A cache file contains the texture buffers in a ready to upload format, and it is read
+ * by mapping it into memory. There is at most one cache file per image file path. It is
+ * identified by a key that is computed from the size and modification time of the image
+ * file if the file is stored on disk, and from its contents otherwise. A cache file is
+ * replaced when its key no longer matches.
+ *
+ * Loading textures via the cache and enabling or disabling the cache are thread safe.
+ */
+class TextureCache
+{
+private:
+  std::filesystem::path m_cacheFolderPath;
+  std::atomic<bool> m_enabled = true;
+
+public:
+  explicit TextureCache(std::filesystem::path cacheFolderPath);
+
+  const std::filesystem::path& cacheFolderPath() const;
+
+  bool enabled() const;
+
+  /**
+   * Enables or disables the cache. While the cache is disabled, image textures are always
+   * decoded, and the cache files are neither read nor written.
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * Loads the texture from the image file at the given path. If the cache contains an up
+   * to date texture for the file, the cached texture is returned. Otherwise, the image
+   * is decoded and the texture is written to the cache.
+   *
+   * Failing to read or write the cache is not an error.
+   */
+  Result<gl::Texture> loadImageTexture(
+    const fs::FileSystem& fs, const std::filesystem::path& path) const;
+};
+
+/**
+ * Computes a cache key from the contents of an image file.
+ */
+uint64_t computeTextureCacheKey(std::string_view imageFileContents);
+
+/**
+ * Computes a cache key from the size and the modification time of an image file on disk.
+ */
+uint64_t computeTextureCacheKey(
+  size_t imageFileSize, std::filesystem::file_time_type imageFileModificationTime);
+
+/**
+ * Returns the path of the texture cache file for the image file at the given path.
+ */
+std::filesystem::path makeTextureCachePath(
+  const std::filesystem::path& cacheFolderPath, const std::filesystem::path& imagePath);
+
+/**
+ * Reads a texture from the given cache file. Returns an error if the file cannot be read,
+ * if it is corrupt, or if its key does not match the given key.
+ */
+Result<gl::Texture> readTextureCache(const std::filesystem::path& path, uint64_t key);
+
+/**
+ * Writes the given texture to the given cache file. The texture must be loaded, i.e. its
+ * buffers must be available.
+ *
+ * The file is replaced atomically so that concurrent readers never see a partially
+ * written file.
+ */
+Result<void> writeTextureCache(
+  const std::filesystem::path& path, uint64_t key, const gl::Texture& texture);
+
+/**
+ * Deletes the least recently used cache files in the given folder until the total size
+ * of the remaining cache files does not exceed the given size. Reading a cache file
+ * counts as using it.
+ *
+ * Cache files that cannot be deleted, e.g. because they are being read, are skipped.
+ */
+Result<void> trimTextureCache(
+  const std::filesystem::path& cacheFolderPath, size_t maxSize);
+
+} // namespace mdl
+} // namespace tb
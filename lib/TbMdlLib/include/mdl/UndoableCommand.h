@@ -45,6 +45,13 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes of memory that this command retains in
+   * order to be undone or redone. Commands that only retain a small, fixed amount of
+   * memory need not override this.
+   */
+  virtual size_t memoryUsage() const;
+
 protected:
   virtual bool doPerformUndo(Map& map) = 0;
 
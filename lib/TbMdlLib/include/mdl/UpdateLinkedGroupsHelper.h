@@ -66,6 +66,11 @@ public:
   void undoLinkedGroupUpdates(Map& map);
   void collateWith(UpdateLinkedGroupsHelper& other);
 
+  /**
+   * Returns an estimate of the memory used by the nodes owned by this helper.
+   */
+  size_t memoryUsage() const;
+
 private:
   Result<void> computeLinkedGroupUpdates(Map& map);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
@@ -22,11 +22,14 @@
 #include "base/Macros.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/HitFilter.h"
 #include "mdl/IdType.h"
 #include "mdl/MapFormat.h"
 #include "mdl/Node.h"
 #include "mdl/NodeTree.h"
 
+#include "vm/ray.h"
+
 #include <memory>
 #include <vector>
 
@@ -123,6 +126,29 @@ public: // validator registration
   void registerValidator(std::unique_ptr<Validator> validator);
   void unregisterAllValidators();
 
+public: // picking
+  /**
+   * Picks the nodes of this world in the order in which the given ray hits their bounds.
+   * Stops once the given number of hits matching the given filter have been found and no
+   * remaining node can be hit closer than the farthest of them.
+   *
+   * The pick result contains the hits of every node that was picked, including hits
+   * that do not match the filter. Since the traversal is ordered by distance, the pick
+   * result should compare hits by distance, too.
+   *
+   * @param editorContext the editor context
+   * @param ray the pick ray
+   * @param hitFilter the filter that determines which hits are counted
+   * @param count the number of matching hits to find, must be greater than 0
+   * @param pickResult the pick result to add the hits to
+   */
+  void pickNearest(
+    const EditorContext& editorContext,
+    const vm::ray3d& ray,
+    const HitFilter& hitFilter,
+    size_t count,
+    PickResult& pickResult);
+
 public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
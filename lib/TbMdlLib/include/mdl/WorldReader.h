@@ -36,6 +36,7 @@ class ParserStatus;
 
 namespace mdl
 {
+class BrushGeometryCache;
 struct EntityPropertyConfig;
 class WorldNode;
 
@@ -52,8 +53,21 @@ public:
     MapFormat sourceAndTargetMapFormat,
     const EntityPropertyConfig& entityPropertyConfig);
 
+  /**
+   * Parses the string and returns the world.
+   *
+   * @param worldBounds world bounds
+   * @param status status
+   * @param taskManager the task manager to use for parallel tasks
+   * @param brushGeometryCache optional cache of brush geometry computed for the same
+   * string, see MapReader::setBrushGeometryCache
+   * @return the world node or an error if the string can't be parsed
+   */
   Result<std::unique_ptr<WorldNode>> read(
-    const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
+    const vm::bbox3d& worldBounds,
+    ParserStatus& status,
+    kdl::task_manager& taskManager,
+    const BrushGeometryCache* brushGeometryCache = nullptr);
 
   /**
    * Try to parse the given string as the given map formats, in order.
@@ -64,6 +78,8 @@ public:
    * @param worldBounds world bounds
    * @param status status
    * @param taskManager the task manager to use for parallel tasks
+   * @param brushGeometryCache optional cache of brush geometry computed for the same
+   * string and formats
    * @return the world node or an error if `str` can't be parsed by any of the given
    * formats
    */
@@ -73,7 +89,8 @@ public:
     const vm::bbox3d& worldBounds,
     const EntityPropertyConfig& entityPropertyConfig,
     ParserStatus& status,
-    kdl::task_manager& taskManager);
+    kdl::task_manager& taskManager,
+    const BrushGeometryCache* brushGeometryCache = nullptr);
 
 private: // implement MapReader interface
   Node* onWorldNode(std::unique_ptr<WorldNode> worldNode, ParserStatus& status) override;
@@ -22,6 +22,7 @@
 #include "base/Macros.h"
 #include "mdl/AddRemoveNodesUtils.h"
 #include "mdl/Map.h"
+#include "mdl/MemoryUsage.h"
 #include "mdl/Node.h"
 
 #include "kd/map_utils.h"
@@ -63,6 +64,20 @@ AddRemoveNodesCommand::AddRemoveNodesCommand(
   }
 }
 
+size_t AddRemoveNodesCommand::memoryUsage() const
+{
+  // only the nodes to add are owned by this command
+  auto result = UpdateLinkedGroupsCommandBase::memoryUsage();
+  for (const auto& [parent, children] : m_nodesToAdd)
+  {
+    for (const auto* child : children)
+    {
+      result += mdl::memoryUsage(*child);
+    }
+  }
+  return result;
+}
+
 std::string AddRemoveNodesCommand::makeName(const Action action)
 {
   switch (action)
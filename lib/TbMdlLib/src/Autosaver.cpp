@@ -20,6 +20,7 @@
 #include "mdl/Autosaver.h"
 
 #include "base/Logger.h"
+#include "base/LoggerCache.h"
 #include "fs/DiskIO.h"
 #include "fs/PathInfo.h"
 #include "fs/TraversalMode.h"
@@ -34,11 +35,14 @@
 #include "kd/result_fold.h"
 #include "kd/string_format.h"
 #include "kd/string_utils.h"
+#include "kd/task_manager.h"
 #include "kd/vector_utils.h"
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <ranges>
 
 namespace tb::mdl
@@ -46,6 +50,29 @@ namespace tb::mdl
 namespace
 {
 
+/**
+ * Records the messages that are logged on a worker thread so that they can be passed on
+ * to the map's logger later.
+ */
+class CachingLogger : public Logger
+{
+private:
+  LoggerCache m_cache;
+
+public:
+  void passOn(Logger& logger)
+  {
+    m_cache.getCachedMessages(
+      [&](const auto level, const auto& message) { logger.log(level, message); });
+  }
+
+private:
+  void doLog(const LogLevel level, const std::string_view message) override
+  {
+    m_cache.cacheMessage(level, message);
+  }
+};
+
 Result<std::filesystem::path> ensureAutosaveDirectory(
   const std::filesystem::path& mapPath)
 {
@@ -117,6 +144,33 @@ Result<void> cleanBackups(
          | kdl::fold;
 }
 
+/**
+ * Thins and compacts the existing backups of the given map and returns the path of the
+ * next backup.
+ */
+Result<std::filesystem::path> prepareBackup(
+  Logger& logger, const std::filesystem::path& mapPath, const size_t maxBackups)
+{
+  const auto mapBasename = mapPath.stem();
+
+  return ensureAutosaveDirectory(mapPath) | kdl::and_then([&](const auto& autosavePath) {
+           return collectBackups(autosavePath, mapBasename)
+                  | kdl::and_then([&](auto backups) {
+                      return thinBackups(logger, backups, maxBackups);
+                    })
+                  | kdl::and_then([&](auto remainingBackups) {
+                      return cleanBackups(remainingBackups, mapBasename, autosavePath)
+                             | kdl::and_then([&]() -> Result<std::filesystem::path> {
+                                 contract_assert(remainingBackups.size() < maxBackups);
+
+                                 const auto backupNo = remainingBackups.size() + 1;
+                                 return autosavePath
+                                        / makeBackupName(mapBasename, backupNo);
+                               });
+                    });
+         });
+}
+
 } // namespace
 
 fs::PathMatcher makeBackupPathMatcher(std::filesystem::path mapBasename_)
@@ -135,6 +189,14 @@ fs::PathMatcher makeBackupPathMatcher(std::filesystem::path mapBasename_)
     };
 }
 
+struct Autosaver::PendingAutosave
+{
+  Clock::time_point snapshotTime;
+  size_t modificationCount;
+  CachingLogger logger;
+  std::future<Result<std::filesystem::path>> result;
+};
+
 Autosaver::Autosaver(
   Map& map, const std::chrono::milliseconds saveInterval, const size_t maxBackups)
   : m_map{map}
@@ -145,8 +207,29 @@ Autosaver::Autosaver(
 {
 }
 
+Autosaver::~Autosaver()
+{
+  // the map may already be gone, so the result is not reported
+  if (m_pendingAutosave)
+  {
+    m_pendingAutosave->result.wait();
+  }
+}
+
 void Autosaver::triggerAutosave()
 {
+  if (m_pendingAutosave)
+  {
+    if (
+      m_pendingAutosave->result.wait_for(std::chrono::seconds{0})
+      != std::future_status::ready)
+    {
+      // coalesce with the pending autosave
+      return;
+    }
+    finishPendingAutosave();
+  }
+
   if (
     m_map.modified() && m_map.modificationCount() != m_lastModificationCount
     && Clock::now() - m_lastSaveTime >= m_saveInterval && m_map.persistent()
@@ -156,33 +239,46 @@ void Autosaver::triggerAutosave()
   }
 }
 
+void Autosaver::waitForPendingAutosave()
+{
+  if (m_pendingAutosave)
+  {
+    m_pendingAutosave->result.wait();
+    finishPendingAutosave();
+  }
+}
+
 void Autosaver::autosave()
 {
   const auto& mapPath = m_map.path();
   contract_assert(fs::Disk::pathInfo(mapPath) == fs::PathInfo::File);
 
-  const auto mapFilename = mapPath.filename();
-  const auto mapBasename = mapPath.stem();
+  m_pendingAutosave = std::make_unique<PendingAutosave>();
+  m_pendingAutosave->snapshotTime = Clock::now();
+  m_pendingAutosave->modificationCount = m_map.modificationCount();
 
-  ensureAutosaveDirectory(mapPath) | kdl::and_then([&](const auto& autosavePath) {
-    return collectBackups(autosavePath, mapBasename) | kdl::and_then([&](auto backups) {
-             return thinBackups(m_map.logger(), backups, m_maxBackups);
-           })
-           | kdl::and_then([&](auto remainingBackups) {
-               return cleanBackups(remainingBackups, mapBasename, autosavePath)
-                      | kdl::and_then([&]() -> Result<std::filesystem::path> {
-                          contract_assert(remainingBackups.size() < m_maxBackups);
-
-                          const auto backupNo = remainingBackups.size() + 1;
-                          return autosavePath / makeBackupName(mapBasename, backupNo);
-                        });
-             });
-  }) | kdl::and_then([&](const auto& backupFilePath) {
-    m_lastSaveTime = Clock::now();
-    m_lastModificationCount = m_map.modificationCount();
-    return m_map.saveTo(backupFilePath) | kdl::transform([&]() {
-             m_map.logger().info() << "Created autosave backup at " << backupFilePath;
-           });
+  m_pendingAutosave->result = m_map.taskManager().run_task(
+    [mapPath = mapPath,
+     maxBackups = m_maxBackups,
+     save = m_map.snapshotForSaving(),
+     &logger = m_pendingAutosave->logger]() {
+      return prepareBackup(logger, mapPath, maxBackups)
+             | kdl::and_then([&](const auto& backupFilePath) {
+                 return save(backupFilePath)
+                        | kdl::transform([&]() { return backupFilePath; });
+               });
+    });
+}
+
+void Autosaver::finishPendingAutosave()
+{
+  auto pendingAutosave = std::move(m_pendingAutosave);
+  pendingAutosave->logger.passOn(m_map.logger());
+
+  pendingAutosave->result.get() | kdl::transform([&](const auto& backupFilePath) {
+    m_lastSaveTime = pendingAutosave->snapshotTime;
+    m_lastModificationCount = pendingAutosave->modificationCount;
+    m_map.logger().info() << "Created autosave backup at " << backupFilePath;
   }) | kdl::transform_error([&](auto e) {
     m_map.logger().error() << "Aborting autosave: " << e.msg;
   });
@@ -180,6 +180,43 @@ Result<Brush> Brush::create(const vm::bbox3d& worldBounds, std::vector<BrushFace
          | kdl::transform([&]() { return std::move(brush); });
 }
 
+Result<Brush> Brush::createFromGeometry(
+  std::vector<BrushFace>& faces, BrushGeometry geometry)
+{
+  auto faceIndices = std::vector<size_t>{};
+  faceIndices.reserve(geometry.faceCount());
+
+  for (const auto* faceGeometry : geometry.faces())
+  {
+    const auto faceIndex = kdl::index_of(faces, [&](const auto& face) {
+      return face.boundary() == faceGeometry->plane();
+    });
+    if (!faceIndex || std::ranges::find(faceIndices, *faceIndex) != faceIndices.end())
+    {
+      return Error{"Brush geometry does not match brush faces"};
+    }
+    faceIndices.push_back(*faceIndex);
+  }
+
+  auto brush = Brush{};
+  brush.m_geometry = std::make_unique<BrushGeometry>(std::move(geometry));
+  brush.m_faces.reserve(faceIndices.size());
+
+  for (auto* faceGeometry : brush.m_geometry->faces())
+  {
+    auto& face =
+      brush.m_faces.emplace_back(std::move(faces[faceIndices[brush.m_faces.size()]]));
+    face.setGeometry(faceGeometry);
+    faceGeometry->setPayload(brush.m_faces.size() - 1u);
+  }
+  faces.clear();
+
+  // too expensive for contract_post
+  assert(brush.checkFaceLinks());
+
+  return brush;
+}
+
 Result<void> Brush::updateGeometryFromFaces(const vm::bbox3d& worldBounds)
 {
   // First, add all faces to the brush geometry
@@ -590,6 +627,11 @@ std::vector<const BrushFace*> Brush::incidentFaces(const BrushVertex* vertex) co
   return result;
 }
 
+size_t Brush::geometryAllocatedBytes() const
+{
+  return m_geometry ? m_geometry->allocatedBytes() : 0u;
+}
+
 bool Brush::canTransformVertices(
   const vm::bbox3d& worldBounds,
   const std::vector<vm::vec3d>& vertices,
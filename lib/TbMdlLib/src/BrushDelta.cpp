@@ -0,0 +1,130 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushDelta.h"
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+
+#include "kd/contracts.h"
+
+#include <algorithm>
+
+namespace tb::mdl
+{
+namespace
+{
+
+bool hasSameGeometry(const Brush& lhs, const Brush& rhs)
+{
+  if (lhs.faceCount() != rhs.faceCount() || lhs.vertexCount() != rhs.vertexCount())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.faceCount(); ++i)
+  {
+    const auto& lhsFace = lhs.face(i);
+    const auto& rhsFace = rhs.face(i);
+    if (
+      lhsFace.points() != rhsFace.points() || lhsFace.boundary() != rhsFace.boundary()
+      || lhsFace.selected() != rhsFace.selected())
+    {
+      return false;
+    }
+  }
+
+  // the vertices must also be in the same order to ensure that the base brush's geometry
+  // can be used as is
+  return std::ranges::equal(
+    lhs.vertices(), rhs.vertices(), [](const auto* lhsVertex, const auto* rhsVertex) {
+      return lhsVertex->position() == rhsVertex->position();
+    });
+}
+
+bool hasSameAttributes(const BrushFace& lhs, const BrushFace& rhs)
+{
+  return lhs.materialName() == rhs.materialName()
+         && lhs.uvCoordSystem() == rhs.uvCoordSystem()
+         && lhs.surfaceAttributes() == rhs.surfaceAttributes();
+}
+
+} // namespace
+
+BrushDelta::BrushDelta(std::vector<FaceAttributes> faces)
+  : m_faces{std::move(faces)}
+{
+}
+
+std::optional<BrushDelta> BrushDelta::create(const Brush& brush, const Brush& base)
+{
+  if (!hasSameGeometry(brush, base))
+  {
+    return std::nullopt;
+  }
+
+  auto faces = std::vector<FaceAttributes>{};
+  for (size_t i = 0; i < brush.faceCount(); ++i)
+  {
+    const auto& face = brush.face(i);
+    if (!hasSameAttributes(face, base.face(i)))
+    {
+      faces.push_back(FaceAttributes{
+        i, face.materialName(), face.uvCoordSystem(), face.surfaceAttributes()});
+    }
+  }
+  faces.shrink_to_fit();
+
+  return BrushDelta{std::move(faces)};
+}
+
+Brush BrushDelta::apply(const Brush& base) const
+{
+  auto result = base;
+  for (const auto& faceAttributes : m_faces)
+  {
+    contract_assert(faceAttributes.faceIndex < result.faceCount());
+
+    auto& face = result.face(faceAttributes.faceIndex);
+    face.setMaterialName(faceAttributes.materialName);
+    face.setUvCoordSystem(faceAttributes.uvCoordSystem);
+    face.setSurfaceAttributes(faceAttributes.surfaceAttributes);
+  }
+  return result;
+}
+
+size_t BrushDelta::faceCount() const
+{
+  return m_faces.size();
+}
+
+size_t BrushDelta::memoryUsage() const
+{
+  auto result = sizeof(BrushDelta) + m_faces.capacity() * sizeof(FaceAttributes);
+  for (const auto& faceAttributes : m_faces)
+  {
+    if (faceAttributes.materialName.capacity() > std::string{}.capacity())
+    {
+      result += faceAttributes.materialName.capacity() + 1u;
+    }
+  }
+  return result;
+}
+
+} // namespace tb::mdl
@@ -534,6 +534,11 @@ const UvCoordSystem& BrushFace::uvCoordSystem() const
   return m_uvCoordSystem;
 }
 
+void BrushFace::setUvCoordSystem(UvCoordSystem uvCoordSystem)
+{
+  m_uvCoordSystem = std::move(uvCoordSystem);
+}
+
 const gl::Material* BrushFace::material() const
 {
   return m_materialReference.get();
@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushFacePlanes.h"
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace tb::mdl
+{
+
+BrushFacePlanes::BrushFacePlanes() = default;
+
+BrushFacePlanes::BrushFacePlanes(const Brush& brush)
+  : m_count{brush.faceCount()}
+  , m_values(4u * m_count)
+{
+  for (size_t i = 0u; i < m_count; ++i)
+  {
+    const auto& boundary = brush.face(i).boundary();
+    m_values[i] = boundary.normal.x();
+    m_values[m_count + i] = boundary.normal.y();
+    m_values[2u * m_count + i] = boundary.normal.z();
+    m_values[3u * m_count + i] = boundary.distance;
+  }
+}
+
+size_t BrushFacePlanes::count() const
+{
+  return m_count;
+}
+
+size_t BrushFacePlanes::allocatedBytes() const
+{
+  return m_values.capacity() * sizeof(double);
+}
+
+std::optional<std::tuple<double, size_t>> BrushFacePlanes::intersect(
+  const vm::ray3d& ray) const
+{
+  const auto* normalX = m_values.data();
+  const auto* normalY = normalX + m_count;
+  const auto* normalZ = normalY + m_count;
+  const auto* distances = normalZ + m_count;
+
+  const auto& origin = ray.origin;
+  const auto& direction = ray.direction;
+
+  auto entry = -std::numeric_limits<double>::max();
+  auto exit = std::numeric_limits<double>::max();
+  auto entryFace = m_count;
+
+  for (size_t i = 0u; i < m_count; ++i)
+  {
+    const auto cos = normalX[i] * direction.x() + normalY[i] * direction.y()
+                     + normalZ[i] * direction.z();
+    const auto originDistance = normalX[i] * origin.x() + normalY[i] * origin.y()
+                                + normalZ[i] * origin.z() - distances[i];
+
+    if (cos < 0.0)
+    {
+      // the ray enters the half space below the plane
+      const auto distance = -originDistance / cos;
+      if (distance > entry)
+      {
+        entry = distance;
+        entryFace = i;
+      }
+    }
+    else if (cos > 0.0)
+    {
+      // the ray leaves the half space below the plane
+      exit = std::min(exit, -originDistance / cos);
+    }
+    else if (originDistance > 0.0)
+    {
+      // the ray is parallel to the plane and runs above it
+      return std::nullopt;
+    }
+  }
+
+  if (entryFace == m_count || entry < 0.0 || entry > exit)
+  {
+    return std::nullopt;
+  }
+
+  return std::tuple{entry, entryFace};
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,375 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushGeometryCache.h"
+
+#include "fs/DiskIO.h"
+#include "fs/ReaderException.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CacheFile.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/Polyhedron.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/overload.h"
+#include "kd/ranges/to.h"
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <ranges>
+#include <string>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr auto CacheFileMagic = uint64_t(0x4548434143474254); // "TBGCACHE"
+constexpr auto CacheFileVersion = uint32_t(2);
+
+BrushGeometryCache::Entry makeEntry(const Brush& brush)
+{
+  auto entry = BrushGeometryCache::Entry{};
+
+  auto vertexIndices = std::unordered_map<const BrushVertex*, size_t>{};
+  for (const auto* vertex : brush.vertices())
+  {
+    vertexIndices.emplace(vertex, entry.vertexPositions.size());
+    entry.vertexPositions.push_back(vertex->position());
+  }
+
+  for (const auto& face : brush.faces())
+  {
+    auto& cachedFace = entry.faces.emplace_back(
+      BrushGeometryCache::Face{{}, face.geometry()->plane()});
+    for (const auto* halfEdge : face.geometry()->boundary())
+    {
+      cachedFace.vertexIndices.push_back(vertexIndices.at(halfEdge->origin()));
+    }
+  }
+
+  return entry;
+}
+
+/**
+ * Returns true if every cached face has the plane of a different one of the given faces
+ * and if there are as many cached faces as given faces. The brush key is only a hash of
+ * the face points, so it can match a brush with different faces.
+ */
+bool matchesFaces(
+  const BrushGeometryCache::Entry& entry, const std::vector<BrushFace>& faces)
+{
+  if (entry.faces.size() != faces.size())
+  {
+    return false;
+  }
+
+  auto matched = std::vector<bool>(faces.size(), false);
+  return std::ranges::all_of(entry.faces, [&](const auto& cachedFace) {
+    for (size_t i = 0; i < faces.size(); ++i)
+    {
+      if (!matched[i] && faces[i].boundary() == cachedFace.plane)
+      {
+        matched[i] = true;
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+Result<BrushGeometryCache> readBrushGeometryCache(
+  const fs::MappedFile& file, const uint64_t key)
+{
+  const auto contents = file.stringView();
+  if (contents.size() < sizeof(uint64_t))
+  {
+    return Error{"Brush geometry cache is truncated"};
+  }
+
+  const auto payloadSize = contents.size() - sizeof(uint64_t);
+  auto checksum = uint64_t(0);
+  std::memcpy(&checksum, contents.data() + payloadSize, sizeof(uint64_t));
+
+  auto hash = Fnv1aHash{};
+  hash.update(contents.substr(0, payloadSize));
+  if (hash.value() != checksum)
+  {
+    return Error{"Brush geometry cache is corrupt"};
+  }
+
+  try
+  {
+    auto reader = file.reader().subReaderFromBegin(0, payloadSize);
+    if (
+      reader.read<uint64_t, uint64_t>() != CacheFileMagic
+      || reader.read<uint32_t, uint32_t>() != CacheFileVersion)
+    {
+      return Error{"Unsupported brush geometry cache"};
+    }
+
+    if (reader.read<uint64_t, uint64_t>() != key)
+    {
+      return Error{"Brush geometry cache is stale"};
+    }
+
+    auto cache = BrushGeometryCache{key};
+    const auto entryCount = reader.readSize<uint64_t>();
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+      const auto brushKey = reader.read<uint64_t, uint64_t>();
+
+      auto entry = BrushGeometryCache::Entry{};
+      const auto vertexCount = reader.readSize<uint32_t>();
+      entry.vertexPositions.reserve(vertexCount);
+      for (size_t j = 0; j < vertexCount; ++j)
+      {
+        entry.vertexPositions.push_back(reader.readVec<double, 3>());
+      }
+
+      const auto faceCount = reader.readSize<uint32_t>();
+      entry.faces.reserve(faceCount);
+      for (size_t j = 0; j < faceCount; ++j)
+      {
+        const auto normal = reader.readVec<double, 3>();
+        const auto distance = reader.readDouble<double>();
+
+        auto& face = entry.faces.emplace_back(
+          BrushGeometryCache::Face{{}, vm::plane3d{distance, normal}});
+        const auto indexCount = reader.readSize<uint32_t>();
+        face.vertexIndices.reserve(indexCount);
+        for (size_t k = 0; k < indexCount; ++k)
+        {
+          face.vertexIndices.push_back(reader.readSize<uint32_t>());
+        }
+      }
+
+      cache.add(brushKey, std::move(entry));
+    }
+
+    if (!reader.eof())
+    {
+      return Error{"Brush geometry cache is corrupt"};
+    }
+
+    return cache;
+  }
+  catch (const fs::ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+} // namespace
+
+BrushGeometryCache::BrushGeometryCache(const uint64_t key)
+  : m_key{key}
+{
+}
+
+uint64_t BrushGeometryCache::computeKey(
+  const std::string_view gameName, const vm::bbox3d& worldBounds)
+{
+  auto hash = Fnv1aHash{};
+  hash.update(CacheFileVersion);
+  hash.update(gameName);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    hash.update(worldBounds.min[i]);
+    hash.update(worldBounds.max[i]);
+  }
+  return hash.value();
+}
+
+uint64_t BrushGeometryCache::computeBrushKey(const std::vector<BrushFace>& faces)
+{
+  // the faces of a brush are reordered when its geometry is built
+  auto faceHashes = faces | std::views::transform([](const auto& face) {
+                      auto hash = Fnv1aHash{};
+                      for (const auto& point : face.points())
+                      {
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                          hash.update(point[i]);
+                        }
+                      }
+                      return hash.value();
+                    })
+                    | kdl::ranges::to<std::vector>();
+  std::ranges::sort(faceHashes);
+
+  auto hash = Fnv1aHash{};
+  for (const auto faceHash : faceHashes)
+  {
+    hash.update(faceHash);
+  }
+  return hash.value();
+}
+
+BrushGeometryCache BrushGeometryCache::create(
+  const uint64_t key, const WorldNode& worldNode)
+{
+  return create(key, worldNode, BrushGeometryCache{key});
+}
+
+BrushGeometryCache BrushGeometryCache::create(
+  const uint64_t key, const WorldNode& worldNode, BrushGeometryCache previous)
+{
+  if (previous.key() != key)
+  {
+    previous.m_entries.clear();
+  }
+
+  auto cache = BrushGeometryCache{key};
+  worldNode.accept(kdl::overload(
+    [](auto&& thisLambda, const WorldNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const LayerNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const GroupNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const EntityNode& node) { node.visitChildren(thisLambda); },
+    [&](const BrushNode& node) {
+      const auto& brush = node.brush();
+      const auto brushKey = computeBrushKey(brush.faces());
+      if (!cache.m_entries.contains(brushKey))
+      {
+        if (auto previousEntry = previous.m_entries.extract(brushKey))
+        {
+          cache.m_entries.insert(std::move(previousEntry));
+        }
+        else
+        {
+          cache.add(brushKey, makeEntry(brush));
+        }
+      }
+    },
+    [](const PatchNode&) {}));
+  return cache;
+}
+
+uint64_t BrushGeometryCache::key() const
+{
+  return m_key;
+}
+
+size_t BrushGeometryCache::size() const
+{
+  return m_entries.size();
+}
+
+void BrushGeometryCache::add(const uint64_t brushKey, Entry entry)
+{
+  m_entries[brushKey] = std::move(entry);
+}
+
+std::optional<BrushGeometry> BrushGeometryCache::geometry(
+  const std::vector<BrushFace>& faces) const
+{
+  const auto it = m_entries.find(computeBrushKey(faces));
+  if (it == m_entries.end())
+  {
+    return std::nullopt;
+  }
+
+  const auto& entry = it->second;
+  if (!matchesFaces(entry, faces))
+  {
+    return std::nullopt;
+  }
+
+  auto faceVertexIndices = std::vector<std::vector<size_t>>{};
+  auto facePlanes = std::vector<vm::plane3d>{};
+  faceVertexIndices.reserve(entry.faces.size());
+  facePlanes.reserve(entry.faces.size());
+  for (const auto& face : entry.faces)
+  {
+    faceVertexIndices.push_back(face.vertexIndices);
+    facePlanes.push_back(face.plane);
+  }
+
+  return BrushGeometry::fromFaces(entry.vertexPositions, faceVertexIndices, facePlanes);
+}
+
+const std::unordered_map<uint64_t, BrushGeometryCache::Entry>& BrushGeometryCache::
+  entries() const
+{
+  return m_entries;
+}
+
+std::filesystem::path makeBrushGeometryCachePath(
+  const std::filesystem::path& cacheFolderPath, const std::filesystem::path& mapPath)
+{
+  auto hash = Fnv1aHash{};
+  const auto str = mapPath.generic_u8string();
+  hash.update(reinterpret_cast<const char*>(str.data()), str.size());
+  return cacheFolderPath / fmt::format("{:016x}.bin", hash.value());
+}
+
+Result<BrushGeometryCache> readBrushGeometryCache(
+  const std::filesystem::path& path, const uint64_t key)
+{
+  return fs::Disk::mapFile(path) | kdl::and_then([&](auto file) {
+           return readBrushGeometryCache(*file, key);
+         });
+}
+
+Result<void> writeBrushGeometryCache(
+  const std::filesystem::path& path, const BrushGeometryCache& cache)
+{
+  auto writer = CacheWriter{};
+  writer.write(CacheFileMagic);
+  writer.write(CacheFileVersion);
+  writer.write(cache.key());
+  writer.write(uint64_t(cache.size()));
+  for (const auto& [brushKey, entry] : cache.entries())
+  {
+    writer.write(brushKey);
+    writer.write(uint32_t(entry.vertexPositions.size()));
+    for (const auto& position : entry.vertexPositions)
+    {
+      writer.write(position);
+    }
+
+    writer.write(uint32_t(entry.faces.size()));
+    for (const auto& face : entry.faces)
+    {
+      writer.write(face.plane.normal);
+      writer.write(face.plane.distance);
+      writer.write(uint32_t(face.vertexIndices.size()));
+      for (const auto index : face.vertexIndices)
+      {
+        writer.write(uint32_t(index));
+      }
+    }
+  }
+
+  const auto buffer = writer.finish();
+  return writeCacheFile(path, [&](auto& stream) {
+    stream.write(buffer.data(), std::streamsize(buffer.size()));
+  });
+}
+
+} // namespace tb::mdl
@@ -53,6 +53,7 @@ const HitType::Type BrushNode::BrushHitType = HitType::freeType();
 BrushNode::BrushNode(Brush brush)
   : m_brushRendererBrushCache(std::make_unique<BrushRendererBrushCache>())
   , m_brush(std::move(brush))
+  , m_facePlanes(m_brush)
 {
   clearSelectedFaces();
 }
@@ -101,6 +102,7 @@ Brush BrushNode::setBrush(Brush brush)
 
   using std::swap;
   swap(m_brush, brush);
+  m_facePlanes = BrushFacePlanes{m_brush};
 
   updateSelectedFaceCount();
   invalidateIssues();
@@ -109,6 +111,11 @@ Brush BrushNode::setBrush(Brush brush)
   return brush;
 }
 
+const BrushFacePlanes& BrushNode::facePlanes() const
+{
+  return m_facePlanes;
+}
+
 bool BrushNode::hasSelectedFaces() const
 {
   return m_selectedFaceCount > 0u;
@@ -135,10 +142,21 @@ void BrushNode::setFaceMaterial(const size_t faceIndex, gl::Material* material)
 {
   m_brush.face(faceIndex).setMaterial(material);
 
+  // the surface data of a face can depend on its material
+  setCachedMapText(nullptr);
   invalidateIssues();
   invalidateVertexCache();
 }
 
+void BrushNode::setFaceSurfaceAttributes(
+  const size_t faceIndex, const SurfaceAttributes& surfaceAttributes)
+{
+  m_brush.face(faceIndex).setSurfaceAttributes(surfaceAttributes);
+
+  setCachedMapText(nullptr);
+  invalidateIssues();
+}
+
 static bool containsPatch(const Brush& brush, const PatchGrid& grid)
 {
   if (!brush.bounds().contains(grid.bounds))
@@ -370,14 +388,7 @@ std::optional<std::tuple<double, size_t>> BrushNode::findFaceHit(
 {
   if (vm::intersect_ray_bbox(ray, logicalBounds()))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
-    {
-      const auto& face = m_brush.face(i);
-      if (const auto distance = face.intersectWithRay(ray))
-      {
-        return std::tuple{*distance, i};
-      }
-    }
+    return m_facePlanes.intersect(ray);
   }
   return std::nullopt;
 }
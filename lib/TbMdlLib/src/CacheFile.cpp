@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/CacheFile.h"
+
+#include "fs/DiskIO.h"
+
+#include "kd/result.h"
+
+namespace tb::mdl
+{
+
+Result<void> writeCacheFile(
+  const std::filesystem::path& path, const std::function<void(std::ostream&)>& write)
+{
+  const auto cacheFolderPath = path.parent_path();
+  return fs::Disk::createDirectory(cacheFolderPath)
+         | kdl::and_then(
+           [&](auto) { return fs::Disk::makeUniqueFilename(cacheFolderPath); })
+         | kdl::and_then([&](const auto& filename) {
+             const auto tempPath = cacheFolderPath / filename;
+             return fs::Disk::withOutputStream(
+                      tempPath, std::ios::out | std::ios::binary, write)
+                    | kdl::and_then([&]() { return fs::Disk::moveFile(tempPath, path); })
+                    | kdl::or_else([&](auto e) {
+                        fs::Disk::deleteFile(tempPath) | kdl::ignore();
+                        return Result<void>{std::move(e)};
+                      });
+           });
+}
+
+} // namespace tb::mdl
@@ -29,6 +29,8 @@
 #include "kd/vector_utils.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <limits>
 
 namespace tb::mdl
 {
@@ -77,6 +79,16 @@ public:
       m_commands, [](const auto& command) { return command->isModification(); });
   }
 
+  size_t memoryUsage() const override
+  {
+    auto result = m_commands.capacity() * sizeof(std::unique_ptr<UndoableCommand>);
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
+
 private:
   bool doPerformDo(Map& map) override
   {
@@ -172,6 +184,9 @@ CommandProcessor::CommandProcessor(
   : m_map{map}
   , m_isCollationEnabled{true}
   , m_collationInterval{collationInterval}
+  , m_undoMemoryLimit{std::numeric_limits<size_t>::max()}
+  , m_undoStackMemoryUsage{0}
+  , m_redoStackMemoryUsage{0}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -208,6 +223,22 @@ const std::string* CommandProcessor::redoCommandName() const
   return canRedo() ? &m_redoStack.back()->name() : nullptr;
 }
 
+size_t CommandProcessor::undoMemoryLimit() const
+{
+  return m_undoMemoryLimit;
+}
+
+void CommandProcessor::setUndoMemoryLimit(const size_t undoMemoryLimit)
+{
+  m_undoMemoryLimit = undoMemoryLimit;
+  enforceUndoMemoryLimit();
+}
+
+size_t CommandProcessor::undoMemoryUsage() const
+{
+  return m_undoStackMemoryUsage + m_redoStackMemoryUsage;
+}
+
 void CommandProcessor::startTransaction(std::string name, const TransactionScope scope)
 {
   m_transactionStack.emplace_back(std::move(name), scope);
@@ -264,7 +295,8 @@ bool CommandProcessor::execute(std::unique_ptr<Command> command)
   if (result)
   {
     m_undoStack.clear();
-    m_redoStack.clear();
+    m_undoStackMemoryUsage = 0;
+    clearRedoStack();
   }
   return result;
 }
@@ -312,7 +344,8 @@ void CommandProcessor::clear()
   contract_pre(m_transactionStack.empty());
 
   m_undoStack.clear();
-  m_redoStack.clear();
+  m_undoStackMemoryUsage = 0;
+  clearRedoStack();
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
 
@@ -325,8 +358,10 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
     return {false, false};
   }
 
+  // clear the redo stack first so that its commands don't count against the undo memory
+  // limit when the command is stored
+  clearRedoStack();
   const auto commandStored = storeCommand(std::move(command), collate);
-  m_redoStack.clear();
   return {true, commandStored};
 }
 
@@ -447,13 +482,19 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
+    const auto lastCommandMemoryUsage = lastCommand->memoryUsage();
     if (lastCommand->collateWith(*command))
     {
+      m_undoStackMemoryUsage += lastCommand->memoryUsage();
+      m_undoStackMemoryUsage -= lastCommandMemoryUsage;
+      enforceUndoMemoryLimit();
       return false;
     }
   }
 
+  m_undoStackMemoryUsage += command->memoryUsage();
   m_undoStack.push_back(std::move(command));
+  enforceUndoMemoryLimit();
   return true;
 }
 
@@ -462,7 +503,9 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   contract_pre(m_transactionStack.empty());
   contract_pre(!m_undoStack.empty());
 
-  return kdl::vec_pop_back(m_undoStack);
+  auto command = kdl::vec_pop_back(m_undoStack);
+  m_undoStackMemoryUsage -= command->memoryUsage();
+  return command;
 }
 
 bool CommandProcessor::collatable(
@@ -472,10 +515,29 @@ bool CommandProcessor::collatable(
          && timestamp - m_lastCommandTimestamp <= m_collationInterval;
 }
 
+void CommandProcessor::enforceUndoMemoryLimit()
+{
+  auto memoryUsage = undoMemoryUsage();
+  auto count = size_t(0);
+  while (memoryUsage > m_undoMemoryLimit && count + 1 < m_undoStack.size())
+  {
+    memoryUsage -= m_undoStack[count]->memoryUsage();
+    ++count;
+  }
+
+  if (count > 0)
+  {
+    m_undoStack.erase(
+      m_undoStack.begin(), m_undoStack.begin() + static_cast<std::ptrdiff_t>(count));
+    m_undoStackMemoryUsage = memoryUsage - m_redoStackMemoryUsage;
+  }
+}
+
 void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   contract_pre(m_transactionStack.empty());
 
+  m_redoStackMemoryUsage += command->memoryUsage();
   m_redoStack.push_back(std::move(command));
 }
 
@@ -484,7 +546,15 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
   contract_pre(m_transactionStack.empty());
   contract_pre(!m_redoStack.empty());
 
-  return kdl::vec_pop_back(m_redoStack);
+  auto command = kdl::vec_pop_back(m_redoStack);
+  m_redoStackMemoryUsage -= command->memoryUsage();
+  return command;
+}
+
+void CommandProcessor::clearRedoStack()
+{
+  m_redoStack.clear();
+  m_redoStackMemoryUsage = 0;
 }
 
 } // namespace tb::mdl
@@ -35,6 +35,7 @@
 #include "mdl/MaterialUtils.h"
 #include "mdl/Palette.h"
 #include "mdl/Quake3Shader.h"
+#include "mdl/TextureCache.h"
 
 #include "kd/contracts.h"
 #include "kd/functional.h"
@@ -47,14 +48,17 @@
 #include "kd/result_fold.h"
 #include "kd/string_compare.h"
 #include "kd/string_format.h"
+#include "kd/task_manager.h"
 #include "kd/vector_utils.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
 #include <algorithm>
+#include <mutex>
 #include <ranges>
 #include <string>
+#include <unordered_map>
 
 namespace tb::mdl
 {
@@ -189,21 +193,36 @@ Result<std::filesystem::path> findShaderTexture(
          | kdl::transform_error([&](auto) { return DefaultTexturePath; });
 }
 
+Result<gl::Texture> loadShaderTexture(
+  const std::filesystem::path& path,
+  const fs::FileSystem& fs,
+  const TextureCache* textureCache)
+{
+  if (textureCache)
+  {
+    return textureCache->loadImageTexture(fs, path);
+  }
+
+  return fs.openFile(path) | kdl::and_then([&](auto file) {
+           auto reader = file->reader().buffer();
+           return loadImageTexture(reader);
+         });
+}
+
 Result<gl::Material> loadShaderMaterial(
   const Quake3Shader& shader,
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
-  const gl::CreateTextureResource& createResource)
+  const gl::CreateTextureResource& createResource,
+  const TextureCache* textureCache)
 {
   return findShaderTexture(shader, fs, materialConfig) | kdl::transform([&](auto path_) {
-           return [&, path = std::move(path_)]() {
-             return fs.openFile(path) | kdl::and_then([&](auto file) {
-                      auto reader = file->reader().buffer();
-                      return loadImageTexture(reader).transform([](auto texture) {
+           return [&, textureCache, path = std::move(path_)]() {
+             return loadShaderTexture(path, fs, textureCache)
+                    | kdl::transform([](auto texture) {
                         texture.setMask(gl::TextureMask::Off);
                         return texture;
                       });
-                    });
            };
          })
          | kdl::transform([&](auto textureLoader) {
@@ -255,11 +274,12 @@ Result<gl::Texture> findAndLoadTexture(
   const std::string& name,
   const std::vector<std::filesystem::path>& extensions,
   const fs::FileSystem& fs,
-  const std::optional<Palette>& palette)
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache)
 {
   return findMaterialFile(fs, path, extensions)
     .and_then([&](const auto& actualPath) -> Result<gl::Texture> {
-      return loadTexture(actualPath, name, fs, palette);
+      return loadTexture(actualPath, name, fs, palette, textureCache);
     });
 }
 
@@ -268,10 +288,11 @@ gl::ResourceLoader<gl::Texture> makeTextureResourceLoader(
   const std::string& name,
   const std::vector<std::filesystem::path>& extensions,
   const fs::FileSystem& fs,
-  const std::optional<Palette>& palette)
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache)
 {
-  return [&, path, name, palette]() -> Result<gl::Texture> {
-    return findAndLoadTexture(path, name, extensions, fs, palette)
+  return [&, path, name, palette, textureCache]() -> Result<gl::Texture> {
+    return findAndLoadTexture(path, name, extensions, fs, palette, textureCache)
            | kdl::or_else([&](auto e) -> Result<gl::Texture> {
                return Error{fmt::format("Could not load texture '{}': {}", path, e.msg)};
              });
@@ -283,7 +304,8 @@ Result<gl::Material> loadTextureMaterial(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
   const gl::CreateTextureResource& createResource,
-  const std::optional<Palette>& palette)
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache)
 {
   const auto prefixLength = kdl::path_length(materialConfig.root);
   const auto pathMatcher = !materialConfig.extensions.empty()
@@ -291,8 +313,8 @@ Result<gl::Material> loadTextureMaterial(
                              : fs::matchAnyPath;
   auto name = getMaterialNameFromPathSuffix(texturePath, prefixLength);
 
-  auto textureLoader =
-    makeTextureResourceLoader(texturePath, name, materialConfig.extensions, fs, palette);
+  auto textureLoader = makeTextureResourceLoader(
+    texturePath, name, materialConfig.extensions, fs, palette, textureCache);
   auto textureResource = createResource(std::move(textureLoader));
   return gl::Material{std::move(name), std::move(textureResource)};
 }
@@ -360,25 +382,24 @@ std::vector<gl::MaterialCollection> groupMaterialsIntoCollections(
          | kdl::ranges::to<std::vector>();
 }
 
-} // namespace
-
-
-Result<gl::Material> loadMaterial(
+Result<gl::Material> loadMaterialForShader(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
   const std::filesystem::path& materialPath,
   const gl::CreateTextureResource& createResource,
-  const std::vector<Quake3Shader>& shaders,
-  const std::optional<Palette>& palette)
+  const Quake3Shader* shader,
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache)
 {
-  const auto materialPathStem = kdl::path_remove_extension(materialPath);
-  const auto iShader = std::ranges::find_if(
-    shaders, [&](const auto& shader) { return shader.shaderPath == materialPathStem; });
-
-  return (iShader != shaders.end()
-            ? loadShaderMaterial(*iShader, fs, materialConfig, createResource)
-            : loadTextureMaterial(
-                materialPath, fs, materialConfig, createResource, palette))
+  return (shader ? loadShaderMaterial(
+                     *shader, fs, materialConfig, createResource, textureCache)
+                 : loadTextureMaterial(
+                     materialPath,
+                     fs,
+                     materialConfig,
+                     createResource,
+                     palette,
+                     textureCache))
          | kdl::transform([&](auto material) {
              fs.makeAbsolute(materialPath)
                | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
@@ -390,12 +411,88 @@ Result<gl::Material> loadMaterial(
            });
 }
 
+/*
+ * Loads the materials for the given paths in parallel chunks. The materials are returned
+ * in the order of the given paths. Resource creation registers the resources with the
+ * resource manager, which is not thread safe, so it is serialized.
+ */
+Result<std::vector<gl::Material>> loadMaterials(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const std::vector<std::filesystem::path>& materialPaths,
+  const gl::CreateTextureResource& createResource,
+  const std::vector<Quake3Shader>& shaders,
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache,
+  kdl::task_manager& taskManager)
+{
+  static constexpr auto MinMaterialsPerTask = size_t(64);
+
+  using ShaderMap =
+    std::unordered_map<std::filesystem::path, const Quake3Shader*, kdl::path_hash>;
+
+  auto shadersByPath = ShaderMap{};
+  for (const auto& shader : shaders)
+  {
+    shadersByPath.emplace(shader.shaderPath, &shader);
+  }
+
+  auto createResourceMutex = std::mutex{};
+  const auto createResourceSerialized =
+    gl::CreateTextureResource{[&](auto resourceLoader) {
+      const auto lock = std::lock_guard{createResourceMutex};
+      return createResource(std::move(resourceLoader));
+    }};
+
+  return taskManager.parallel_transform(
+           materialPaths,
+           [&](const auto& materialPath) {
+             const auto iShader =
+               shadersByPath.find(kdl::path_remove_extension(materialPath));
+             return loadMaterialForShader(
+               fs,
+               materialConfig,
+               materialPath,
+               createResourceSerialized,
+               iShader != shadersByPath.end() ? iShader->second : nullptr,
+               palette,
+               textureCache);
+           },
+           MinMaterialsPerTask)
+         | kdl::fold;
+}
+
+} // namespace
+
+Result<gl::Material> loadMaterial(
+  const fs::FileSystem& fs,
+  const MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
+  const gl::CreateTextureResource& createResource,
+  const std::vector<Quake3Shader>& shaders,
+  const std::optional<Palette>& palette)
+{
+  const auto materialPathStem = kdl::path_remove_extension(materialPath);
+  const auto iShader = std::ranges::find_if(
+    shaders, [&](const auto& shader) { return shader.shaderPath == materialPathStem; });
+
+  return loadMaterialForShader(
+    fs,
+    materialConfig,
+    materialPath,
+    createResource,
+    iShader != shaders.end() ? &*iShader : nullptr,
+    palette,
+    nullptr);
+}
+
 Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
   const fs::FileSystem& fs,
   const MaterialConfig& materialConfig,
   const gl::CreateTextureResource& createResource,
   kdl::task_manager& taskManager,
-  Logger& logger)
+  Logger& logger,
+  const TextureCache* textureCache)
 {
   return loadShaders(fs, materialConfig, taskManager, logger)
          | kdl::transform([&](auto shaders) {
@@ -408,17 +505,15 @@ Result<std::vector<gl::MaterialCollection>> loadMaterialCollections(
          | kdl::and_then([&](auto shaders, auto palette) {
              return findAllMaterialPaths(fs, materialConfig, shaders)
                     | kdl::and_then([&](const auto& materialPaths) {
-                        return materialPaths
-                               | std::views::transform([&](const auto& materialPath) {
-                                   return loadMaterial(
-                                     fs,
-                                     materialConfig,
-                                     materialPath,
-                                     createResource,
-                                     shaders,
-                                     palette);
-                                 })
-                               | kdl::fold;
+                        return loadMaterials(
+                          fs,
+                          materialConfig,
+                          materialPaths,
+                          createResource,
+                          shaders,
+                          palette,
+                          textureCache,
+                          taskManager);
                       });
            })
          | kdl::transform([&](auto materials) {
@@ -77,11 +77,9 @@ Result<std::vector<Quake3Shader>> loadShaders(
            fs::TraversalMode::Flat,
            fs::makeExtensionPathMatcher({".shader"}))
          | kdl::and_then([&](auto paths) {
-             auto tasks =
-               paths | std::views::transform([&](const auto& path) {
-                 return std::function{[&]() { return loadShader(fs, path, logger); }};
-               });
-             return taskManager.run_tasks_and_wait(tasks) | kdl::fold;
+             return taskManager.parallel_transform(
+                      paths, [&](const auto& path) { return loadShader(fs, path, logger); })
+                    | kdl::fold;
            })
          | kdl::transform([&](auto nestedShaders) {
              return nestedShaders | std::views::join | kdl::ranges::to<std::vector>();
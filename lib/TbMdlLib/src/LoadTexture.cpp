@@ -30,6 +30,7 @@
 #include "mdl/LoadWalTexture.h"
 #include "mdl/MaterialUtils.h"
 #include "mdl/Palette.h"
+#include "mdl/TextureCache.h"
 
 #include "kd/path_utils.h"
 #include "kd/result.h"
@@ -46,7 +47,8 @@ Result<gl::Texture> loadTexture(
   const std::filesystem::path& path,
   const std::string& name,
   const fs::FileSystem& fs,
-  const std::optional<Palette>& palette)
+  const std::optional<Palette>& palette,
+  const TextureCache* textureCache)
 {
   const auto extension = kdl::path_to_lower(path.extension());
   if (extension == ".d")
@@ -100,6 +102,11 @@ Result<gl::Texture> loadTexture(
   }
   else if (isSupportedImageExtension(extension))
   {
+    if (textureCache)
+    {
+      return textureCache->loadImageTexture(fs, path);
+    }
+
     return fs.openFile(path) | kdl::and_then([&](auto file) {
              auto reader = file->reader().buffer();
              return loadImageTexture(reader);
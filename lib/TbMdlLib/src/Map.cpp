@@ -28,7 +28,9 @@
 #include "mdl/AssetUtils.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
+#include "mdl/BrushGeometryCache.h"
 #include "mdl/BrushNode.h"
+#include "mdl/CachedMapText.h"
 #include "mdl/Command.h"
 #include "mdl/CommandProcessor.h"
 #include "mdl/EditorContext.h"
@@ -89,6 +91,7 @@
 #include "mdl/SelectionChange.h"
 #include "mdl/SoftMapBoundsValidator.h"
 #include "mdl/TagManager.h"
+#include "mdl/TextureCache.h"
 #include "mdl/Transaction.h"
 #include "mdl/UndoableCommand.h"
 #include "mdl/UpdateLinkedGroupsCommand.h"
@@ -111,6 +114,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <future>
 #include <memory>
 #include <ranges>
 #include <string>
@@ -153,6 +157,51 @@ auto createGameFileSystem(
   return fs;
 }
 
+std::unique_ptr<TextureCache> createTextureCache(
+  const EnvironmentConfig& environmentConfig)
+{
+  return !environmentConfig.userDataFolderPath.empty()
+           ? std::make_unique<TextureCache>(
+               environmentConfig.userDataFolderPath / "TextureCache")
+           : nullptr;
+}
+
+std::optional<std::filesystem::path> getBrushGeometryCachePath(
+  const EnvironmentConfig& environmentConfig, const std::filesystem::path& mapPath)
+{
+  return !environmentConfig.userDataFolderPath.empty()
+           ? std::optional{makeBrushGeometryCachePath(
+               environmentConfig.userDataFolderPath / "BrushGeometryCache", mapPath)}
+           : std::nullopt;
+}
+
+/**
+ * Replaces the brush geometry cache file with the geometry of the brushes of the given
+ * world node. The geometry of the brushes that are also in the previous cache is reused,
+ * so only the geometry of the brushes that changed since is collected on the calling
+ * thread. The file is written in the background, and the returned future yields the
+ * cache for the next update once the file was written.
+ */
+std::future<BrushGeometryCache> updateBrushGeometryCache(
+  const WorldNode& worldNode,
+  const std::string_view gameName,
+  const vm::bbox3d& worldBounds,
+  const std::filesystem::path& cachePath,
+  std::future<BrushGeometryCache> previousCache,
+  kdl::task_manager& taskManager)
+{
+  const auto key = BrushGeometryCache::computeKey(gameName, worldBounds);
+  auto cache = previousCache.valid()
+                 ? BrushGeometryCache::create(key, worldNode, previousCache.get())
+                 : BrushGeometryCache::create(key, worldNode);
+
+  // a failure to write the cache only means that the next load clips all brushes
+  return taskManager.run_task([cache = std::move(cache), cachePath]() mutable {
+    writeBrushGeometryCache(cachePath, cache) | kdl::ignore();
+    return std::move(cache);
+  });
+}
+
 template <typename Resource>
 auto makeCreateResource(gl::ResourceManager& resourceManager)
 {
@@ -168,36 +217,61 @@ Result<std::unique_ptr<WorldNode>> loadWorldNode(
   const GameConfig& config,
   const vm::bbox3d& worldBounds,
   const std::filesystem::path& path,
+  const std::optional<std::filesystem::path>& brushGeometryCachePath,
   kdl::task_manager& taskManager,
   Logger& logger)
 {
   const auto entityPropertyConfig = EntityPropertyConfig{
     config.entityConfig.scaleExpression, config.entityConfig.setDefaultProperties};
 
+  // Try all formats listed in the game config if the format is unknown
+  const auto mapFormats =
+    mapFormat == MapFormat::Unknown
+      ? config.fileFormats | std::views::transform([](const auto& formatConfig) {
+          return formatFromName(formatConfig.format);
+        }) | kdl::ranges::to<std::vector>()
+      : std::vector<MapFormat>{mapFormat};
+
+  // a missing, stale or corrupt cache is silently ignored and replaced
+  auto brushGeometryCache = std::optional<BrushGeometryCache>{};
+  if (brushGeometryCachePath)
+  {
+    readBrushGeometryCache(
+      *brushGeometryCachePath, BrushGeometryCache::computeKey(config.name, worldBounds))
+      | kdl::transform([&](auto cache) { brushGeometryCache = std::move(cache); })
+      | kdl::ignore();
+  }
+  const auto* brushGeometryCachePtr =
+    brushGeometryCache ? &*brushGeometryCache : nullptr;
+
   auto parserStatus = SimpleParserStatus{logger};
-  return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
-           auto fileReader = file->reader().buffer();
-           if (mapFormat == MapFormat::Unknown)
-           {
-             // Try all formats listed in the game config
-             const auto possibleFormats =
-               config.fileFormats | std::views::transform([](const auto& formatConfig) {
-                 return formatFromName(formatConfig.format);
-               })
-               | kdl::ranges::to<std::vector>();
-
-             return WorldReader::tryRead(
-               fileReader.stringView(),
-               possibleFormats,
-               worldBounds,
-               entityPropertyConfig,
-               parserStatus,
-               taskManager);
-           }
-
-           auto worldReader =
-             WorldReader{fileReader.stringView(), mapFormat, entityPropertyConfig};
-           return worldReader.read(worldBounds, parserStatus, taskManager);
+  return fs::Disk::mapFile(path) | kdl::and_then([&](auto file) {
+           auto worldResult =
+             mapFormat == MapFormat::Unknown
+               ? WorldReader::tryRead(
+                   file->stringView(),
+                   mapFormats,
+                   worldBounds,
+                   entityPropertyConfig,
+                   parserStatus,
+                   taskManager,
+                   brushGeometryCachePtr)
+               : WorldReader{file->stringView(), mapFormat, entityPropertyConfig}.read(
+                   worldBounds, parserStatus, taskManager, brushGeometryCachePtr);
+
+           return std::move(worldResult) | kdl::transform([&](auto worldNode) {
+                    if (brushGeometryCachePath && !brushGeometryCache)
+                    {
+                      updateBrushGeometryCache(
+                        *worldNode,
+                        config.name,
+                        worldBounds,
+                        *brushGeometryCachePath,
+                        {},
+                        taskManager);
+                    }
+                    return worldNode;
+                  });
          });
 }
 
@@ -216,7 +290,13 @@ Result<std::unique_ptr<WorldNode>> createWorldNode(
       && fs::Disk::pathInfo(initialMapFilePath) == fs::PathInfo::File)
     {
       return loadWorldNode(
-        format, config, worldBounds, initialMapFilePath, taskManager, logger);
+        format,
+        config,
+        worldBounds,
+        initialMapFilePath,
+        std::nullopt,
+        taskManager,
+        logger);
     }
   }
 
@@ -259,6 +339,25 @@ Result<std::unique_ptr<WorldNode>> createWorldNode(
   return worldNode;
 }
 
+Result<void> writeWorld(
+  const WorldNode& worldNode,
+  const std::string& gameName,
+  const std::filesystem::path& path,
+  kdl::task_manager& taskManager)
+{
+  const auto generator =
+    fmt::format("TrenchBroom {} (Build {})", VERSION_STR, BUILD_ID_STR);
+
+  return fs::Disk::withOutputStream(path, [&](auto& stream) {
+    writeMapHeader(stream, gameName, worldNode.mapFormat(), generator);
+
+    auto writer = NodeWriter{worldNode, stream};
+    writer.setExporting(false);
+    writer.setMaxCachedMapTextSize(MaxCachedMapTextSize);
+    writer.writeMap(taskManager);
+  });
+}
+
 void setWorldDefaultProperties(
   WorldNode& worldNode,
   EntityDefinitionManager& entityDefinitionManager,
@@ -388,6 +487,83 @@ auto makeUnsetMaterialsVisitor()
     [](PatchNode& patchNode) { patchNode.setMaterial(nullptr); });
 }
 
+/**
+ * Removes all references to materials and entity definitions so that the nodes can be
+ * destroyed when the assets are gone. The surface data that a brush face inherits from
+ * its material is copied to the face so that the face is still written in the same way.
+ */
+auto makeDetachAssetsVisitor()
+{
+  return kdl::overload(
+    [](auto&& thisLambda, WorldNode& worldNode) {
+      worldNode.setDefinition(nullptr);
+      worldNode.visitChildren(thisLambda);
+    },
+    [](auto&& thisLambda, LayerNode& layerNode) { layerNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, GroupNode& groupNode) { groupNode.visitChildren(thisLambda); },
+    [](auto&& thisLambda, EntityNode& entityNode) {
+      entityNode.setDefinition(nullptr);
+      entityNode.visitChildren(thisLambda);
+    },
+    [](BrushNode& brushNode) {
+      // the brush is still written in the same way
+      auto cachedMapText = brushNode.cachedMapText();
+
+      const auto& brush = brushNode.brush();
+      for (size_t i = 0u; i < brush.faceCount(); ++i)
+      {
+        const auto& face = brush.face(i);
+        if (!face.surfaceAttributes().empty())
+        {
+          auto surfaceAttributes = face.surfaceAttributes();
+          surfaceAttributes.contents = face.resolvedSurfaceContents();
+          surfaceAttributes.flags = face.resolvedSurfaceFlags();
+          surfaceAttributes.value = face.resolvedSurfaceValue();
+          brushNode.setFaceSurfaceAttributes(i, surfaceAttributes);
+        }
+        brushNode.setFaceMaterial(i, nullptr);
+      }
+
+      brushNode.setCachedMapText(std::move(cachedMapText));
+    },
+    [](PatchNode& patchNode) { patchNode.setMaterial(nullptr); });
+}
+
+/**
+ * Copies the persistent IDs of the given node and its descendants to the corresponding
+ * nodes of the given clone. Cloning a node assigns new persistent IDs to its layers and
+ * groups, but a snapshot must be written with the same IDs as the original.
+ */
+void copyPersistentIds(const Node& node, Node& clone)
+{
+  node.accept(kdl::overload(
+    [](const WorldNode&) {},
+    [&](const LayerNode& layerNode) {
+      if (const auto& persistentId = layerNode.persistentId())
+      {
+        static_cast<LayerNode&>(clone).setPersistentId(*persistentId);
+      }
+    },
+    [&](const GroupNode& groupNode) {
+      if (const auto& persistentId = groupNode.persistentId())
+      {
+        static_cast<GroupNode&>(clone).setPersistentId(*persistentId);
+      }
+    },
+    [](const EntityNode&) {},
+    [](const BrushNode&) {},
+    [](const PatchNode&) {}));
+
+  const auto& children = node.children();
+  const auto& cloneChildren = clone.children();
+  contract_assert(children.size() == cloneChildren.size());
+
+  for (size_t i = 0u; i < children.size(); ++i)
+  {
+    copyPersistentIds(*children[i], *cloneChildren[i]);
+  }
+}
+
 auto makeSetEntityDefinitionsVisitor(EntityDefinitionManager& manager)
 {
   // this helper lambda must be captured by value
@@ -563,6 +739,7 @@ Map::Map(
       makeCreateResource<EntityModelDataResource>(m_resourceManager),
       logger)}
   , m_materialManager{std::make_unique<gl::MaterialManager>(logger)}
+  , m_textureCache{createTextureCache(m_environmentConfig)}
   , m_tagManager{std::make_unique<TagManager>()}
   , m_editorContext{std::make_unique<EditorContext>()}
   , m_grid{std::make_unique<Grid>(4)}
@@ -643,7 +820,13 @@ Result<std::unique_ptr<Map>> Map::loadMap(
   logger.info() << "Loading document from " << path;
 
   return loadWorldNode(
-           mapFormat, gameInfo.gameConfig, worldBounds, path, taskManager, logger)
+           mapFormat,
+           gameInfo.gameConfig,
+           worldBounds,
+           path,
+           getBrushGeometryCachePath(environmentConfig, path),
+           taskManager,
+           logger)
          | kdl::transform([&](auto worldNode) {
              return std::make_unique<Map>(
                environmentConfig,
@@ -828,6 +1011,28 @@ void Map::setGamePath(std::filesystem::path gamePath)
   }
 }
 
+void Map::setTextureCacheEnabled(const bool textureCacheEnabled)
+{
+  if (m_textureCache)
+  {
+    m_textureCache->setEnabled(textureCacheEnabled);
+  }
+}
+
+void Map::setTextureCacheMaxSize(const size_t textureCacheMaxSize)
+{
+  if (m_textureCache && textureCacheMaxSize != m_textureCacheMaxSize)
+  {
+    m_textureCacheMaxSize = textureCacheMaxSize;
+
+    // a failure to trim the cache only means that it uses more space than it should
+    m_taskManager.run_task(
+      [cacheFolderPath = m_textureCache->cacheFolderPath(), textureCacheMaxSize]() {
+        trimTextureCache(cacheFolderPath, textureCacheMaxSize) | kdl::ignore();
+      });
+  }
+}
+
 Result<std::unique_ptr<Map>> Map::reload()
 {
   if (!persistent())
@@ -870,21 +1075,39 @@ Result<void> Map::saveTo(const std::filesystem::path& path) const
 
   m_logger.info() << "Saving document to " << path;
 
-  const auto generator =
-    fmt::format("TrenchBroom {} (Build {})", VERSION_STR, BUILD_ID_STR);
+  writeWorld(*m_worldNode, gameInfo().gameConfig.name, path, m_taskManager)
+    | kdl::transform([&]() {
+        // the file was just written, so the cache must match its new contents
+        if (const auto cachePath = getBrushGeometryCachePath(environmentConfig(), path))
+        {
+          m_brushGeometryCache = updateBrushGeometryCache(
+            *m_worldNode,
+            gameInfo().gameConfig.name,
+            m_worldBounds,
+            *cachePath,
+            std::move(m_brushGeometryCache),
+            m_taskManager);
+        }
+      })
+    | kdl::transform_error([&](const auto& e) {
+        m_logger.error() << "Could not save document: " << e.msg;
+      });
 
-  fs::Disk::withOutputStream(path, [&](auto& stream) {
-    writeMapHeader(
-      stream, gameInfo().gameConfig.name, m_worldNode->mapFormat(), generator);
+  return Result<void>{};
+}
 
-    auto writer = NodeWriter{*m_worldNode, stream};
-    writer.setExporting(false);
-    writer.writeMap(m_taskManager);
-  }) | kdl::transform_error([&](const auto& e) {
-    m_logger.error() << "Could not save document: " << e.msg;
-  });
+std::function<Result<void>(const std::filesystem::path&)> Map::snapshotForSaving() const
+{
+  auto worldNode = std::shared_ptr<WorldNode>{
+    static_cast<WorldNode*>(m_worldNode->cloneRecursively(m_worldBounds))};
+  copyPersistentIds(*m_worldNode, *worldNode);
+  worldNode->accept(makeDetachAssetsVisitor());
 
-  return Result<void>{};
+  return [worldNode = std::move(worldNode),
+          gameName = gameInfo().gameConfig.name,
+          &taskManager = m_taskManager](const std::filesystem::path& path) {
+    return writeWorld(*worldNode, gameName, path, taskManager);
+  };
 }
 
 Result<void> Map::exportAs(const ExportOptions& options) const
@@ -1005,6 +1228,26 @@ const std::optional<vm::bbox3d>& Map::selectionBounds() const
   return m_cachedSelectionBounds;
 }
 
+void Map::updateSelection(const SelectionChange& selectionChange)
+{
+  m_selection.update(selectionChange);
+
+  // Selecting more nodes can only grow the selection bounds, so they are merged into the
+  // cached bounds. Deselecting nodes may shrink them, which requires a full recompute.
+  if (m_cachedSelectionBounds && selectionChange.deselectedNodes.empty())
+  {
+    if (!selectionChange.selectedNodes.empty())
+    {
+      m_cachedSelectionBounds = vm::merge(
+        *m_cachedSelectionBounds, computeLogicalBounds(selectionChange.selectedNodes));
+    }
+  }
+  else
+  {
+    m_cachedSelectionBounds = std::nullopt;
+  }
+}
+
 
 void Map::registerSmartTags()
 {
@@ -1255,7 +1498,8 @@ void Map::loadMaterials()
     gameInfo().gameConfig.materialConfig,
     makeCreateResource<gl::TextureResource>(m_resourceManager),
     taskManager(),
-    m_logger)
+    m_logger,
+    m_textureCache.get())
     | kdl::transform([&](auto materialCollections) {
         m_materialManager->setMaterialCollections(std::move(materialCollections));
       })
@@ -1678,8 +1922,7 @@ void Map::nodesWereAdded(const std::vector<Node*>& nodes)
   addToNodeIndex(nodes, true);
   addEntityLinks(nodes, true);
 
-  m_selection.update(computeSelectionChangeForAddedNodes(nodes));
-  m_cachedSelectionBounds = std::nullopt;
+  updateSelection(computeSelectionChangeForAddedNodes(nodes));
 }
 
 void Map::nodesWillBeRemoved(const std::vector<Node*>& nodes)
@@ -1695,8 +1938,7 @@ void Map::nodesWereRemoved(const std::vector<Node*>& nodes)
   unsetEntityDefinitions(nodes);
   unsetMaterials(nodes);
 
-  m_selection.update(computeSelectionChangeForRemovedNodes(nodes));
-  m_cachedSelectionBounds = std::nullopt;
+  updateSelection(computeSelectionChangeForRemovedNodes(nodes));
 }
 
 void Map::nodesWillChange(const std::vector<Node*>& nodes)
@@ -1739,8 +1981,7 @@ void Map::selectionWillChange()
 void Map::selectionDidChange(const SelectionChange& selectionChange)
 {
   m_repeatStack->clearOnNextPush();
-  m_selection.update(selectionChange);
-  m_cachedSelectionBounds = std::nullopt;
+  updateSelection(selectionChange);
 }
 
 void Map::materialCollectionsWillChange()
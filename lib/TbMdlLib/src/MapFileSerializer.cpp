@@ -23,6 +23,7 @@
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
+#include "mdl/CachedMapText.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityProperties.h"
 #include "mdl/GroupNode.h"
@@ -32,13 +33,17 @@
 
 #include "kd/contracts.h"
 #include "kd/overload.h"
+#include "kd/ranges/to.h"
 #include "kd/string_format.h"
 #include "kd/task_manager.h"
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <ranges>
 #include <sstream>
 #include <utility>
 #include <variant>
@@ -46,6 +51,16 @@
 
 namespace tb::mdl
 {
+namespace
+{
+
+// the number of nodes that are rendered to strings by a single task
+constexpr auto PrecomputedChunkSize = size_t(32);
+
+// the number of chunks per thread that are rendered ahead of the writer
+constexpr auto PrecomputedChunksPerThread = size_t(4);
+
+} // namespace
 
 class QuakeFileSerializer : public MapFileSerializer
 {
@@ -270,7 +285,10 @@ private:
   }
 };
 
-std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+namespace
+{
+
+std::unique_ptr<MapFileSerializer> createMapFileSerializer(
   const MapFormat format, std::ostream& stream)
 {
   switch (format)
@@ -297,20 +315,70 @@ std::unique_ptr<NodeSerializer> MapFileSerializer::create(
   }
 }
 
+} // namespace
+
+std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+  const MapFormat format, std::ostream& stream)
+{
+  auto serializer = createMapFileSerializer(format, stream);
+  serializer->m_format = format;
+  return serializer;
+}
+
 MapFileSerializer::MapFileSerializer(std::ostream& stream)
   : m_line{1}
   , m_stream{stream}
 {
 }
 
+MapFileSerializer::~MapFileSerializer()
+{
+  // the pending tasks refer to this serializer
+  discardPrecomputedStrings();
+}
+
 void MapFileSerializer::doBeginFile(
   const std::vector<const Node*>& rootNodes, kdl::task_manager& taskManager)
 {
-  contract_pre(m_nodeToPrecomputedString.empty());
-
-  // collect nodes
-  auto nodesToSerialize = std::vector<std::variant<const BrushNode*, const PatchNode*>>{};
-  nodesToSerialize.reserve(rootNodes.size());
+  contract_pre(m_precomputedChunks.empty());
+
+  m_taskManager = &taskManager;
+  m_nodesToSerialize.clear();
+  m_nodeIndices.clear();
+  m_nextNodeToPrecompute = 0;
+  m_cachedMapTextSize = 0;
+
+  const auto addNode = [&](const auto* node) {
+    // every node is rendered at most once so that its cached string can be updated
+    // while the other nodes are rendered
+    if (m_nodeIndices.emplace(node, m_nodesToSerialize.size()).second)
+    {
+      m_nodesToSerialize.emplace_back(node);
+    }
+  };
+
+  const auto addChildren = [&](const Node& parentNode) {
+    parentNode.visitChildren(kdl::overload(
+      [](const WorldNode&) {},
+      [](const LayerNode&) {},
+      [](const GroupNode&) {},
+      [](const EntityNode&) {},
+      [&](const BrushNode& brushNode) { addNode(&brushNode); },
+      [&](const PatchNode& patchNode) { addNode(&patchNode); }));
+  };
+
+  // Collect the nodes in the order in which they are usually written: The brushes and
+  // patches of an entity are written before any nested entities. If a node is written out
+  // of this order, it is rendered on demand.
+  Node::visitAll(
+    rootNodes,
+    kdl::overload(
+      [](const WorldNode&) {},
+      [](const LayerNode&) {},
+      [](const GroupNode&) {},
+      [](const EntityNode&) {},
+      [&](const BrushNode& brushNode) { addNode(&brushNode); },
+      [&](const PatchNode& patchNode) { addNode(&patchNode); }));
 
   Node::visitAll(
     rootNodes,
@@ -318,42 +386,28 @@ void MapFileSerializer::doBeginFile(
       [](auto&& thisLambda, const WorldNode& worldNode) {
         worldNode.visitChildren(thisLambda);
       },
-      [](auto&& thisLambda, const LayerNode& layerNode) {
+      [&](auto&& thisLambda, const LayerNode& layerNode) {
+        addChildren(layerNode);
         layerNode.visitChildren(thisLambda);
       },
-      [](auto&& thisLambda, const GroupNode& groupNode) {
+      [&](auto&& thisLambda, const GroupNode& groupNode) {
+        addChildren(groupNode);
         groupNode.visitChildren(thisLambda);
       },
-      [](auto&& thisLambda, const EntityNode& entityNode) {
-        entityNode.visitChildren(thisLambda);
-      },
-      [&](const BrushNode& brushNode) { nodesToSerialize.emplace_back(&brushNode); },
-      [&](const PatchNode& patchNode) { nodesToSerialize.emplace_back(&patchNode); }));
-
-  // serialize brushes to strings in parallel
-  using Entry = std::pair<const Node*, PrecomputedString>;
-  auto tasks = nodesToSerialize | std::views::transform([&](const auto& node) {
-                 return std::function{[&]() {
-                   return std::visit(
-                     kdl::overload(
-                       [&](const BrushNode* brushNode) {
-                         return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-                       },
-                       [&](const PatchNode* patchNode) {
-                         return Entry{patchNode, writePatch(patchNode->patch())};
-                       }),
-                     node);
-                 }};
-               });
-
-  // render strings and move them into a map
-  for (auto& entry : taskManager.run_tasks_and_wait(std::move(tasks)))
-  {
-    m_nodeToPrecomputedString.insert(std::move(entry));
-  }
+      [&](const EntityNode& entityNode) { addChildren(entityNode); },
+      [](const BrushNode&) {},
+      [](const PatchNode&) {}));
+
+  // start rendering the first nodes while the writer is busy with the first entity
+  precomputeStrings();
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  discardPrecomputedStrings();
+  m_nodesToSerialize.clear();
+  m_nodeIndices.clear();
+}
 
 void MapFileSerializer::doBeginEntity(const Node& /* node */)
 {
@@ -389,13 +443,11 @@ void MapFileSerializer::doBrush(const BrushNode& brushNode)
   fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "{{\n");
   ++m_line;
 
-  // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(&brushNode);
-  contract_assert(it != std::end(m_nodeToPrecomputedString));
-
-  const auto& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  // write pre-serialized brush faces and keep them until the brush changes if possible
+  auto precomputedString = takePrecomputedString(&brushNode);
+  m_stream << precomputedString->text;
+  m_line += precomputedString->lineCount;
+  keepCachedMapText(brushNode, std::move(precomputedString));
 
   fmt::format_to(std::ostreambuf_iterator<char>{m_stream}, "}}\n");
   ++m_line;
@@ -416,13 +468,11 @@ void MapFileSerializer::doPatch(const PatchNode& patchNode)
   ++m_line;
   m_startLineStack.push_back(m_line);
 
-  // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(&patchNode);
-  contract_assert(it != std::end(m_nodeToPrecomputedString));
-
-  const auto& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  // write pre-serialized patch and keep it until the patch changes if possible
+  auto precomputedString = takePrecomputedString(&patchNode);
+  m_stream << precomputedString->text;
+  m_line += precomputedString->lineCount;
+  keepCachedMapText(patchNode, std::move(precomputedString));
 
   setFilePosition(patchNode);
 }
@@ -433,6 +483,24 @@ void MapFileSerializer::setFilePosition(const Node& node)
   node.setFilePosition(start, m_line - start);
 }
 
+void MapFileSerializer::keepCachedMapText(
+  const Node& node, PrecomputedString cachedMapText)
+{
+  if (const auto& maxSize = maxCachedMapTextSize())
+  {
+    const auto size = cachedMapText->text.size();
+    if (m_cachedMapTextSize + size <= *maxSize)
+    {
+      m_cachedMapTextSize += size;
+      node.setCachedMapText(std::move(cachedMapText));
+    }
+    else
+    {
+      node.setCachedMapText(nullptr);
+    }
+  }
+}
+
 size_t MapFileSerializer::startLine()
 {
   contract_pre(!m_startLineStack.empty());
@@ -442,22 +510,147 @@ size_t MapFileSerializer::startLine()
   return result;
 }
 
+MapFileSerializer::PrecomputedString MapFileSerializer::takePrecomputedString(
+  const NodeToSerialize& node)
+{
+  const auto it = m_nodeIndices.find(
+    std::visit([](const auto* n) -> const Node* { return n; }, node));
+  if (it == m_nodeIndices.end())
+  {
+    return writeNode(node);
+  }
+
+  const auto index = it->second;
+
+  // discard the chunks of nodes that were skipped by the writer
+  while (!m_precomputedChunks.empty() && m_precomputedChunks.front().end <= index)
+  {
+    if (auto& future = m_precomputedChunks.front().future; future.valid())
+    {
+      m_taskManager->wait(future);
+    }
+    m_precomputedChunks.pop_front();
+  }
+
+  if (m_precomputedChunks.empty() && index >= m_nextNodeToPrecompute)
+  {
+    // the writer has skipped the entire window, restart it at the given node
+    m_nextNodeToPrecompute = index;
+    precomputeStrings();
+  }
+
+  if (m_precomputedChunks.empty() || m_precomputedChunks.front().begin > index)
+  {
+    // the node's chunk was already discarded
+    return writeNode(node);
+  }
+
+  auto& chunk = m_precomputedChunks.front();
+  if (chunk.future.valid())
+  {
+    // help running the tasks so that the writer may itself run as a task
+    m_taskManager->wait(chunk.future);
+    chunk.strings = chunk.future.get();
+  }
+
+  auto& precomputedString = chunk.strings[index - chunk.begin];
+  if (!precomputedString)
+  {
+    // the node is written a second time
+    return writeNode(node);
+  }
+
+  auto result = std::exchange(precomputedString, nullptr);
+
+  if (index + 1 == chunk.end)
+  {
+    m_precomputedChunks.pop_front();
+    precomputeStrings();
+  }
+
+  return result;
+}
+
+void MapFileSerializer::precomputeStrings()
+{
+  const auto maxChunkCount =
+    PrecomputedChunksPerThread * std::max(m_taskManager->concurrency(), size_t(1));
+
+  while (m_precomputedChunks.size() < maxChunkCount
+         && m_nextNodeToPrecompute < m_nodesToSerialize.size())
+  {
+    const auto begin = m_nextNodeToPrecompute;
+    const auto end = std::min(begin + PrecomputedChunkSize, m_nodesToSerialize.size());
+
+    m_precomputedChunks.push_back(PrecomputedChunk{
+      begin,
+      end,
+      m_taskManager->run_task([this, begin, end]() {
+        return std::views::iota(begin, end) | std::views::transform([&](const auto i) {
+                 return writeNode(m_nodesToSerialize[i]);
+               })
+               | kdl::ranges::to<std::vector>();
+      }),
+      {},
+    });
+
+    m_nextNodeToPrecompute = end;
+  }
+}
+
+void MapFileSerializer::discardPrecomputedStrings()
+{
+  for (auto& chunk : m_precomputedChunks)
+  {
+    if (chunk.future.valid())
+    {
+      m_taskManager->wait(chunk.future);
+    }
+  }
+  m_precomputedChunks.clear();
+}
+
+/**
+ * Threadsafe
+ */
+MapFileSerializer::PrecomputedString MapFileSerializer::writeNode(
+  const NodeToSerialize& node) const
+{
+  return std::visit(
+    kdl::overload(
+      [&](const BrushNode* brushNode) -> PrecomputedString {
+        if (const auto& cachedMapText = brushNode->cachedMapText();
+            cachedMapText && cachedMapText->format == m_format)
+        {
+          return cachedMapText;
+        }
+        return std::make_shared<CachedMapText>(writeBrushFaces(brushNode->brush()));
+      },
+      [&](const PatchNode* patchNode) -> PrecomputedString {
+        if (const auto& cachedMapText = patchNode->cachedMapText();
+            cachedMapText && cachedMapText->format == m_format)
+        {
+          return cachedMapText;
+        }
+        return std::make_shared<CachedMapText>(writePatch(patchNode->patch()));
+      }),
+    node);
+}
+
 /**
  * Threadsafe
  */
-MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
-  const Brush& brush) const
+CachedMapText MapFileSerializer::writeBrushFaces(const Brush& brush) const
 {
   auto stream = std::stringstream{};
   for (const auto& face : brush.faces())
   {
     doWriteBrushFace(stream, face);
   }
-  return {stream.str(), brush.faces().size()};
+  return {m_format, stream.str(), brush.faces().size()};
 }
 
-MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
-  const BezierPatch& patch) const
+CachedMapText MapFileSerializer::writePatch(const BezierPatch& patch) const
 {
   size_t lineCount = 0u;
   auto stream = std::stringstream{};
@@ -505,7 +698,7 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
   fmt::format_to(std::ostreambuf_iterator<char>{stream}, "}}\n");
   ++lineCount;
 
-  return {stream.str(), lineCount};
+  return {m_format, stream.str(), lineCount};
 }
 
 } // namespace tb::mdl
@@ -19,11 +19,13 @@
 
 #include "mdl/MapReader.h"
 
+#include "base/BufferedParserStatus.h"
 #include "base/Error.h" // IWYU pragma: keep
 #include "base/FileLocation.h"
 #include "base/ParserStatus.h"
 #include "base/Uuid.h"
 #include "mdl/BrushFace.h"
+#include "mdl/BrushGeometryCache.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
@@ -47,8 +49,10 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <optional>
 #include <ostream>
+#include <ranges>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -68,26 +72,263 @@ auto getFilePosition(const T& info)
   return std::tuple{startLine, lineCount};
 }
 
+/** Inputs are not split into chunks that are smaller than this. */
+constexpr auto MinEntityChunkSize = size_t(256 * 1024);
+
+/** A part of the input that is expected to contain only whole entities. */
+struct EntityChunk
+{
+  std::string_view str;
+  FileLocation startLocation;
+};
+
+/**
+ * Returns whether the given line contains nothing but the given character, surrounded by
+ * optional spaces and tabs.
+ */
+bool isSingleCharLine(const std::string_view line, const char c)
+{
+  const auto first = line.find_first_not_of(" \t");
+  return first != std::string_view::npos && line[first] == c
+         && line.find_first_not_of(" \t", first + 1) == std::string_view::npos;
+}
+
+/**
+ * Calls the given function for every line that contains only an opening brace, passing
+ * the offset and the number of the line and the brace depth before the line. The brace
+ * depth is tracked using the lines that contain only a brace. This matches how entities
+ * and brushes are written by TrenchBroom and other editors. Stops if the function returns
+ * false.
+ */
+template <typename F>
+void visitOpeningBraceLines(const std::string_view str, const F& f)
+{
+  auto depth = size_t(0);
+
+  auto lineBegin = size_t(0);
+  auto line = size_t(1);
+  while (lineBegin < str.size())
+  {
+    const auto lineEnd = std::min(str.find_first_of("\n\r", lineBegin), str.size());
+    const auto lineStr = str.substr(lineBegin, lineEnd - lineBegin);
+
+    if (isSingleCharLine(lineStr, '{'))
+    {
+      if (!f(lineBegin, line, depth))
+      {
+        return;
+      }
+      ++depth;
+    }
+    else if (depth > 0 && isSingleCharLine(lineStr, '}'))
+    {
+      --depth;
+    }
+
+    // count line breaks like the tokenizer does, where CRLF and a single CR are one line
+    // break each
+    lineBegin = lineEnd;
+    if (lineBegin < str.size())
+    {
+      if (
+        str[lineBegin] == '\r' && lineBegin + 1 < str.size()
+        && str[lineBegin + 1] == '\n')
+      {
+        ++lineBegin;
+      }
+      ++lineBegin;
+      ++line;
+    }
+  }
+}
+
+/**
+ * Splits the given string into chunks of at least the given size. A chunk starts at a
+ * line that contains only an opening brace at brace depth 0.
+ *
+ * This is a heuristic. If a chunk does not start at an entity boundary, then the chunk or
+ * its predecessor cannot be parsed on its own.
+ */
+std::vector<EntityChunk> findEntityChunks(
+  const std::string_view str, const size_t minChunkSize)
+{
+  auto chunks = std::vector<EntityChunk>{};
+
+  auto chunkBegin = size_t(0);
+  auto chunkLine = size_t(1);
+  visitOpeningBraceLines(
+    str, [&](const size_t lineBegin, const size_t line, const size_t depth) {
+      if (depth == 0 && lineBegin - chunkBegin >= minChunkSize)
+      {
+        chunks.push_back(EntityChunk{
+          str.substr(chunkBegin, lineBegin - chunkBegin), FileLocation{chunkLine, 1}});
+        chunkBegin = lineBegin;
+        chunkLine = line;
+      }
+      return true;
+    });
+
+  chunks.push_back(EntityChunk{str.substr(chunkBegin), FileLocation{chunkLine, 1}});
+  return chunks;
+}
+
+/** The approximate size of the prefix of the input that is parsed to sniff its format. */
+constexpr auto FormatSniffingPrefixSize = size_t(64 * 1024);
+
+/**
+ * Returns a prefix of the given string of at least the given size that contains only
+ * whole entities, or std::nullopt if the string is not larger than that. The prefix ends
+ * before an entity or before a brush or patch of the first entity that crosses the given
+ * size. In the latter case, a closing brace is appended to end the entity.
+ */
+std::optional<std::string> findFormatSniffingPrefix(
+  const std::string_view str, const size_t minPrefixSize)
+{
+  auto result = std::optional<std::string>{};
+  visitOpeningBraceLines(str, [&](const size_t lineBegin, size_t, const size_t depth) {
+    if (depth < 2 && lineBegin >= minPrefixSize)
+    {
+      result = std::string{str.substr(0, lineBegin)};
+      if (depth == 1)
+      {
+        *result += "}\n";
+      }
+      return false;
+    }
+    return true;
+  });
+  return result;
+}
+
 } // namespace
 
+/**
+ * Parses a chunk of the input of another reader and records the object infos without
+ * creating any nodes.
+ */
+class MapReader::EntityChunkReader : public MapReader
+{
+public:
+  EntityChunkReader(
+    const EntityChunk& chunk,
+    const MapFormat sourceMapFormat,
+    const MapFormat targetMapFormat,
+    EntityPropertyConfig entityPropertyConfig)
+    : MapReader{
+        chunk.str,
+        chunk.startLocation,
+        sourceMapFormat,
+        targetMapFormat,
+        std::move(entityPropertyConfig)}
+  {
+  }
+
+  EntityChunkReader(const EntityChunk& chunk, const MapReader& reader)
+    : EntityChunkReader{
+        chunk,
+        reader.m_sourceMapFormat,
+        reader.m_targetMapFormat,
+        reader.m_entityPropertyConfig}
+  {
+  }
+
+  Result<std::vector<ObjectInfo>> read(ParserStatus& status)
+  {
+    return parseEntities(status)
+           | kdl::transform([&]() { return std::move(m_objectInfos); });
+  }
+
+private:
+  Node* onWorldNode(std::unique_ptr<WorldNode>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+
+  void onLayerNode(std::unique_ptr<Node>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+
+  void onNode(Node*, std::unique_ptr<Node>, ParserStatus&) override
+  {
+    contract_assert(false);
+  }
+};
+
+MapReader::MapReader(
+  const std::string_view str,
+  const MapFormat sourceMapFormat,
+  const MapFormat targetMapFormat,
+  EntityPropertyConfig entityPropertyConfig)
+  : MapReader{
+      str,
+      FileLocation{1, 1},
+      sourceMapFormat,
+      targetMapFormat,
+      std::move(entityPropertyConfig)}
+{
+}
+
 MapReader::MapReader(
   const std::string_view str,
+  const FileLocation& startLocation,
   const MapFormat sourceMapFormat,
   const MapFormat targetMapFormat,
   EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  : StandardMapParser{str, startLocation, sourceMapFormat, targetMapFormat}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
 
+void MapReader::setBrushGeometryCache(const BrushGeometryCache* brushGeometryCache)
+{
+  m_brushGeometryCache = brushGeometryCache;
+}
+
 Result<void> MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
   m_worldBounds = worldBounds;
+
+  if (parseEntityChunks(status, taskManager))
+  {
+    createNodes(status, taskManager);
+    return kdl::void_success;
+  }
+
   return parseEntities(status)
          | kdl::transform([&]() { createNodes(status, taskManager); });
 }
 
+std::vector<MapFormat> MapReader::sniffFormats(
+  const std::string_view str,
+  const std::vector<MapFormat>& formats,
+  const EntityPropertyConfig& entityPropertyConfig)
+{
+  const auto prefix = findFormatSniffingPrefix(str, FormatSniffingPrefixSize);
+  if (!prefix)
+  {
+    return formats;
+  }
+
+  const auto canParsePrefix = [&](const MapFormat format) {
+    if (format == MapFormat::Unknown)
+    {
+      return false;
+    }
+
+    auto status = BufferedParserStatus{};
+    auto reader = EntityChunkReader{
+      EntityChunk{*prefix, FileLocation{1, 1}}, format, format, entityPropertyConfig};
+    return reader.read(status).is_success();
+  };
+
+  auto result = formats;
+  std::ranges::stable_partition(result, canParsePrefix);
+  return result;
+}
+
 Result<void> MapReader::readBrushes(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
@@ -218,6 +459,60 @@ void MapReader::onPatch(
 
 // helper methods
 
+bool MapReader::parseEntityChunks(ParserStatus& status, kdl::task_manager& taskManager)
+{
+  if (taskManager.concurrency() == 0)
+  {
+    return false;
+  }
+
+  // aim for several chunks per thread because entities vary a lot in size
+  const auto targetChunkCount = (taskManager.concurrency() + 1) * 4;
+  const auto chunks = findEntityChunks(
+    m_str, std::max(MinEntityChunkSize, m_str.size() / targetChunkCount));
+  if (chunks.size() < 2)
+  {
+    return false;
+  }
+
+  auto chunkStatuses = std::vector<BufferedParserStatus>(chunks.size());
+  auto chunkResults = taskManager.parallel_transform(
+    std::views::iota(size_t(0), chunks.size()), [&](const size_t i) {
+      auto reader = EntityChunkReader{chunks[i], *this};
+      return reader.read(chunkStatuses[i]);
+    });
+
+  if (!std::ranges::all_of(
+        chunkResults, [](const auto& chunkResult) { return chunkResult.is_success(); }))
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunkStatuses[i].flush(status);
+
+    // parent indices are relative to the chunk
+    const auto indexOffset = m_objectInfos.size();
+    for (auto& objectInfo : std::move(chunkResults[i]).value())
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](auto& info) {
+            if (info.parentIndex)
+            {
+              *info.parentIndex += indexOffset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+  }
+
+  return true;
+}
+
 namespace
 {
 /** The type of a node's container. */
@@ -605,10 +900,31 @@ CreateNodeResult createNodeFromEntityInfo(
  * Creates a brush node from the given brush info. Returns an error if the brush could not
  * be created.
  */
+Result<Brush> createBrush(
+  MapReader::BrushInfo& brushInfo,
+  const vm::bbox3d& worldBounds,
+  const BrushGeometryCache* brushGeometryCache)
+{
+  if (brushGeometryCache)
+  {
+    if (auto geometry = brushGeometryCache->geometry(brushInfo.faces))
+    {
+      if (auto brush = Brush::createFromGeometry(brushInfo.faces, std::move(*geometry)))
+      {
+        return brush;
+      }
+    }
+  }
+
+  return Brush::create(worldBounds, std::move(brushInfo.faces));
+}
+
 CreateNodeResult createBrushNode(
-  MapReader::BrushInfo brushInfo, const vm::bbox3d& worldBounds)
+  MapReader::BrushInfo brushInfo,
+  const vm::bbox3d& worldBounds,
+  const BrushGeometryCache* brushGeometryCache)
 {
-  return Brush::create(worldBounds, std::move(brushInfo.faces))
+  return createBrush(brushInfo, worldBounds, brushGeometryCache)
          | kdl::transform([&](auto brush) {
              auto brushNode = std::make_unique<BrushNode>(std::move(brush));
              const auto [startLine, lineCount] = getFilePosition(brushInfo);
@@ -656,32 +972,28 @@ std::vector<std::optional<NodeInfo>> createNodesFromObjectInfos(
   const EntityPropertyConfig& entityPropertyConfig,
   std::vector<MapReader::ObjectInfo> objectInfos,
   const vm::bbox3d& worldBounds,
+  const BrushGeometryCache* brushGeometryCache,
   const MapFormat mapFormat,
   ParserStatus& status,
   kdl::task_manager& taskManager)
 {
   // create nodes in parallel, moving data out of objectInfos
-  // we store optionals in the result vector to make the elements default constructible,
-  // which is a requirement for parallel transform
-  auto tasks = objectInfos | std::views::transform([&](auto& objectInfo) {
-                 return std::function{[&]() -> CreateNodeResult {
-                   return std::visit(
-                     kdl::overload(
-                       [&](MapReader::EntityInfo& entityInfo) {
-                         return createNodeFromEntityInfo(
-                           entityPropertyConfig, std::move(entityInfo), mapFormat);
-                       },
-                       [&](MapReader::BrushInfo& brushInfo) {
-                         return createBrushNode(std::move(brushInfo), worldBounds);
-                       },
-                       [&](MapReader::PatchInfo& patchInfo) {
-                         return createPatchNode(std::move(patchInfo));
-                       }),
-                     objectInfo);
-                 }};
-               });
-
-  auto results = taskManager.run_tasks_and_wait(std::move(tasks));
+  auto results = taskManager.parallel_transform(objectInfos, [&](auto& objectInfo) {
+    return std::visit(
+      kdl::overload(
+        [&](MapReader::EntityInfo& entityInfo) {
+          return createNodeFromEntityInfo(
+            entityPropertyConfig, std::move(entityInfo), mapFormat);
+        },
+        [&](MapReader::BrushInfo& brushInfo) {
+          return createBrushNode(std::move(brushInfo), worldBounds, brushGeometryCache);
+        },
+        [&](MapReader::PatchInfo& patchInfo) {
+          return createPatchNode(std::move(patchInfo));
+        }),
+      objectInfo);
+  });
+
   return results | std::views::transform([&](auto& createNodeResult) {
            return std::move(createNodeResult)
                   | kdl::transform([&](NodeInfo&& nodeInfo) -> std::optional<NodeInfo> {
@@ -949,6 +1261,7 @@ void MapReader::createNodes(ParserStatus& status, kdl::task_manager& taskManager
     m_entityPropertyConfig,
     std::move(m_objectInfos),
     m_worldBounds,
+    m_brushGeometryCache,
     m_targetMapFormat,
     status,
     taskManager);
@@ -125,43 +125,42 @@ bool transformSelection(
   const auto updateAngleProperty =
     map.worldNode().entityPropertyConfig().updateAnglePropertyAfterTransform;
 
-  auto tasks =
-    nodesToTransform | std::views::transform([&](auto& node) {
-      return std::function{[&]() {
-        return node->accept(kdl::overload(
-          [&](WorldNode&) -> TransformResult { contract_assert(false); },
-          [&](LayerNode&) -> TransformResult { contract_assert(false); },
-          [&](GroupNode& groupNode) -> TransformResult {
-            auto group = groupNode.group();
-            group.transform(transformation);
-            return std::make_pair(&groupNode, NodeContents{std::move(group)});
-          },
-          [&](EntityNode& entityNode) -> TransformResult {
-            auto entity = entityNode.entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(&entityNode, NodeContents{std::move(entity)});
-          },
-          [&](BrushNode& brushNode) -> TransformResult {
-            const auto* containingGroup = brushNode.containingGroup();
-            const bool lockAlignment =
+  auto transformResults =
+    map.taskManager().parallel_transform(nodesToTransform, [&](auto* node) {
+      return node->accept(kdl::overload(
+        [&](WorldNode&) -> TransformResult { contract_assert(false); },
+        [&](LayerNode&) -> TransformResult { contract_assert(false); },
+        [&](GroupNode& groupNode) -> TransformResult {
+          auto group = groupNode.group();
+          group.transform(transformation);
+          return std::make_pair(&groupNode, NodeContents{std::move(group)});
+        },
+        [&](EntityNode& entityNode) -> TransformResult {
+          auto entity = entityNode.entity();
+          entity.transform(transformation, updateAngleProperty);
+          return std::make_pair(&entityNode, NodeContents{std::move(entity)});
+        },
+        [&](BrushNode& brushNode) -> TransformResult {
+          const auto* containingGroup = brushNode.containingGroup();
+          const bool lockAlignment =
             alignmentLock
-            || (containingGroup && containingGroup->closed() && collectLinkedNodes({&map.worldNode()}, brushNode).size() > 1);
-
-            auto brush = brushNode.brush();
-            return brush.transform(map.worldBounds(), transformation, lockAlignment)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(&brushNode, NodeContents{std::move(brush)});
-                     });
-          },
-          [&](PatchNode& patchNode) -> TransformResult {
-            auto patch = patchNode.patch();
-            patch.transform(transformation);
-            return std::make_pair(&patchNode, NodeContents{std::move(patch)});
-          }));
-      }};
+            || (containingGroup && containingGroup->closed()
+                && collectLinkedNodes({&map.worldNode()}, brushNode).size() > 1);
+
+          auto brush = brushNode.brush();
+          return brush.transform(map.worldBounds(), transformation, lockAlignment)
+                 | kdl::and_then([&]() -> TransformResult {
+                     return std::make_pair(&brushNode, NodeContents{std::move(brush)});
+                   });
+        },
+        [&](PatchNode& patchNode) -> TransformResult {
+          auto patch = patchNode.patch();
+          patch.transform(transformation);
+          return std::make_pair(&patchNode, NodeContents{std::move(patch)});
+        }));
     });
 
-  const auto success = map.taskManager().run_tasks_and_wait(tasks) | kdl::fold
+  const auto success = std::move(transformResults) | kdl::fold
                        | kdl::transform([&](auto nodesToUpdate) {
                            return updateNodeContents(
                              map,
@@ -30,6 +30,16 @@ void pick(Map& map, const vm::ray3d& pickRay, PickResult& pickResult)
   map.worldNode().pick(map.editorContext(), pickRay, pickResult);
 }
 
+void pickNearest(
+  Map& map,
+  const vm::ray3d& pickRay,
+  const HitFilter& hitFilter,
+  const size_t count,
+  PickResult& pickResult)
+{
+  map.worldNode().pickNearest(map.editorContext(), pickRay, hitFilter, count, pickResult);
+}
+
 std::vector<Node*> findNodesContaining(Map& map, const vm::vec3d& point)
 {
   auto result = std::vector<Node*>{};
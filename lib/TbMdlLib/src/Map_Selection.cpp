@@ -91,7 +91,7 @@ void selectSiblingNodes(Map& map)
 
 void selectTouchingNodes(Map& map, const bool del)
 {
-  auto nodes = collectTouchingNodes({&map.worldNode()}, map.selection().brushes)
+  auto nodes = collectTouchingNodes(map.worldNode().nodeTree(), map.selection().brushes)
                | std::views::filter(
                  [&](const auto* node) { return map.editorContext().selectable(*node); })
                | kdl::ranges::to<std::vector>();
@@ -157,9 +157,9 @@ void selectTouchingNodes(Map& map, const vm::axis::type cameraAxis, const bool d
 
         const auto nodesToSelect =
           collectContainedNodes(
-            {&map.worldNode()}, tallBrushes | std::views::transform([](const auto& b) {
-                                  return b.get();
-                                }) | kdl::ranges::to<std::vector>())
+            map.worldNode().nodeTree(),
+            tallBrushes | std::views::transform([](const auto& b) { return b.get(); })
+              | kdl::ranges::to<std::vector>())
           | std::views::filter(
             [&](const auto* node) { return map.editorContext().selectable(*node); })
           | kdl::ranges::to<std::vector>();
@@ -174,7 +174,7 @@ void selectTouchingNodes(Map& map, const vm::axis::type cameraAxis, const bool d
 
 void selectContainedNodes(Map& map, const bool del)
 {
-  auto nodes = collectContainedNodes({&map.worldNode()}, map.selection().brushes)
+  auto nodes = collectContainedNodes(map.worldNode().nodeTree(), map.selection().brushes)
                | std::views::filter(
                  [&](const auto* node) { return map.editorContext().selectable(*node); })
                | kdl::ranges::to<std::vector>();
@@ -0,0 +1,177 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/MemoryUsage.h"
+
+#include "mdl/BezierPatch.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CachedMapText.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/Group.h"
+#include "mdl/GroupNode.h"
+#include "mdl/Layer.h"
+#include "mdl/LayerNode.h"
+#include "mdl/NodeContents.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/overload.h"
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+size_t heapMemoryUsage(const std::string& str)
+{
+  // short strings are stored inline
+  return str.capacity() > std::string{}.capacity() ? str.capacity() + 1u : 0u;
+}
+
+template <typename T>
+size_t heapMemoryUsage(const std::vector<T>& vec)
+{
+  return vec.capacity() * sizeof(T);
+}
+
+size_t heapMemoryUsage(const std::shared_ptr<const CachedMapText>& cachedMapText)
+{
+  // the text may be shared with clones of the node, but it is counted for each of them
+  return cachedMapText ? sizeof(CachedMapText) + heapMemoryUsage(cachedMapText->text)
+                       : 0u;
+}
+
+size_t heapMemoryUsage(const Layer& layer)
+{
+  return heapMemoryUsage(layer.name());
+}
+
+size_t heapMemoryUsage(const Group& group)
+{
+  return heapMemoryUsage(group.name());
+}
+
+size_t heapMemoryUsage(const Entity& entity)
+{
+  auto result = heapMemoryUsage(entity.properties());
+  for (const auto& property : entity.properties())
+  {
+    result += heapMemoryUsage(property.key()) + heapMemoryUsage(property.value());
+  }
+
+  result += heapMemoryUsage(entity.protectedProperties());
+  for (const auto& key : entity.protectedProperties())
+  {
+    result += heapMemoryUsage(key);
+  }
+
+  return result;
+}
+
+size_t heapMemoryUsage(const Brush& brush)
+{
+  auto result = heapMemoryUsage(brush.faces()) + brush.geometryAllocatedBytes();
+  for (const auto& face : brush.faces())
+  {
+    result += heapMemoryUsage(face.materialName());
+  }
+  return result;
+}
+
+size_t heapMemoryUsage(const BezierPatch& patch)
+{
+  return heapMemoryUsage(patch.controlPoints()) + heapMemoryUsage(patch.materialName());
+}
+
+} // namespace
+
+size_t memoryUsage(const Layer& layer)
+{
+  return sizeof(Layer) + heapMemoryUsage(layer);
+}
+
+size_t memoryUsage(const Group& group)
+{
+  return sizeof(Group) + heapMemoryUsage(group);
+}
+
+size_t memoryUsage(const Entity& entity)
+{
+  return sizeof(Entity) + heapMemoryUsage(entity);
+}
+
+size_t memoryUsage(const Brush& brush)
+{
+  return sizeof(Brush) + heapMemoryUsage(brush);
+}
+
+size_t memoryUsage(const BezierPatch& patch)
+{
+  return sizeof(BezierPatch) + heapMemoryUsage(patch);
+}
+
+size_t memoryUsage(const NodeContents& contents)
+{
+  const auto heapUsage =
+    std::visit([](const auto& x) { return heapMemoryUsage(x); }, contents.get());
+  return sizeof(NodeContents) + heapUsage;
+}
+
+size_t memoryUsage(const Node& node)
+{
+  auto result = node.accept(kdl::overload(
+    [](const WorldNode& worldNode) {
+      return sizeof(WorldNode) + heapMemoryUsage(worldNode.entity());
+    },
+    [](const LayerNode& layerNode) {
+      return sizeof(LayerNode) + heapMemoryUsage(layerNode.layer());
+    },
+    [](const GroupNode& groupNode) {
+      return sizeof(GroupNode) + heapMemoryUsage(groupNode.group());
+    },
+    [](const EntityNode& entityNode) {
+      return sizeof(EntityNode) + heapMemoryUsage(entityNode.entity());
+    },
+    [](const BrushNode& brushNode) {
+      return sizeof(BrushNode) + heapMemoryUsage(brushNode.brush())
+             + brushNode.facePlanes().allocatedBytes();
+    },
+    [](const PatchNode& patchNode) {
+      return sizeof(PatchNode) + heapMemoryUsage(patchNode.patch());
+    }));
+
+  result += heapMemoryUsage(node.cachedMapText());
+  result += heapMemoryUsage(node.children());
+  for (const auto* child : node.children())
+  {
+    result += memoryUsage(*child);
+  }
+
+  return result;
+}
+
+} // namespace tb::mdl
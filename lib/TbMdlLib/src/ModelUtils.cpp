@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <ranges>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -322,6 +323,70 @@ static std::vector<Node*> collectMatchingNodes(
   return result;
 }
 
+/**
+ * Like the above, but gathers the candidates by querying the given node tree with the
+ * bounds of the given brushes instead of visiting every node. Each candidate is replaced
+ * by its outermost closed group, if any, and entities with children are skipped because
+ * their children are in the tree themselves. Thereby, the same nodes are tested against
+ * the predicate as above, except that a closed group is only tested if one of its members
+ * is near one of the given brushes.
+ */
+template <typename P>
+static std::vector<Node*> collectMatchingNodes(
+  const NodeTree& nodeTree, const std::vector<BrushNode*>& brushes, const P& predicate)
+{
+  auto result = std::vector<Node*>{};
+  auto visited = std::unordered_set<Node*>{};
+
+  const auto collectIfMatching = [&](Node& node) {
+    for (const auto* brush : brushes)
+    {
+      if (predicate(node, brush))
+      {
+        result.push_back(&node);
+        return;
+      }
+    }
+  };
+
+  for (const auto* queryBrush : brushes)
+  {
+    for (auto* candidate : nodeTree.find_intersectors(queryBrush->physicalBounds()))
+    {
+      if (auto* groupNode = findOutermostClosedGroup(candidate))
+      {
+        if (visited.insert(groupNode).second)
+        {
+          collectIfMatching(*groupNode);
+        }
+      }
+      else if (visited.insert(candidate).second)
+      {
+        candidate->accept(kdl::overload(
+          [](WorldNode&) {},
+          [](LayerNode&) {},
+          [](GroupNode&) {},
+          [&](EntityNode& entityNode) {
+            if (!entityNode.hasChildren())
+            {
+              collectIfMatching(entityNode);
+            }
+          },
+          [&](BrushNode& brushNode) {
+            // if `brush` is one of the search query nodes, don't count it as touching
+            if (!kdl::vec_contains(brushes, &brushNode))
+            {
+              collectIfMatching(brushNode);
+            }
+          },
+          [&](PatchNode& patchNode) { collectIfMatching(patchNode); }));
+      }
+    }
+  }
+
+  return result;
+}
+
 std::vector<Node*> collectTouchingNodes(
   const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushNodes)
 {
@@ -340,6 +405,24 @@ std::vector<Node*> collectContainedNodes(
     });
 }
 
+std::vector<Node*> collectTouchingNodes(
+  const NodeTree& nodeTree, const std::vector<BrushNode*>& brushNodes)
+{
+  return collectMatchingNodes(
+    nodeTree, brushNodes, [](const auto& node, const auto& brushNode) {
+      return brushNode->intersects(node);
+    });
+}
+
+std::vector<Node*> collectContainedNodes(
+  const NodeTree& nodeTree, const std::vector<BrushNode*>& brushNodes)
+{
+  return collectMatchingNodes(
+    nodeTree, brushNodes, [](const auto& node, const auto& brushNode) {
+      return brushNode->contains(node);
+    });
+}
+
 std::vector<Node*> collectSelectedNodes(const std::vector<Node*>& nodes)
 {
   return collectNodesAndDescendants(
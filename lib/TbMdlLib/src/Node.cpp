@@ -113,7 +113,9 @@ double Node::projectedArea(const vm::axis::type axis) const
 
 Node* Node::clone(const vm::bbox3d& worldBounds) const
 {
-  return doClone(worldBounds);
+  auto* clone = doClone(worldBounds);
+  clone->m_cachedMapText = m_cachedMapText;
+  return clone;
 }
 
 Node* Node::cloneRecursively(const vm::bbox3d& worldBounds) const
@@ -473,6 +475,7 @@ void Node::ancestorDidChange()
 
 void Node::nodeWillChange()
 {
+  m_cachedMapText.reset();
   if (m_parent)
   {
     m_parent->childWillChange(*this);
@@ -820,6 +823,16 @@ bool Node::containsLine(const size_t lineNumber) const
   return lineNumber >= m_lineNumber && lineNumber < m_lineNumber + m_lineCount;
 }
 
+const std::shared_ptr<const CachedMapText>& Node::cachedMapText() const
+{
+  return m_cachedMapText;
+}
+
+void Node::setCachedMapText(std::shared_ptr<const CachedMapText> cachedMapText) const
+{
+  m_cachedMapText = std::move(cachedMapText);
+}
+
 std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& validators)
 {
   validateIssues(validators);
@@ -78,6 +78,11 @@ double VertexHandle::distance(const VertexHandle& lhs, const VertexHandle& rhs)
   return vm::distance(lhs.position, rhs.position);
 }
 
+vm::vec3d VertexHandle::anchor(const VertexHandle& handle)
+{
+  return handle.position;
+}
+
 std::optional<Hit> VertexHandle::pick(
   const HitType::Type hitType,
   const vm::ray3d& pickRay,
@@ -118,6 +123,11 @@ double EdgeHandle::distance(const EdgeHandle& lhs, const EdgeHandle& rhs)
     vm::distance(lhs.position.end(), rhs.position.end()));
 }
 
+vm::vec3d EdgeHandle::anchor(const EdgeHandle& handle)
+{
+  return handle.position.start();
+}
+
 std::optional<Hit> EdgeHandle::pick(
   const HitType::Type hitType,
   const vm::ray3d& pickRay,
@@ -192,6 +202,11 @@ double FaceHandle::distance(const FaceHandle& lhs, const FaceHandle& rhs)
   return *std::ranges::max_element(distances);
 }
 
+vm::vec3d FaceHandle::anchor(const FaceHandle& handle)
+{
+  return handle.position.vertices().front();
+}
+
 std::optional<Hit> FaceHandle::pick(
   const HitType::Type hitType,
   const vm::ray3d& pickRay,
@@ -260,6 +275,11 @@ double ControlPointHandle::distance(
   return vm::distance(lhs.position, rhs.position);
 }
 
+vm::vec3d ControlPointHandle::anchor(const ControlPointHandle& handle)
+{
+  return handle.position;
+}
+
 std::optional<Hit> ControlPointHandle::pick(
   const HitType::Type hitType,
   const vm::ray3d& pickRay,
@@ -113,6 +113,17 @@ void NodeSerializer::setEntityToAdd(std::optional<Entity> entityToAdd)
   m_entityToAdd = std::move(entityToAdd);
 }
 
+const std::optional<size_t>& NodeSerializer::maxCachedMapTextSize() const
+{
+  return m_maxCachedMapTextSize;
+}
+
+void NodeSerializer::setMaxCachedMapTextSize(
+  const std::optional<size_t> maxCachedMapTextSize)
+{
+  m_maxCachedMapTextSize = maxCachedMapTextSize;
+}
+
 void NodeSerializer::beginFile(
   const std::vector<const Node*>& rootNodes, kdl::task_manager& taskManager)
 {
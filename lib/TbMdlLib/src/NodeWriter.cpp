@@ -125,6 +125,11 @@ void NodeWriter::setEntityToAdd(std::optional<Entity> entityToAdd)
   m_serializer->setEntityToAdd(std::move(entityToAdd));
 }
 
+void NodeWriter::setMaxCachedMapTextSize(const std::optional<size_t> maxCachedMapTextSize)
+{
+  m_serializer->setMaxCachedMapTextSize(maxCachedMapTextSize);
+}
+
 void NodeWriter::writeMap(kdl::task_manager& taskManager)
 {
   m_serializer->beginFile({&m_world}, taskManager);
@@ -34,6 +34,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <array>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -77,23 +78,42 @@ bool Palette::indexedToRgba(
                                        ? m_data->opaqueData.data()
                                        : m_data->index255TransparentData.data();
 
-  // Write rgba pixels
+  // Read the indices into the last quarter of the destination buffer. Since the pixels
+  // are written front to back, no index is overwritten before it has been read.
   auto* const rgbaData = rgbaImage.data();
+  auto* const indices = rgbaData + 3 * pixelCount;
+  reader.read(indices, pixelCount);
+
+  // Write rgba pixels and count how often each index is used. The color sums and the
+  // transparency only depend on the index counts, so they can be computed from the
+  // palette instead of from the pixels. Unsigned arithmetic wraps around in the same way
+  // as summing up the pixels would.
+  //
+  // Consecutive pixels are counted in separate tables so that runs of the same index
+  // don't have to wait for the previous increment.
+  auto indexCounts = std::array<std::array<uint32_t, 256>, 4>{};
   for (size_t i = 0; i < pixelCount; ++i)
   {
-    const int index = reader.readInt<unsigned char>();
-
+    const auto index = size_t(indices[i]);
     std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+    ++indexCounts[i % 4][index];
   }
 
-  // Check average color
   uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
+  unsigned char andAlpha = 0xFF;
+  for (size_t index = 0; index < 256; ++index)
   {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+    if (const auto count = indexCounts[0][index] + indexCounts[1][index]
+                           + indexCounts[2][index] + indexCounts[3][index];
+        count > 0)
+    {
+      colorSum[0] += count * uint32_t(paletteData[(index * 4) + 0]);
+      colorSum[1] += count * uint32_t(paletteData[(index * 4) + 1]);
+      colorSum[2] += count * uint32_t(paletteData[(index * 4) + 2]);
+      andAlpha = static_cast<unsigned char>(andAlpha & paletteData[(index * 4) + 3]);
+    }
   }
+
   averageColor = RgbaF{
     float(colorSum[0]) / (255.0f * float(pixelCount)),
     float(colorSum[1]) / (255.0f * float(pixelCount)),
@@ -101,17 +121,8 @@ bool Palette::indexedToRgba(
     1.0f};
 
   // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
+  const auto hasTransparency =
+    transparency == PaletteTransparency::Index255Transparent && andAlpha != 0xFF;
 
   return hasTransparency;
 }
@@ -36,12 +36,15 @@
 #include "kd/overload.h"
 #include "kd/ranges/zip_view.h"
 #include "kd/reflection_impl.h"
+#include "kd/vector_utils.h"
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 #include "vm/intersection.h"
 #include "vm/vec_io.h" // IWYU pragma: keep
 
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -70,6 +73,70 @@ size_t PatchGrid::quadColumnCount() const
 
 kdl_reflect_impl(PatchGrid);
 
+kdl_reflect_impl(PatchGridBvh::Cell);
+
+std::optional<double> PatchGridBvh::intersect(
+  const vm::ray3d& ray, const PatchGrid& grid) const
+{
+  auto result = std::optional<double>{};
+  const auto intersectTriangle = [&](const auto& p0, const auto& p1, const auto& p2) {
+    if (const auto distance = vm::intersect_ray_triangle(ray, p0, p1, p2))
+    {
+      if (!result || *distance < *result)
+      {
+        result = distance;
+      }
+    }
+  };
+
+  auto pending = std::vector<size_t>{};
+  if (!cells.empty())
+  {
+    pending.push_back(0u);
+  }
+
+  while (!pending.empty())
+  {
+    const auto index = kdl::vec_pop_back(pending);
+    const auto& cell = cells[index];
+
+    const auto distance = cell.bounds.contains(ray.origin)
+                            ? std::optional{0.0}
+                            : vm::intersect_ray_bbox(ray, cell.bounds);
+    if (!distance || (result && *distance > *result))
+    {
+      // the ray misses the cell or enters it behind the closest hit found so far
+      continue;
+    }
+
+    if (cell.secondChild == 0u)
+    {
+      for (size_t row = cell.rowBegin; row < cell.rowEnd; ++row)
+      {
+        for (size_t col = cell.columnBegin; col < cell.columnEnd; ++col)
+        {
+          const auto& v0 = grid.point(row, col).position;
+          const auto& v1 = grid.point(row, col + 1u).position;
+          const auto& v2 = grid.point(row + 1u, col + 1u).position;
+          const auto& v3 = grid.point(row + 1u, col).position;
+
+          intersectTriangle(v0, v1, v2);
+          intersectTriangle(v2, v3, v0);
+        }
+      }
+    }
+    else
+    {
+      pending.push_back(cell.secondChild);
+      pending.push_back(index + 1u);
+    }
+  }
+
+  return result;
+}
+
+kdl_reflect_impl(PatchGridBvh);
+
 /**
  * Compute the normals for the given patch grid points.
  *
@@ -299,6 +366,76 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
     gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
 }
 
+namespace
+{
+
+// the maximum number of quads in a leaf cell of a patch grid BVH
+constexpr auto MaxQuadsPerBvhLeaf = size_t(4);
+
+size_t addBvhCell(
+  std::vector<PatchGridBvh::Cell>& cells,
+  const PatchGrid& grid,
+  const size_t rowBegin,
+  const size_t rowEnd,
+  const size_t columnBegin,
+  const size_t columnEnd)
+{
+  const auto index = cells.size();
+  cells.push_back({{}, rowBegin, rowEnd, columnBegin, columnEnd, 0u});
+
+  const auto rowCount = rowEnd - rowBegin;
+  const auto columnCount = columnEnd - columnBegin;
+  if (rowCount * columnCount <= MaxQuadsPerBvhLeaf)
+  {
+    auto boundsBuilder = vm::bbox3d::builder{};
+    for (size_t row = rowBegin; row <= rowEnd; ++row)
+    {
+      for (size_t col = columnBegin; col <= columnEnd; ++col)
+      {
+        boundsBuilder.add(grid.point(row, col).position);
+      }
+    }
+
+    // expand the bounds a bit so that rounding errors in the ray / box test don't cause
+    // us to miss a quad that the ray hits
+    cells[index].bounds =
+      boundsBuilder.bounds().expand(vm::constants<double>::almost_zero());
+  }
+  else
+  {
+    auto secondChild = size_t(0);
+    if (rowCount >= columnCount)
+    {
+      const auto rowSplit = rowBegin + rowCount / 2u;
+      addBvhCell(cells, grid, rowBegin, rowSplit, columnBegin, columnEnd);
+      secondChild = addBvhCell(cells, grid, rowSplit, rowEnd, columnBegin, columnEnd);
+    }
+    else
+    {
+      const auto columnSplit = columnBegin + columnCount / 2u;
+      addBvhCell(cells, grid, rowBegin, rowEnd, columnBegin, columnSplit);
+      secondChild = addBvhCell(cells, grid, rowBegin, rowEnd, columnSplit, columnEnd);
+    }
+
+    cells[index].bounds = vm::merge(cells[index + 1u].bounds, cells[secondChild].bounds);
+    cells[index].secondChild = secondChild;
+  }
+
+  return index;
+}
+
+} // namespace
+
+PatchGridBvh makePatchGridBvh(const PatchGrid& grid)
+{
+  auto cells = std::vector<PatchGridBvh::Cell>{};
+  if (grid.quadRowCount() > 0u && grid.quadColumnCount() > 0u)
+  {
+    addBvhCell(cells, grid, 0u, grid.quadRowCount(), 0u, grid.quadColumnCount());
+  }
+  return PatchGridBvh{std::move(cells)};
+}
+
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
@@ -349,6 +486,7 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
   m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+  m_gridBvh = std::nullopt;
   return previousPatch;
 }
 
@@ -434,30 +572,16 @@ void PatchNode::doPick(
   {
     return;
   }
-  const auto pickTriangle = [&](const auto& p0, const auto& p1, const auto& p2) {
-    if (const auto distance = vm::intersect_ray_triangle(pickRay, p0, p1, p2))
-    {
-      const auto hitPoint = vm::point_at_distance(pickRay, *distance);
-      pickResult.addHit(Hit(PatchHitType, *distance, hitPoint, this));
-      return true;
-    }
-    return false;
-  };
 
-  for (size_t row = 0u; row < m_grid.pointRowCount - 1u; ++row)
+  if (!m_gridBvh)
   {
-    for (size_t col = 0u; col < m_grid.pointColumnCount - 1u; ++col)
-    {
-      const auto v0 = m_grid.point(row, col).position;
-      const auto v1 = m_grid.point(row, col + 1u).position;
-      const auto v2 = m_grid.point(row + 1u, col + 1u).position;
-      const auto v3 = m_grid.point(row + 1u, col).position;
+    m_gridBvh = makePatchGridBvh(m_grid);
+  }
 
-      if (pickTriangle(v0, v1, v2) || pickTriangle(v2, v3, v0))
-      {
-        return;
-      }
-    }
+  if (const auto distance = m_gridBvh->intersect(pickRay, m_grid))
+  {
+    const auto hitPoint = vm::point_at_distance(pickRay, *distance);
+    pickResult.addHit(Hit(PatchHitType, *distance, hitPoint, this));
   }
 }
 
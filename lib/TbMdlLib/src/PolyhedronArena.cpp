@@ -0,0 +1,207 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/PolyhedronArena.h"
+
+#include "kd/contracts.h"
+
+#include <algorithm>
+#include <new>
+
+namespace tb::mdl
+{
+
+struct PolyhedronArena::Block
+{
+  Block* next;
+};
+
+namespace
+{
+
+static_assert(sizeof(PolyhedronArena*) % PolyhedronArena::Alignment == 0);
+
+PolyhedronArena** header(void* ptr)
+{
+  return static_cast<PolyhedronArena**>(ptr) - 1;
+}
+
+} // namespace
+
+void PolyhedronArena::Release::operator()(PolyhedronArena* arena) const
+{
+  arena->release();
+}
+
+PolyhedronArena::PolyhedronArena() = default;
+
+PolyhedronArena::~PolyhedronArena()
+{
+  while (m_blocks)
+  {
+    auto* next = m_blocks->next;
+    ::operator delete(m_blocks);
+    m_blocks = next;
+  }
+}
+
+PolyhedronArena::Ptr PolyhedronArena::create()
+{
+  return Ptr{new PolyhedronArena{}};
+}
+
+PolyhedronArena& PolyhedronArena::of(const void* ptr)
+{
+  return **header(const_cast<void*>(ptr));
+}
+
+void* PolyhedronArena::allocate(const size_t size)
+{
+  const auto slot = slotSize(size);
+
+  auto* freeList = findFreeList(slot);
+  auto* memory = static_cast<std::byte*>(nullptr);
+  if (freeList && freeList->first)
+  {
+    memory = static_cast<std::byte*>(freeList->first);
+    freeList->first = *reinterpret_cast<void**>(memory + sizeof(PolyhedronArena*));
+  }
+  else
+  {
+    if (m_current == nullptr || size_t(m_end - m_current) < slot)
+    {
+      addBlock(std::max(slot, m_nextBlockSize));
+      m_nextBlockSize = std::min(2 * m_nextBlockSize, MaxBlockSize);
+    }
+    memory = m_current;
+    m_current += slot;
+  }
+
+  auto* ptr = memory + sizeof(PolyhedronArena*);
+  *header(ptr) = this;
+  retain();
+  return ptr;
+}
+
+void PolyhedronArena::deallocate(void* ptr, const size_t size)
+{
+  auto& arena = of(ptr);
+  if (auto* freeList = arena.findFreeList(slotSize(size)))
+  {
+    *static_cast<void**>(ptr) = freeList->first;
+    freeList->first = header(ptr);
+  }
+  arena.release();
+}
+
+void PolyhedronArena::deallocate(void* ptr)
+{
+  of(ptr).release();
+}
+
+void PolyhedronArena::reserve(const size_t size)
+{
+  if (m_current == nullptr || size_t(m_end - m_current) < size)
+  {
+    addBlock(size);
+  }
+}
+
+size_t PolyhedronArena::blockCount() const
+{
+  auto count = size_t(0);
+  for (const auto* block = m_blocks; block; block = block->next)
+  {
+    ++count;
+  }
+  return count;
+}
+
+size_t PolyhedronArena::allocatedBytes() const
+{
+  return m_allocatedBytes;
+}
+
+size_t PolyhedronArena::referenceCount() const
+{
+  return m_referenceCount;
+}
+
+void PolyhedronArena::addBlock(const size_t size)
+{
+  auto* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next = m_blocks;
+  m_blocks = block;
+  m_allocatedBytes += sizeof(Block) + size;
+
+  m_current = reinterpret_cast<std::byte*>(block + 1);
+  m_end = m_current + size;
+}
+
+PolyhedronArena::FreeList* PolyhedronArena::findFreeList(const size_t slotSize)
+{
+  for (auto& freeList : m_freeLists)
+  {
+    if (freeList.slotSize == slotSize)
+    {
+      return &freeList;
+    }
+    if (freeList.slotSize == 0)
+    {
+      freeList.slotSize = slotSize;
+      return &freeList;
+    }
+  }
+
+  // there are only four kinds of elements in a polyhedron, so this should not happen,
+  // but if it does, the memory is simply not reused
+  return nullptr;
+}
+
+void PolyhedronArena::retain()
+{
+  ++m_referenceCount;
+}
+
+void PolyhedronArena::release()
+{
+  contract_pre(m_referenceCount > 0);
+
+  if (--m_referenceCount == 0)
+  {
+    delete this;
+  }
+}
+
+void* PolyhedronArenaElement::operator new(const std::size_t size, PolyhedronArena& arena)
+{
+  return arena.allocate(size);
+}
+
+void PolyhedronArenaElement::operator delete(void* ptr, PolyhedronArena&)
+{
+  PolyhedronArena::deallocate(ptr);
+}
+
+void PolyhedronArenaElement::operator delete(void* ptr, const std::size_t size)
+{
+  PolyhedronArena::deallocate(ptr, size);
+}
+
+} // namespace tb::mdl
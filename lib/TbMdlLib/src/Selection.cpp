@@ -37,6 +37,7 @@
 #include "kd/reflection_impl.h"
 
 #include <ranges>
+#include <unordered_set>
 
 namespace tb::mdl
 {
@@ -83,11 +84,9 @@ std::vector<EntityNodeBase*> computeAllEntities(
   return result;
 }
 
-std::vector<BrushNode*> computeAllBrushes(const Selection& selection)
+void collectAllBrushes(const std::vector<Node*>& nodes, std::vector<BrushNode*>& result)
 {
-  auto result = std::vector<BrushNode*>{};
-
-  for (auto* node : selection.nodes)
+  for (auto* node : nodes)
   {
     node->accept(kdl::overload(
       [](WorldNode&) {},
@@ -100,7 +99,12 @@ std::vector<BrushNode*> computeAllBrushes(const Selection& selection)
       [&](BrushNode& brushNode) { result.push_back(&brushNode); },
       [&](PatchNode&) {}));
   }
+}
 
+std::vector<BrushNode*> computeAllBrushes(const Selection& selection)
+{
+  auto result = std::vector<BrushNode*>{};
+  collectAllBrushes(selection.nodes, result);
   return result;
 }
 
@@ -116,12 +120,31 @@ std::vector<BrushFaceHandle> computeAllBrushFaces(
   return faceSelectionWithLinkedGroupConstraints(worldNode, faces).facesToSelect;
 }
 
-template <typename T, std::ranges::range S>
+struct BrushFaceHandleHash
+{
+  size_t operator()(const BrushFaceHandle& handle) const
+  {
+    return std::hash<const BrushNode*>{}(handle.node()) ^ (handle.faceIndex() << 1);
+  }
+};
+
+/*
+ * Removes the elements of `remove` from `s1` and appends the elements of `add`. The
+ * removed elements are looked up in a hash set so that deselecting many elements at once
+ * takes time linear in the size of the selection rather than quadratic.
+ */
+template <typename T, typename Hash = std::hash<T>, std::ranges::range S>
 auto applyChange(std::vector<T>& s1, S&& remove, S&& add)
 {
+  auto toRemove = std::unordered_set<T, Hash>{};
   for (const auto& x : remove)
   {
-    std::erase(s1, x);
+    toRemove.insert(x);
+  }
+
+  if (!toRemove.empty())
+  {
+    std::erase_if(s1, [&](const auto& x) { return toRemove.contains(x); });
   }
   s1.insert(s1.end(), add.begin(), add.end());
 }
@@ -162,10 +185,19 @@ void Selection::update(const SelectionChange& selectionChange)
     selectionChange.deselectedNodes | makeNodeFilter<PatchNode>(),
     selectionChange.selectedNodes | makeNodeFilter<PatchNode>());
 
-  applyChange(
+  applyChange<BrushFaceHandle, BrushFaceHandleHash>(
     brushFaces, selectionChange.deselectedBrushFaces, selectionChange.selectedBrushFaces);
 
+  // If nodes were only added to the selection, the brushes they contribute can be
+  // appended to the cached brushes because the nodes were appended to the selection.
+  auto cachedAllBrushes = std::move(m_cachedAllBrushes);
   invalidate();
+
+  if (cachedAllBrushes && selectionChange.deselectedNodes.empty())
+  {
+    collectAllBrushes(selectionChange.selectedNodes, *cachedAllBrushes);
+    m_cachedAllBrushes = std::move(cachedAllBrushes);
+  }
 }
 
 void Selection::clear()
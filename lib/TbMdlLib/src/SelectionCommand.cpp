@@ -293,6 +293,13 @@ SelectionCommand::SelectionCommand(
 
 SelectionCommand::~SelectionCommand() = default;
 
+size_t SelectionCommand::memoryUsage() const
+{
+  return (m_nodes.capacity() + m_previouslySelectedNodes.capacity()) * sizeof(Node*)
+         + (m_faceRefs.capacity() + m_previouslySelectedFaceRefs.capacity())
+             * sizeof(BrushFaceReference);
+}
+
 std::string SelectionCommand::makeName(
   const Action action, const size_t nodeCount, const size_t faceCount)
 {
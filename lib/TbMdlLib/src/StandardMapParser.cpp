@@ -65,8 +65,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{tokenNames(), str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{tokenNames(), str, "\"", '\\', line, column}
 {
 }
 
@@ -179,7 +180,16 @@ StandardMapParser::StandardMapParser(
   const std::string_view str,
   const MapFormat sourceMapFormat,
   const MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  : StandardMapParser{str, FileLocation{1, 1}, sourceMapFormat, targetMapFormat}
+{
+}
+
+StandardMapParser::StandardMapParser(
+  const std::string_view str,
+  const FileLocation& startLocation,
+  const MapFormat sourceMapFormat,
+  const MapFormat targetMapFormat)
+  : m_tokenizer{str, startLocation.line, startLocation.column.value_or(1)}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
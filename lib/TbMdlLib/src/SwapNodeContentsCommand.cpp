@@ -20,31 +20,39 @@
 #include "mdl/SwapNodeContentsCommand.h"
 
 #include "base/Notifier.h"
+#include "mdl/BrushNode.h"
 #include "mdl/GameInfo.h"
 #include "mdl/Map.h"
 #include "mdl/Map_Assets.h"
 #include "mdl/Map_World.h"
+#include "mdl/MemoryUsage.h"
 #include "mdl/Node.h"
 #include "mdl/NodeQueries.h"
 
+#include "kd/contracts.h"
+#include "kd/ranges/as_rvalue_view.h"
 #include "kd/ranges/to.h"
 
+#include <algorithm>
 #include <ranges>
+#include <variant>
 
 namespace tb::mdl
 {
 namespace
 {
 
+using StoredNodeContents = std::variant<NodeContents, BrushDelta>;
+
 auto notifySpecialWorldProperties(
-  const std::vector<std::pair<Node*, NodeContents>>& nodesToSwap)
+  const std::vector<std::pair<Node*, StoredNodeContents>>& nodesToSwap)
 {
   for (const auto& [node, contents] : nodesToSwap)
   {
     if (const auto* worldNode = dynamic_cast<const WorldNode*>(node))
     {
       const auto& oldEntity = worldNode->entity();
-      const auto& newEntity = std::get<Entity>(contents.get());
+      const auto& newEntity = std::get<Entity>(std::get<NodeContents>(contents).get());
 
       const auto* oldWads = oldEntity.property(EntityPropertyKeys::Wad);
       const auto* newWads = newEntity.property(EntityPropertyKeys::Wad);
@@ -70,8 +78,42 @@ auto notifySpecialWorldProperties(
   return std::tuple{false, false, false};
 }
 
+/**
+ * Returns the given stored contents, recreating a brush from its delta if necessary.
+ */
+NodeContents takeNodeContents(const Node& node, StoredNodeContents& storedContents)
+{
+  return std::visit(
+    kdl::overload(
+      [](NodeContents& contents) { return std::move(contents); },
+      [&](const BrushDelta& brushDelta) {
+        // deltas are only stored for brush nodes
+        const auto& brushNode = dynamic_cast<const BrushNode&>(node);
+        return NodeContents{brushDelta.apply(brushNode.brush())};
+      }),
+    storedContents);
+}
+
+/**
+ * Returns a delta for the given contents relative to the node's current brush if
+ * possible, and otherwise returns the given contents.
+ */
+StoredNodeContents storeNodeContents(const Node& node, NodeContents contents)
+{
+  if (const auto* brushNode = dynamic_cast<const BrushNode*>(&node))
+  {
+    if (
+      auto brushDelta =
+        BrushDelta::create(std::get<Brush>(contents.get()), brushNode->brush()))
+    {
+      return std::move(*brushDelta);
+    }
+  }
+  return contents;
+}
+
 void doSwapNodeContents(
-  std::vector<std::pair<Node*, NodeContents>>& nodesToSwap, Map& map)
+  std::vector<std::pair<Node*, StoredNodeContents>>& nodesToSwap, Map& map)
 {
   const auto nodes = nodesToSwap
                      | std::views::transform([](const auto& pair) { return pair.first; })
@@ -96,9 +138,10 @@ void doSwapNodeContents(
   for (auto& pair : nodesToSwap)
   {
     auto* node = pair.first;
-    auto& contents = pair.second.get();
+    auto newContents = takeNodeContents(*node, pair.second);
+    auto& contents = newContents.get();
 
-    pair.second = node->accept(kdl::overload(
+    auto oldContents = node->accept(kdl::overload(
       [&](WorldNode& worldNode) {
         return NodeContents{worldNode.setEntity(std::get<Entity>(std::move(contents)))};
       },
@@ -118,6 +161,8 @@ void doSwapNodeContents(
         return NodeContents{
           patchNode.setPatch(std::get<BezierPatch>(std::move(contents)))};
       }));
+
+    pair.second = storeNodeContents(*node, std::move(oldContents));
   }
 }
 
@@ -126,7 +171,11 @@ void doSwapNodeContents(
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   std::string name, std::vector<std::pair<Node*, NodeContents>> nodes)
   : UpdateLinkedGroupsCommandBase{std::move(name), true}
-  , m_nodes{std::move(nodes)}
+  , m_nodes{
+      nodes | kdl::views::as_rvalue | std::views::transform([](auto pair) {
+        return std::pair{pair.first, StoredNodeContents{std::move(pair.second)}};
+      })
+      | kdl::ranges::to<std::vector>()}
 {
 }
 
@@ -158,10 +207,60 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
     std::ranges::sort(myNodes);
     std::ranges::sort(theirNodes);
 
-    return myNodes == theirNodes;
+    if (myNodes == theirNodes)
+    {
+      rebaseBrushDeltas(*other);
+      return true;
+    }
   }
 
   return false;
 }
 
+size_t SwapNodeContentsCommand::memoryUsage() const
+{
+  auto result =
+    UpdateLinkedGroupsCommandBase::memoryUsage() + m_nodes.capacity() * sizeof(Node*);
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += std::visit(
+      kdl::overload(
+        [](const NodeContents& nodeContents) { return mdl::memoryUsage(nodeContents); },
+        [](const BrushDelta& brushDelta) { return brushDelta.memoryUsage(); }),
+      contents);
+  }
+  return result;
+}
+
+void SwapNodeContentsCommand::rebaseBrushDeltas(SwapNodeContentsCommand& other)
+{
+  // Our brush deltas are relative to the brushes that the other command has replaced, so
+  // we recreate our brushes from the other command's contents and store them relative to
+  // the current brushes.
+  for (auto& [node, contents] : m_nodes)
+  {
+    if (const auto* brushDelta = std::get_if<BrushDelta>(&contents))
+    {
+      auto iOther = std::ranges::find(other.m_nodes, node, [](const auto& pair) {
+        return pair.first;
+      });
+      contract_assert(iOther != other.m_nodes.end());
+
+      const auto replacedContents = std::visit(
+        kdl::overload(
+          [](const NodeContents& nodeContents) {
+            return std::get<Brush>(nodeContents.get());
+          },
+          [&](const BrushDelta& otherBrushDelta) {
+            const auto& brushNode = dynamic_cast<const BrushNode&>(*node);
+            return otherBrushDelta.apply(brushNode.brush());
+          }),
+        iOther->second);
+
+      contents =
+        storeNodeContents(*node, NodeContents{brushDelta->apply(replacedContents)});
+    }
+  }
+}
+
 } // namespace tb::mdl
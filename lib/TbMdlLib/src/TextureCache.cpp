@@ -0,0 +1,377 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/TextureCache.h"
+
+#include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/FileSystem.h"
+#include "fs/PathInfo.h"
+#include "fs/PathMatcher.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+#include "fs/TraversalMode.h"
+#include "gl/Texture.h"
+#include "gl/TextureBuffer.h"
+#include "mdl/CacheFile.h"
+#include "mdl/LoadImageTexture.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr auto CacheFileMagic = uint64_t(0x4548434143544254); // "TBTCACHE"
+constexpr auto CacheFileVersion = uint32_t(1);
+
+constexpr auto NoEmbeddedDefaultsTag = uint8_t(0);
+constexpr auto Q2EmbeddedDefaultsTag = uint8_t(1);
+
+Result<gl::Texture> readTextureCache(const fs::MappedFile& file, const uint64_t key)
+{
+  try
+  {
+    auto reader = file.reader();
+    if (
+      reader.read<uint64_t, uint64_t>() != CacheFileMagic
+      || reader.read<uint32_t, uint32_t>() != CacheFileVersion)
+    {
+      return Error{"Unsupported texture cache"};
+    }
+
+    if (reader.read<uint64_t, uint64_t>() != key)
+    {
+      return Error{"Texture cache is stale"};
+    }
+
+    const auto width = reader.readSize<uint32_t>();
+    const auto height = reader.readSize<uint32_t>();
+    const auto format = reader.read<uint32_t, GLenum>();
+    const auto mask = reader.readUnsignedChar<uint8_t>() != 0 ? gl::TextureMask::On
+                                                               : gl::TextureMask::Off;
+    const auto averageColor = reader.readVec<float, 4>();
+
+    auto embeddedDefaults = gl::EmbeddedDefaults{gl::NoEmbeddedDefaults{}};
+    if (reader.read<uint8_t, uint8_t>() == Q2EmbeddedDefaultsTag)
+    {
+      const auto flags = reader.readInt<int32_t>();
+      const auto contents = reader.readInt<int32_t>();
+      const auto value = reader.readInt<int32_t>();
+      embeddedDefaults = gl::Q2EmbeddedDefaults{flags, contents, value};
+    }
+
+    auto bufferSizes = std::vector<size_t>{};
+    const auto bufferCount = reader.readSize<uint32_t>();
+    for (size_t i = 0; i < bufferCount; ++i)
+    {
+      bufferSizes.push_back(reader.readSize<uint64_t>());
+    }
+
+    // the header is followed by its checksum, the buffers are not checksummed
+    const auto headerSize = reader.position();
+    auto hash = Fnv1aHash{};
+    hash.update(file.stringView().substr(0, headerSize));
+    if (reader.read<uint64_t, uint64_t>() != hash.value())
+    {
+      return Error{"Texture cache is corrupt"};
+    }
+
+    auto buffers = gl::TextureBufferList{};
+    buffers.reserve(bufferCount);
+    for (const auto bufferSize : bufferSizes)
+    {
+      if (!reader.canRead(bufferSize))
+      {
+        return Error{"Texture cache is truncated"};
+      }
+
+      auto& buffer = buffers.emplace_back(bufferSize);
+      reader.read(buffer.data(), bufferSize);
+    }
+
+    if (!reader.eof())
+    {
+      return Error{"Texture cache is corrupt"};
+    }
+
+    return gl::Texture{
+      width,
+      height,
+      RgbaF{averageColor[0], averageColor[1], averageColor[2], averageColor[3]},
+      format,
+      mask,
+      std::move(embeddedDefaults),
+      std::move(buffers)};
+  }
+  catch (const fs::ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+std::string writeTextureCacheHeader(const uint64_t key, const gl::Texture& texture)
+{
+  const auto& buffers = texture.buffersIfLoaded();
+  const auto averageColor = texture.averageColor().to<RgbaF>().toVec();
+
+  auto writer = CacheWriter{};
+  writer.write(CacheFileMagic);
+  writer.write(CacheFileVersion);
+  writer.write(key);
+  writer.write(uint32_t(texture.width()));
+  writer.write(uint32_t(texture.height()));
+  writer.write(uint32_t(texture.format()));
+  writer.write(uint8_t(texture.mask() == gl::TextureMask::On ? 1 : 0));
+  for (size_t i = 0; i < 4; ++i)
+  {
+    writer.write(averageColor[i]);
+  }
+
+  std::visit(
+    kdl::overload(
+      [&](const gl::NoEmbeddedDefaults&) { writer.write(NoEmbeddedDefaultsTag); },
+      [&](const gl::Q2EmbeddedDefaults& defaults) {
+        writer.write(Q2EmbeddedDefaultsTag);
+        writer.write(int32_t(defaults.flags));
+        writer.write(int32_t(defaults.contents));
+        writer.write(int32_t(defaults.value));
+      }),
+    texture.embeddedDefaults());
+
+  writer.write(uint32_t(buffers.size()));
+  for (const auto& buffer : buffers)
+  {
+    writer.write(uint64_t(buffer.size()));
+  }
+
+  return writer.finish();
+}
+
+/**
+ * Returns the key of the given file if it is stored on disk. Computing the key does not
+ * read the file.
+ */
+std::optional<uint64_t> computeDiskFileKey(
+  const fs::File& file, const std::filesystem::path& absolutePath)
+{
+  if (dynamic_cast<const fs::CFile*>(&file))
+  {
+    auto error = std::error_code{};
+    const auto modificationTime = std::filesystem::last_write_time(absolutePath, error);
+    if (!error)
+    {
+      return computeTextureCacheKey(file.size(), modificationTime);
+    }
+  }
+  return std::nullopt;
+}
+
+Result<gl::Texture> readAndTouchTextureCache(
+  const std::filesystem::path& path, const uint64_t key)
+{
+  return mdl::readTextureCache(path, key) | kdl::transform([&](auto texture) {
+           // the modification time of a cache file records its last use
+           auto error = std::error_code{};
+           std::filesystem::last_write_time(
+             path, std::filesystem::file_time_type::clock::now(), error);
+           return texture;
+         });
+}
+
+} // namespace
+
+TextureCache::TextureCache(std::filesystem::path cacheFolderPath)
+  : m_cacheFolderPath{std::move(cacheFolderPath)}
+{
+}
+
+const std::filesystem::path& TextureCache::cacheFolderPath() const
+{
+  return m_cacheFolderPath;
+}
+
+bool TextureCache::enabled() const
+{
+  return m_enabled;
+}
+
+void TextureCache::setEnabled(const bool enabled)
+{
+  m_enabled = enabled;
+}
+
+Result<gl::Texture> TextureCache::loadImageTexture(
+  const fs::FileSystem& fs, const std::filesystem::path& path) const
+{
+  if (!m_enabled)
+  {
+    return fs.openFile(path) | kdl::and_then([](auto file) {
+             auto reader = file->reader().buffer();
+             return mdl::loadImageTexture(reader);
+           });
+  }
+
+  return fs.openFile(path) | kdl::and_then([&](auto file) {
+           const auto absolutePath = fs.makeAbsolute(path) | kdl::value_or(path);
+           const auto cachePath = makeTextureCachePath(m_cacheFolderPath, absolutePath);
+
+           const auto loadAndWriteCache = [&](auto& reader, const uint64_t key) {
+             return mdl::loadImageTexture(reader) | kdl::transform([&](auto texture) {
+                      writeTextureCache(cachePath, key, texture) | kdl::ignore();
+                      return texture;
+                    });
+           };
+
+           // a missing, stale or corrupt cache is silently ignored and replaced
+           if (const auto key = computeDiskFileKey(*file, absolutePath))
+           {
+             return readAndTouchTextureCache(cachePath, *key)
+                    | kdl::or_else([&](auto) {
+                        auto reader = file->reader().buffer();
+                        return loadAndWriteCache(reader, *key);
+                      });
+           }
+
+           auto reader = file->reader().buffer();
+           const auto key = computeTextureCacheKey(reader.stringView());
+           return readAndTouchTextureCache(cachePath, key)
+                  | kdl::or_else([&](auto) { return loadAndWriteCache(reader, key); });
+         });
+}
+
+uint64_t computeTextureCacheKey(const std::string_view imageFileContents)
+{
+  auto hash = Fnv1aHash{};
+  hash.update(CacheFileVersion);
+  hash.update(imageFileContents);
+  return hash.value();
+}
+
+uint64_t computeTextureCacheKey(
+  const size_t imageFileSize,
+  const std::filesystem::file_time_type imageFileModificationTime)
+{
+  auto hash = Fnv1aHash{};
+  hash.update(CacheFileVersion);
+  hash.update(uint64_t(imageFileSize));
+  hash.update(int64_t(imageFileModificationTime.time_since_epoch().count()));
+  return hash.value();
+}
+
+std::filesystem::path makeTextureCachePath(
+  const std::filesystem::path& cacheFolderPath, const std::filesystem::path& imagePath)
+{
+  auto hash = Fnv1aHash{};
+  const auto str = imagePath.generic_u8string();
+  hash.update(reinterpret_cast<const char*>(str.data()), str.size());
+  return cacheFolderPath / fmt::format("{:016x}.bin", hash.value());
+}
+
+Result<gl::Texture> readTextureCache(
+  const std::filesystem::path& path, const uint64_t key)
+{
+  return fs::Disk::mapFile(path) | kdl::and_then([&](auto file) {
+           return readTextureCache(*file, key);
+         });
+}
+
+Result<void> writeTextureCache(
+  const std::filesystem::path& path, const uint64_t key, const gl::Texture& texture)
+{
+  const auto& buffers = texture.buffersIfLoaded();
+  if (buffers.empty())
+  {
+    return Error{"Texture is not loaded"};
+  }
+
+  const auto header = writeTextureCacheHeader(key, texture);
+  return writeCacheFile(path, [&](auto& stream) {
+    stream.write(header.data(), std::streamsize(header.size()));
+    for (const auto& buffer : buffers)
+    {
+      stream.write(
+        reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+    }
+  });
+}
+
+Result<void> trimTextureCache(
+  const std::filesystem::path& cacheFolderPath, const size_t maxSize)
+{
+  struct CacheFileInfo
+  {
+    std::filesystem::path path;
+    uintmax_t size;
+    std::filesystem::file_time_type lastUse;
+  };
+
+  if (fs::Disk::pathInfo(cacheFolderPath) != fs::PathInfo::Directory)
+  {
+    return Result<void>{};
+  }
+
+  return fs::Disk::find(
+           cacheFolderPath,
+           fs::TraversalMode::Flat,
+           fs::makeExtensionPathMatcher({".bin"}))
+         | kdl::transform([&](const auto& paths) {
+             auto cacheFiles = std::vector<CacheFileInfo>{};
+             auto totalSize = uintmax_t(0);
+             for (const auto& path : paths)
+             {
+               auto sizeError = std::error_code{};
+               auto lastUseError = std::error_code{};
+               const auto size = std::filesystem::file_size(path, sizeError);
+               const auto lastUse = std::filesystem::last_write_time(path, lastUseError);
+               if (!sizeError && !lastUseError)
+               {
+                 cacheFiles.push_back(CacheFileInfo{path, size, lastUse});
+                 totalSize += size;
+               }
+             }
+
+             std::ranges::sort(cacheFiles, {}, &CacheFileInfo::lastUse);
+             for (const auto& cacheFile : cacheFiles)
+             {
+               if (totalSize <= maxSize)
+               {
+                 break;
+               }
+
+               if (fs::Disk::deleteFile(cacheFile.path) | kdl::value_or(false))
+               {
+                 totalSize -= cacheFile.size;
+               }
+             }
+           });
+}
+
+} // namespace tb::mdl
@@ -22,6 +22,7 @@
 #include "mdl/GroupNode.h"
 #include "mdl/LinkedGroupUtils.h"
 #include "mdl/Map.h"
+#include "mdl/MemoryUsage.h"
 #include "mdl/ModelUtils.h"
 
 #include "kd/overload.h"
@@ -155,6 +156,28 @@ void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
   }
 }
 
+size_t UpdateLinkedGroupsHelper::memoryUsage() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups& changedLinkedGroups) {
+        return changedLinkedGroups.capacity() * sizeof(GroupNode*);
+      },
+      [](const LinkedGroupUpdates& linkedGroupUpdates) {
+        auto result =
+          linkedGroupUpdates.capacity() * sizeof(LinkedGroupUpdates::value_type);
+        for (const auto& [groupNode, nodes] : linkedGroupUpdates)
+        {
+          for (const auto& node : nodes)
+          {
+            result += mdl::memoryUsage(*node);
+          }
+        }
+        return result;
+      }),
+    m_state);
+}
+
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(Map& map)
 {
   return std::visit(
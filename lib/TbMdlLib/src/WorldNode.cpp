@@ -23,9 +23,11 @@
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Hit.h"
 #include "mdl/LayerNode.h"
 #include "mdl/Octree.h"
 #include "mdl/PatchNode.h"
+#include "mdl/PickResult.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/Validator.h"
 #include "mdl/ValidatorRegistry.h"
@@ -37,6 +39,8 @@
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -194,6 +198,42 @@ void WorldNode::unregisterAllValidators()
   invalidateAllIssues();
 }
 
+void WorldNode::pickNearest(
+  const EditorContext& editorContext,
+  const vm::ray3d& ray,
+  const HitFilter& hitFilter,
+  const size_t count,
+  PickResult& pickResult)
+{
+  contract_pre(count > 0);
+
+  // the distances of the closest matching hits found so far, in ascending order
+  auto distances = std::vector<double>{};
+  auto nodePickResult = PickResult{};
+
+  m_nodeTree->visit_intersectors(ray, [&](Node* node) {
+    nodePickResult.clear();
+    node->pick(editorContext, ray, nodePickResult);
+
+    for (const auto& hit : nodePickResult.all())
+    {
+      if (hitFilter(hit))
+      {
+        const auto distance = hit.distance();
+        distances.insert(std::ranges::upper_bound(distances, distance), distance);
+        if (distances.size() > count)
+        {
+          distances.pop_back();
+        }
+      }
+      pickResult.addHit(hit);
+    }
+
+    return distances.size() < count ? std::numeric_limits<double>::max()
+                                     : distances.back();
+  });
+}
+
 void WorldNode::disableNodeTreeUpdates()
 {
   m_updateNodeTree = false;
@@ -33,6 +33,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -71,11 +72,12 @@ Result<std::unique_ptr<WorldNode>> WorldReader::tryRead(
   const vm::bbox3d& worldBounds,
   const EntityPropertyConfig& entityPropertyConfig,
   ParserStatus& status,
-  kdl::task_manager& taskManager)
+  kdl::task_manager& taskManager,
+  const BrushGeometryCache* brushGeometryCache)
 {
   auto parserErrors = std::vector<std::tuple<MapFormat, std::string>>{};
 
-  for (const auto mapFormat : mapFormatsToTry)
+  for (const auto mapFormat : sniffFormats(str, mapFormatsToTry, entityPropertyConfig))
   {
     if (mapFormat == MapFormat::Unknown)
     {
@@ -83,7 +85,7 @@ Result<std::unique_ptr<WorldNode>> WorldReader::tryRead(
     }
 
     auto reader = WorldReader{str, mapFormat, entityPropertyConfig};
-    if (auto result = reader.read(worldBounds, status, taskManager))
+    if (auto result = reader.read(worldBounds, status, taskManager, brushGeometryCache))
     {
       return result;
     }
@@ -97,7 +99,11 @@ Result<std::unique_ptr<WorldNode>> WorldReader::tryRead(
 
   if (!parserErrors.empty())
   {
-    // No format parsed successfully. Just return the parse error from the last one.
+    // No format parsed successfully. Report the errors in the order the formats were
+    // given.
+    std::ranges::stable_sort(parserErrors, {}, [&](const auto& parserError) {
+      return std::ranges::find(mapFormatsToTry, std::get<0>(parserError));
+    });
     return Error{formatParserErrors(parserErrors)};
   }
 
@@ -170,8 +176,12 @@ void setLinkIds(WorldNode& worldNode, ParserStatus& status)
 } // namespace
 
 Result<std::unique_ptr<WorldNode>> WorldReader::read(
-  const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
+  const vm::bbox3d& worldBounds,
+  ParserStatus& status,
+  kdl::task_manager& taskManager,
+  const BrushGeometryCache* brushGeometryCache)
 {
+  setBrushGeometryCache(brushGeometryCache);
   return readEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
            sanitizeLayerSortIndicies(*m_worldNode, status);
            setLinkIds(*m_worldNode, status);
@@ -32,12 +32,14 @@
 #include "mdl/Transaction.h"
 #include "version/Version.h"
 
+#include "kd/task_manager.h"
 #include "kd/vector_utils.h"
 
 #include <fmt/format.h>
 
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <ranges>
 #include <thread>
 
@@ -105,6 +107,7 @@ TEST_CASE("Autosaver")
       {{map.editorContext().currentLayer(), {createBrushNode(map, "some_material")}}});
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(!env.fileExists("autosave/test.1.map"));
     CHECK(!env.directoryExists("autosave"));
@@ -124,6 +127,7 @@ TEST_CASE("Autosaver")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(env.fileExists("autosave/test.1.map"));
     CHECK(env.directoryExists("autosave"));
@@ -145,6 +149,7 @@ TEST_CASE("Autosaver")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(!env.fileExists("autosave/test.1.map"));
     CHECK(!env.directoryExists("autosave"));
@@ -152,6 +157,7 @@ TEST_CASE("Autosaver")
     transaction.commit();
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(env.fileExists("autosave/test.1.map"));
     CHECK(env.directoryExists("autosave"));
@@ -172,6 +178,7 @@ TEST_CASE("Autosaver")
     std::this_thread::sleep_for(100ms);
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(env.fileExists("autosave/test.1.map"));
     CHECK(env.directoryExists("autosave"));
@@ -181,6 +188,7 @@ TEST_CASE("Autosaver")
     std::this_thread::sleep_for(100ms);
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
     CHECK(!env.fileExists("autosave/test.2.map"));
 
     // modify the map
@@ -189,6 +197,7 @@ TEST_CASE("Autosaver")
       {{map.editorContext().currentLayer(), {createBrushNode(map, "some_material")}}});
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
     CHECK(env.fileExists("autosave/test.2.map"));
   }
 
@@ -199,6 +208,7 @@ TEST_CASE("Autosaver")
 
     auto autosaver = Autosaver{map, 0s};
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(!env.fileExists("autosave/test.1.map"));
     CHECK(!env.directoryExists("autosave"));
@@ -223,6 +233,67 @@ TEST_CASE("Autosaver")
       {{map.editorContext().currentLayer(), {createBrushNode(map, "some_material")}}});
 
     autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
+
+    CHECK(env.fileExists("autosave/test.2.map"));
+  }
+
+  SECTION("Backups are written from a snapshot of the map")
+  {
+    REQUIRE(map.saveAs(env.dir() / "test.map"));
+    REQUIRE(env.fileExists("test.map"));
+
+    auto autosaver = Autosaver{map, 0s};
+
+    // modify the map
+    addNodes(
+      map,
+      {{map.editorContext().currentLayer(), {createBrushNode(map, "some_material")}}});
+    REQUIRE(map.saveTo(env.dir() / "expected.map"));
+
+    autosaver.triggerAutosave();
+
+    // modify the map while the backup is being written
+    addNodes(map, {{map.editorContext().currentLayer(), {new EntityNode{{}}}}});
+
+    autosaver.waitForPendingAutosave();
+
+    CHECK(env.fileExists("autosave/test.1.map"));
+    CHECK(env.loadFile("autosave/test.1.map") == env.loadFile("expected.map"));
+  }
+
+  SECTION("Autosaves are coalesced while a backup is being written")
+  {
+    REQUIRE(map.saveAs(env.dir() / "test.map"));
+    REQUIRE(env.fileExists("test.map"));
+
+    auto autosaver = Autosaver{map, 0s};
+
+    // keep the worker busy so that the backup cannot be written yet
+    auto blocker = std::promise<void>{};
+    auto blockerTask =
+      map.taskManager().run_task([blocked = blocker.get_future()]() { blocked.wait(); });
+
+    // modify the map
+    addNodes(
+      map,
+      {{map.editorContext().currentLayer(), {createBrushNode(map, "some_material")}}});
+    autosaver.triggerAutosave();
+
+    // modify the map again
+    addNodes(map, {{map.editorContext().currentLayer(), {new EntityNode{{}}}}});
+    autosaver.triggerAutosave();
+
+    blocker.set_value();
+    blockerTask.wait();
+    autosaver.waitForPendingAutosave();
+
+    CHECK(env.fileExists("autosave/test.1.map"));
+    CHECK(!env.fileExists("autosave/test.2.map"));
+
+    // the second modification is saved with the next autosave
+    autosaver.triggerAutosave();
+    autosaver.waitForPendingAutosave();
 
     CHECK(env.fileExists("autosave/test.2.map"));
   }
@@ -292,6 +363,7 @@ TEST_CASE("Autosaver")
 
       std::this_thread::sleep_for(100ms);
       autosaver.triggerAutosave();
+      autosaver.waitForPendingAutosave();
 
       const auto allPaths = kdl::vec_push_back(initialPaths, "autosave/test.3.map");
 
@@ -309,6 +381,7 @@ TEST_CASE("Autosaver")
 
       std::this_thread::sleep_for(100ms);
       autosaver.triggerAutosave();
+      autosaver.waitForPendingAutosave();
 
       CHECK(env.directoryContents("autosave") == allPaths);
       CHECK_THAT(
@@ -350,6 +423,7 @@ TEST_CASE("Autosaver")
 
       std::this_thread::sleep_for(100ms);
       autosaver.triggerAutosave();
+      autosaver.waitForPendingAutosave();
 
       const auto allPaths = std::vector<std::filesystem::path>{
         "autosave/test.1.map",
@@ -393,6 +467,7 @@ TEST_CASE("Autosaver")
 
       std::this_thread::sleep_for(100ms);
       autosaver.triggerAutosave();
+      autosaver.waitForPendingAutosave();
 
       // the two oldest backups (test.1, test.2) must be deleted so that the total
       // number of backups doesn't exceed maxBackups
@@ -439,6 +514,7 @@ TEST_CASE("Autosaver")
 
       std::this_thread::sleep_for(100ms);
       autosaver.triggerAutosave();
+      autosaver.waitForPendingAutosave();
 
       // the three oldest backups (test.1, test.2, test.3) must be deleted so that
       // the total number of backups doesn't exceed maxBackups
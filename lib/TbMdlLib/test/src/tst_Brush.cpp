@@ -31,6 +31,7 @@
 #include "mdl/NodeReader.h"
 #include "mdl/TestUtils.h"
 
+#include "kd/range_utils.h"
 #include "kd/ranges/concat_view.h"
 #include "kd/ranges/to.h"
 #include "kd/result.h"
@@ -344,6 +345,58 @@ TEST_CASE("Brush")
     }
   }
 
+  SECTION("createFromGeometry")
+  {
+    const auto worldBounds = vm::bbox3d{4096.0};
+
+    const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+    const auto brush =
+      brushBuilder.createCube(64.0, "left", "right", "front", "back", "top", "bottom")
+      | kdl::value();
+
+    auto positions = std::vector<vm::vec3d>{};
+    for (const auto* vertex : brush.vertices())
+    {
+      positions.push_back(vertex->position());
+    }
+
+    auto faceVertexIndices = std::vector<std::vector<size_t>>{};
+    auto facePlanes = std::vector<vm::plane3d>{};
+    for (const auto& face : brush.faces())
+    {
+      auto vertexIndices = std::vector<size_t>{};
+      for (const auto* halfEdge : face.geometry()->boundary())
+      {
+        vertexIndices.push_back(
+          *kdl::index_of(positions, halfEdge->origin()->position()));
+      }
+      faceVertexIndices.push_back(std::move(vertexIndices));
+      facePlanes.push_back(face.geometry()->plane());
+    }
+
+    auto geometry = BrushGeometry::fromFaces(positions, faceVertexIndices, facePlanes);
+    REQUIRE(geometry != std::nullopt);
+
+    SECTION("With matching faces")
+    {
+      auto faces = brush.faces();
+      std::ranges::reverse(faces);
+
+      const auto createdBrush = Brush::createFromGeometry(faces, std::move(*geometry));
+      CHECK(createdBrush == brush);
+      CHECK(faces.empty());
+    }
+
+    SECTION("With a missing face")
+    {
+      auto faces = brush.faces();
+      faces.pop_back();
+
+      CHECK(Brush::createFromGeometry(faces, std::move(*geometry)).is_error());
+      CHECK(faces.size() == 5);
+    }
+  }
+
   SECTION("cloneFaceAttributesFrom")
   {
     const auto worldBounds = vm::bbox3d{4096.0};
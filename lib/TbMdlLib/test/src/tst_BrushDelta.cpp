@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushDelta.h"
+#include "mdl/BrushFace.h"
+#include "mdl/MapFormat.h"
+#include "mdl/MemoryUsage.h"
+#include "mdl/UvAttributes.h"
+
+#include "kd/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("BrushDelta")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  const auto base =
+    builder.createCuboid(
+      vm::bbox3d{vm::vec3d{-32, -64, -16}, vm::vec3d{32, 64, 16}}, "material")
+    | kdl::value();
+
+  SECTION("create")
+  {
+    SECTION("Returns an empty delta for equal brushes")
+    {
+      const auto delta = BrushDelta::create(base, base);
+      REQUIRE(delta);
+      CHECK(delta->faceCount() == 0);
+      CHECK(delta->apply(base) == base);
+    }
+
+    SECTION("Returns nullopt if the geometry differs")
+    {
+      auto brush = base;
+      REQUIRE(brush.transform(
+        worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+
+      CHECK(BrushDelta::create(brush, base) == std::nullopt);
+    }
+
+    SECTION("Stores only the faces whose attributes differ")
+    {
+      auto brush = base;
+
+      auto& face = brush.face(0);
+      auto uvAttributes = face.uvAttributes();
+      uvAttributes.offset = vm::vec2f{8, 4};
+      uvAttributes.rotation = 15.0f;
+      face.setUvAttributes(uvAttributes);
+
+      brush.face(2).setMaterialName("other");
+
+      auto surfaceAttributes = brush.face(3).surfaceAttributes();
+      surfaceAttributes.value = 2.0f;
+      brush.face(3).setSurfaceAttributes(surfaceAttributes);
+
+      const auto delta = BrushDelta::create(brush, base);
+      REQUIRE(delta);
+      CHECK(delta->faceCount() == 3);
+      CHECK(delta->apply(base) == brush);
+
+      const auto reverseDelta = BrushDelta::create(base, brush);
+      REQUIRE(reverseDelta);
+      CHECK(reverseDelta->apply(brush) == base);
+    }
+  }
+
+  SECTION("memoryUsage")
+  {
+    auto brush = base;
+
+    auto& face = brush.face(0);
+    auto uvAttributes = face.uvAttributes();
+    uvAttributes.offset = vm::vec2f{8, 4};
+    face.setUvAttributes(uvAttributes);
+
+    const auto delta = BrushDelta::create(brush, base);
+    REQUIRE(delta);
+    CHECK(delta->memoryUsage() * 10 < memoryUsage(brush));
+  }
+}
+
+} // namespace tb::mdl
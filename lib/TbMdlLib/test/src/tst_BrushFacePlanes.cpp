@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFacePlanes.h"
+#include "mdl/MapFormat.h"
+
+#include "kd/result.h"
+
+#include "vm/approx.h"
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/ray.h"
+#include "vm/ray_io.h" // IWYU pragma: keep
+#include "vm/vec.h"
+
+#include <optional>
+#include <tuple>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("BrushFacePlanes")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto brush = builder.createCuboid(
+                 vm::bbox3d{vm::vec3d{-32, -64, -16}, vm::vec3d{32, 64, 16}}, "material")
+               | kdl::value();
+  REQUIRE(brush.transform(
+    worldBounds,
+    vm::rotation_matrix(vm::to_radians(15.0), vm::to_radians(30.0), vm::to_radians(45.0)),
+    false));
+
+  const auto facePlanes = BrushFacePlanes{brush};
+  REQUIRE(facePlanes.count() == brush.faceCount());
+
+  SECTION("Reports the memory occupied by the planes")
+  {
+    CHECK(facePlanes.allocatedBytes() >= 4u * brush.faceCount() * sizeof(double));
+    CHECK(BrushFacePlanes{}.allocatedBytes() == 0u);
+  }
+
+  SECTION("Finds the same face as intersecting each face")
+  {
+    const auto intersectFaces = [&](const vm::ray3d& ray) {
+      for (size_t i = 0u; i < brush.faceCount(); ++i)
+      {
+        if (const auto distance = brush.face(i).intersectWithRay(ray))
+        {
+          return std::optional{std::tuple{*distance, i}};
+        }
+      }
+      return std::optional<std::tuple<double, size_t>>{};
+    };
+
+    for (double x = -80.0; x <= 80.0; x += 10.0)
+    {
+      for (double y = -80.0; y <= 80.0; y += 10.0)
+      {
+        for (const auto& ray :
+             {vm::ray3d{vm::vec3d{x, y, 128.0}, vm::vec3d{0, 0, -1}},
+              vm::ray3d{vm::vec3d{x, -128.0, y}, vm::vec3d{0, 1, 0}},
+              vm::ray3d{
+                vm::vec3d{128.0, x, y}, vm::normalize(vm::vec3d{-1, 0.25, -0.5})}})
+        {
+          CAPTURE(ray);
+
+          const auto expected = intersectFaces(ray);
+          const auto actual = facePlanes.intersect(ray);
+          REQUIRE(actual.has_value() == expected.has_value());
+          if (expected)
+          {
+            CHECK(std::get<0>(*actual) == vm::approx{std::get<0>(*expected)});
+            CHECK(std::get<1>(*actual) == std::get<1>(*expected));
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Misses if the ray origin is inside of the brush")
+  {
+    CHECK(facePlanes.intersect(vm::ray3d{vm::vec3d{0, 0, 0}, vm::vec3d{1, 0, 0}})
+          == std::nullopt);
+  }
+
+  SECTION("Misses if the ray points away from the brush")
+  {
+    CHECK(facePlanes.intersect(vm::ray3d{vm::vec3d{0, 0, 128}, vm::vec3d{0, 0, 1}})
+          == std::nullopt);
+  }
+}
+
+} // namespace tb::mdl
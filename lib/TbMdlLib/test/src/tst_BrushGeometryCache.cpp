@@ -0,0 +1,288 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TestParserStatus.h"
+#include "fs/TestEnvironment.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushGeometryCache.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/EntityNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/WorldNode.h"
+#include "mdl/WorldReader.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+#include "kd/task_manager.h"
+
+#include "vm/mat_ext.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+const auto MapContents = R"(
+{
+"classname" "worldspawn"
+{
+( -16 -16 -16 ) ( -16 -15 -16 ) ( -16 -16 -15 ) tex1 0 0 0 1 1
+( -16 -16 -16 ) ( -16 -16 -15 ) ( -15 -16 -16 ) tex2 0 0 0 1 1
+( -16 -16 -16 ) ( -15 -16 -16 ) ( -16 -15 -16 ) tex3 0 0 0 1 1
+( 16 16 16 ) ( 16 17 16 ) ( 17 16 16 ) tex4 0 0 0 1 1
+( 16 16 16 ) ( 17 16 16 ) ( 16 16 17 ) tex5 0 0 0 1 1
+( 16 16 16 ) ( 16 16 17 ) ( 16 17 16 ) tex6 0 0 0 1 1
+}
+}
+{
+"classname" "func_detail"
+{
+( 32 32 32 ) ( 32 33 32 ) ( 32 32 33 ) tex1 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 33 32 32 ) tex2 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 33 32 ) tex3 0 0 0 1 1
+( 64 64 64 ) ( 64 65 64 ) ( 65 64 64 ) tex4 0 0 0 1 1
+( 64 64 64 ) ( 65 64 64 ) ( 64 64 65 ) tex5 0 0 0 1 1
+( 64 64 64 ) ( 64 64 65 ) ( 64 65 64 ) tex6 0 0 0 1 1
+// redundant face that is not part of the brush geometry
+( 64 64 64 ) ( 64 65 64 ) ( 65 64 64 ) tex7 0 0 0 1 1
+}
+}
+)";
+
+std::vector<Brush> getBrushes(const WorldNode& worldNode)
+{
+  auto result = std::vector<Brush>{};
+  worldNode.accept(kdl::overload(
+    [](auto&& thisLambda, const WorldNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const LayerNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const GroupNode& node) { node.visitChildren(thisLambda); },
+    [](auto&& thisLambda, const EntityNode& node) { node.visitChildren(thisLambda); },
+    [&](const BrushNode& node) { result.push_back(node.brush()); },
+    [](const PatchNode&) {}));
+  return result;
+}
+
+std::unique_ptr<WorldNode> readWorld(const BrushGeometryCache* brushGeometryCache)
+{
+  auto taskManager = kdl::task_manager{};
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{MapContents, MapFormat::Standard, {}};
+  return reader.read(vm::bbox3d{8192.0}, status, taskManager, brushGeometryCache)
+         | kdl::value();
+}
+
+} // namespace
+
+TEST_CASE("BrushGeometryCache")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto key = BrushGeometryCache::computeKey("Quake", worldBounds);
+
+  const auto worldNode = readWorld(nullptr);
+  const auto brushes = getBrushes(*worldNode);
+  REQUIRE(brushes.size() == 2);
+
+  const auto cache = BrushGeometryCache::create(key, *worldNode);
+
+  SECTION("computeKey")
+  {
+    CHECK(BrushGeometryCache::computeKey("Quake", worldBounds) == key);
+    CHECK(BrushGeometryCache::computeKey("Quake 2", worldBounds) != key);
+    CHECK(BrushGeometryCache::computeKey("Quake", vm::bbox3d{4096.0}) != key);
+  }
+
+  SECTION("computeBrushKey")
+  {
+    const auto& faces = brushes.front().faces();
+    const auto brushKey = BrushGeometryCache::computeBrushKey(faces);
+
+    auto reversedFaces = faces;
+    std::ranges::reverse(reversedFaces);
+    CHECK(BrushGeometryCache::computeBrushKey(reversedFaces) == brushKey);
+
+    CHECK(BrushGeometryCache::computeBrushKey(brushes.back().faces()) != brushKey);
+  }
+
+  SECTION("create")
+  {
+    CHECK(cache.key() == key);
+    CHECK(cache.size() == 2);
+
+    SECTION("With a previous cache")
+    {
+      const auto frontKey = BrushGeometryCache::computeBrushKey(brushes.front().faces());
+      const auto backKey = BrushGeometryCache::computeBrushKey(brushes.back().faces());
+
+      // marks the previous entry so that we can tell whether it was reused
+      auto previousEntry = cache.entries().at(frontKey);
+      previousEntry.vertexPositions.push_back(vm::vec3d{1, 2, 3});
+      const auto previousVertexPositions = previousEntry.vertexPositions;
+
+      SECTION("Entries of unchanged brushes are reused")
+      {
+        auto previous = BrushGeometryCache{key};
+        previous.add(frontKey, std::move(previousEntry));
+        previous.add(frontKey + 1, cache.entries().at(frontKey));
+
+        const auto updatedCache =
+          BrushGeometryCache::create(key, *worldNode, std::move(previous));
+        CHECK(updatedCache.size() == 2);
+        CHECK(
+          updatedCache.entries().at(frontKey).vertexPositions == previousVertexPositions);
+        CHECK(
+          updatedCache.entries().at(backKey).vertexPositions
+          == cache.entries().at(backKey).vertexPositions);
+      }
+
+      SECTION("A previous cache with another key is ignored")
+      {
+        auto previous = BrushGeometryCache{key + 1};
+        previous.add(frontKey, std::move(previousEntry));
+
+        const auto updatedCache =
+          BrushGeometryCache::create(key, *worldNode, std::move(previous));
+        CHECK(updatedCache.size() == 2);
+        CHECK(
+          updatedCache.entries().at(frontKey).vertexPositions
+          == cache.entries().at(frontKey).vertexPositions);
+      }
+    }
+  }
+
+  SECTION("geometry")
+  {
+    for (const auto& brush : brushes)
+    {
+      CHECK(cache.geometry(brush.faces()) != std::nullopt);
+    }
+
+    SECTION("Edited brushes are not found")
+    {
+      auto editedBrush = brushes.front();
+      REQUIRE(editedBrush.transform(
+        worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+      CHECK(cache.geometry(editedBrush.faces()) == std::nullopt);
+      CHECK(cache.geometry(brushes.back().faces()) != std::nullopt);
+    }
+
+    SECTION("Entries with other faces are not used")
+    {
+      const auto& faces = brushes.front().faces();
+      const auto brushKey = BrushGeometryCache::computeBrushKey(faces);
+      const auto& otherEntry =
+        cache.entries().at(BrushGeometryCache::computeBrushKey(brushes.back().faces()));
+
+      auto collidingCache = BrushGeometryCache{key};
+
+      SECTION("With the same face count")
+      {
+        collidingCache.add(brushKey, otherEntry);
+      }
+
+      SECTION("With a different face count")
+      {
+        auto entry = cache.entries().at(brushKey);
+        entry.faces.pop_back();
+        collidingCache.add(brushKey, std::move(entry));
+      }
+
+      CHECK(collidingCache.geometry(faces) == std::nullopt);
+    }
+  }
+
+  SECTION("Reading a world with a cache")
+  {
+    const auto cachedWorldNode = readWorld(&cache);
+    CHECK(getBrushes(*cachedWorldNode) == brushes);
+  }
+
+  SECTION("Reading a world with an invalid cache entry")
+  {
+    auto invalidCache = BrushGeometryCache{key};
+    for (const auto& [brushKey, entry] : cache.entries())
+    {
+      auto invalidEntry = entry;
+      invalidEntry.faces.front().plane = vm::plane3d{1.0, vm::vec3d{0, 0, 1}};
+      invalidCache.add(brushKey, std::move(invalidEntry));
+    }
+
+    const auto cachedWorldNode = readWorld(&invalidCache);
+    CHECK(getBrushes(*cachedWorldNode) == brushes);
+  }
+
+  SECTION("Writing and reading a cache")
+  {
+    auto env = fs::TestEnvironment{};
+    const auto path = makeBrushGeometryCachePath(env.dir(), "maps/test.map");
+    CHECK(path.parent_path() == env.dir());
+    CHECK(path != makeBrushGeometryCachePath(env.dir(), "maps/other.map"));
+
+    REQUIRE(writeBrushGeometryCache(path, cache).is_success());
+
+    SECTION("With the correct key")
+    {
+      const auto readCache = readBrushGeometryCache(path, key) | kdl::value();
+      CHECK(readCache.key() == key);
+      CHECK(readCache.size() == cache.size());
+
+      const auto cachedWorldNode = readWorld(&readCache);
+      CHECK(getBrushes(*cachedWorldNode) == brushes);
+    }
+
+    SECTION("With a stale key")
+    {
+      CHECK(readBrushGeometryCache(path, key + 1).is_error());
+    }
+
+    SECTION("With a corrupt file")
+    {
+      auto contents = env.loadFile(path);
+      contents[contents.size() / 2] ^= 0x01;
+      env.createFile(path, contents);
+
+      CHECK(readBrushGeometryCache(path, key).is_error());
+    }
+
+    SECTION("With a truncated file")
+    {
+      const auto contents = env.loadFile(path);
+      env.createFile(path, contents.substr(0, contents.size() / 2));
+
+      CHECK(readBrushGeometryCache(path, key).is_error());
+    }
+  }
+
+  SECTION("Reading a missing cache file")
+  {
+    auto env = fs::TestEnvironment{};
+    CHECK(readBrushGeometryCache(env.dir() / "missing.bin", key).is_error());
+  }
+}
+
+} // namespace tb::mdl
@@ -251,6 +251,25 @@ public:
   bool doPerformUndo(Map&) override { return true; }
 };
 
+class MemoryCommand : public UndoableCommand
+{
+private:
+  size_t m_memoryUsage;
+
+public:
+  MemoryCommand(std::string name, const size_t memoryUsage)
+    : UndoableCommand{std::move(name), true}
+    , m_memoryUsage{memoryUsage}
+  {
+  }
+
+  size_t memoryUsage() const override { return m_memoryUsage; }
+
+  bool doPerformDo(Map&) override { return true; }
+
+  bool doPerformUndo(Map&) override { return true; }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessor")
@@ -1085,6 +1104,83 @@ TEST_CASE("CommandProcessor")
 
     commandProcessor.undo();
   }
+
+  SECTION("undoMemoryLimit")
+  {
+    CHECK(commandProcessor.undoMemoryUsage() == 0);
+
+    commandProcessor.setUndoMemoryLimit(100);
+    CHECK(commandProcessor.undoMemoryLimit() == 100);
+
+    commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 1", 40));
+    commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 2", 40));
+    CHECK(commandProcessor.undoMemoryUsage() == 80);
+
+    SECTION("Oldest commands are removed when the limit is exceeded")
+    {
+      commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 3", 40));
+      CHECK(commandProcessor.undoMemoryUsage() == 80);
+
+      CHECK(commandProcessor.undo());
+      CHECK(commandProcessor.undo());
+      CHECK(!commandProcessor.canUndo());
+      CHECK(*commandProcessor.redoCommandName() == std::string{"command 2"});
+      CHECK(commandProcessor.undoMemoryUsage() == 80);
+    }
+
+    SECTION("Commands on the redo stack are counted until they are discarded")
+    {
+      CHECK(commandProcessor.undo());
+      CHECK(commandProcessor.undoMemoryUsage() == 80);
+
+      commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 3", 50));
+      CHECK(!commandProcessor.canRedo());
+      CHECK(commandProcessor.undoMemoryUsage() == 90);
+
+      CHECK(commandProcessor.undo());
+      CHECK(commandProcessor.undo());
+      CHECK(!commandProcessor.canUndo());
+    }
+
+    SECTION("Lowering the limit removes commands")
+    {
+      commandProcessor.setUndoMemoryLimit(50);
+      CHECK(commandProcessor.undoMemoryUsage() == 40);
+      CHECK(*commandProcessor.undoCommandName() == std::string{"command 2"});
+
+      CHECK(commandProcessor.undo());
+      CHECK(!commandProcessor.canUndo());
+    }
+
+    SECTION("The most recent command is kept even if it exceeds the limit")
+    {
+      commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 3", 150));
+      CHECK(commandProcessor.undoMemoryUsage() == 150);
+      CHECK(*commandProcessor.undoCommandName() == std::string{"command 3"});
+
+      CHECK(commandProcessor.undo());
+      CHECK(!commandProcessor.canUndo());
+    }
+
+    SECTION("Transactions report the memory used by their commands")
+    {
+      commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+      commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 3", 10));
+      commandProcessor.executeAndStore(std::make_unique<MemoryCommand>("command 4", 10));
+      CHECK(commandProcessor.undoMemoryUsage() == 80);
+
+      commandProcessor.commitTransaction();
+      CHECK(commandProcessor.undoMemoryUsage() > 60);
+      CHECK(commandProcessor.undoMemoryUsage() < 100);
+      CHECK(*commandProcessor.undoCommandName() == std::string{"transaction"});
+    }
+
+    SECTION("Clearing resets the memory usage")
+    {
+      commandProcessor.clear();
+      CHECK(commandProcessor.undoMemoryUsage() == 0);
+    }
+  }
 }
 
 } // namespace tb::mdl
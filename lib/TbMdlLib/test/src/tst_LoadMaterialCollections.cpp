@@ -20,6 +20,7 @@
 #include "TestEnvironment.h"
 #include "base/Logger.h"
 #include "fs/DiskFileSystem.h"
+#include "fs/TestEnvironment.h"
 #include "fs/TestUtils.h"
 #include "fs/VirtualFileSystem.h"
 #include "fs/WadFileSystem.h"
@@ -35,8 +36,12 @@
 #include "kd/reflection_impl.h"
 #include "kd/task_manager.h"
 
+#include <fmt/format.h>
+
+#include <atomic>
 #include <memory>
 #include <ranges>
+#include <string>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
@@ -454,6 +459,83 @@ TEST_CASE("LoadMaterialCollections")
           }));
       }
     }
+
+    SECTION("Loading materials in parallel")
+    {
+      // enough materials to be split over several tasks
+      constexpr auto MaterialCount = size_t(200);
+
+      const auto fixtureDir =
+        fixtureRoot
+        / "test/mdl/LoadMaterialCollections/shaders/shader_with_image_same_name";
+
+      auto env = fs::TestEnvironment{};
+      env.createDirectory("scripts");
+      env.createDirectory("textures/test");
+      std::filesystem::copy_file(
+        fixtureDir / "textures/test/editor_image.jpg",
+        env.dir() / "textures/test/editor_image.jpg");
+
+      auto shaders = std::string{};
+      auto expectedMaterials = std::vector<std::optional<MaterialInfo>>{
+        MaterialInfo{"test/editor_image", 128, 128},
+      };
+      for (size_t i = 0; i < MaterialCount; ++i)
+      {
+        const auto name = fmt::format("test/material_{:03}", i);
+        std::filesystem::copy_file(
+          fixtureDir / "textures/test/image_exists_without_editor_image.tga",
+          env.dir() / "textures" / (name + ".tga"));
+
+        // every tenth material has a shader that replaces its image
+        if (i % 10 == 0)
+        {
+          shaders += fmt::format(
+            "textures/{}\n{{\n  qer_editorimage textures/test/editor_image.jpg\n}}\n",
+            name);
+          expectedMaterials.push_back(MaterialInfo{name, 128, 128});
+        }
+        else
+        {
+          expectedMaterials.push_back(MaterialInfo{name, 64, 64});
+        }
+      }
+      env.createFile("scripts/test.shader", shaders);
+
+      fs.mount("", std::make_unique<fs::DiskFileSystem>(env.dir()));
+
+      const auto materialConfig = mdl::MaterialConfig{
+        "textures",
+        {".tga", ".png", ".jpg", ".jpeg"},
+        "",
+        std::nullopt,
+        "scripts",
+        {},
+      };
+
+      auto createResourceCalls = std::atomic<size_t>{0};
+      auto activeCreateResourceCalls = std::atomic<size_t>{0};
+      auto overlappingCreateResourceCalls = std::atomic<bool>{false};
+      const auto countingCreateResource =
+        gl::CreateTextureResource{[&](auto resourceLoader) {
+          if (activeCreateResourceCalls++ > 0)
+          {
+            overlappingCreateResourceCalls = true;
+          }
+          ++createResourceCalls;
+          auto resource = createResource(std::move(resourceLoader));
+          --activeCreateResourceCalls;
+          return resource;
+        }};
+
+      auto parallelTaskManager = kdl::task_manager{4};
+      CHECK_THAT(
+        loadMaterialCollections(
+          fs, materialConfig, countingCreateResource, parallelTaskManager, logger),
+        MatchesMaterialCollections({{"textures/test", expectedMaterials}}));
+      CHECK(createResourceCalls == MaterialCount + 1);
+      CHECK(!overlappingCreateResourceCalls);
+    }
   }
 }
 
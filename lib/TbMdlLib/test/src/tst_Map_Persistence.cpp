@@ -20,6 +20,8 @@
 #include "Observer.h"
 #include "fs/TestEnvironment.h"
 #include "mdl/BrushBuilder.h"
+#include "mdl/BrushGeometryCache.h"
+#include "mdl/BrushNode.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
@@ -33,6 +35,10 @@
 
 #include <fmt/format.h>
 
+#include <chrono>
+#include <optional>
+#include <thread>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -140,6 +146,99 @@ TEST_CASE("Map_Persistence")
 )");
   }
 
+  SECTION("save updates the brush geometry cache")
+  {
+    auto env = fs::TestEnvironment{};
+
+    auto fixtureConfig = MapFixtureConfig{};
+    fixtureConfig.environmentConfig.userDataFolderPath = env.dir() / "userdata";
+
+    auto fixture = MapFixture{};
+    auto& map = fixture.create(fixtureConfig);
+
+    const auto builder = BrushBuilder{map.worldNode().mapFormat(), map.worldBounds()};
+    auto* brushNode = new BrushNode{
+      builder.createCuboid(vm::bbox3d{{0, 0, 0}, {64, 64, 64}}, "material")
+      | kdl::value()};
+    addNodes(map, {{&parentForNodes(map), {brushNode}}});
+
+    const auto path = env.dir() / "test.map";
+    REQUIRE(map.saveAs(path));
+
+    const auto cachePath =
+      makeBrushGeometryCachePath(env.dir() / "userdata" / "BrushGeometryCache", path);
+    const auto key =
+      BrushGeometryCache::computeKey(map.gameInfo().gameConfig.name, map.worldBounds());
+
+    // the cache file is written in the background
+    const auto readCache = [&]() {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        if (auto cache = readBrushGeometryCache(cachePath, key); cache.is_success())
+        {
+          return std::optional{std::move(cache) | kdl::value()};
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+      }
+      return std::optional<BrushGeometryCache>{};
+    };
+
+    const auto cache = readCache();
+    REQUIRE(cache);
+    CHECK(cache->geometry(brushNode->brush().faces()) != std::nullopt);
+  }
+
+  SECTION("snapshotForSaving keeps layer and group IDs")
+  {
+    auto env = fs::TestEnvironment{};
+
+    const auto filename = "test.map";
+    env.createFile(filename, R"(// Game: Test
+// Format: Valve
+// entity 0
+{
+"classname" "worldspawn"
+}
+// entity 1
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "custom layer"
+"_tb_id" "7"
+}
+// entity 2
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "group"
+"_tb_id" "3"
+"_tb_layer" "7"
+}
+// entity 3
+{
+"name" "entity"
+"_tb_group" "3"
+}
+)");
+
+    const auto path = env.dir() / filename;
+
+    auto fixtureConfig = MapFixtureConfig{};
+    fixtureConfig.gameInfo.gameConfig.fileFormats = {{"Valve", ""}};
+
+    auto fixture = MapFixture{};
+    auto& map = fixture.load(path, fixtureConfig);
+
+    const auto snapshotPath = env.dir() / "snapshot.map";
+    REQUIRE(map.snapshotForSaving()(snapshotPath));
+    REQUIRE(map.save());
+
+    const auto savedText = env.loadFile(path);
+    CHECK(savedText.find(R"("_tb_id" "7")") != std::string::npos);
+    CHECK(savedText.find(R"("_tb_id" "3")") != std::string::npos);
+    CHECK(env.loadFile(snapshotPath) == savedText);
+  }
+
   SECTION("exportAs")
   {
     auto fixture = MapFixture{};
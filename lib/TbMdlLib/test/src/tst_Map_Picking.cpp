@@ -24,6 +24,7 @@
 #include "mdl/EntityDefinitionManager.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Hit.h"
 #include "mdl/HitAdapter.h"
 #include "mdl/Map.h"
 #include "mdl/MapFixture.h"
@@ -37,8 +38,13 @@
 #include "mdl/TestUtils.h"
 #include "mdl/WorldNode.h"
 
+#include "kd/ranges/to.h"
+#include "kd/vector_utils.h"
+
 #include "vm/approx.h"
 
+#include <ranges>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
@@ -373,6 +379,67 @@ TEST_CASE("Map_Picking")
     }
   }
 
+  SECTION("pickNearest")
+  {
+    using namespace HitFilters;
+
+    auto* brushNode1 = new BrushNode{
+      builder.createCuboid(vm::bbox3d{{0, 0, 0}, {64, 64, 64}}, "material")
+      | kdl::value()};
+    auto* brushNode2 = new BrushNode{
+      builder.createCuboid(vm::bbox3d{{128, 0, 0}, {192, 64, 64}}, "material")
+      | kdl::value()};
+    auto* brushNode3 = new BrushNode{
+      builder.createCuboid(vm::bbox3d{{1024, 0, 0}, {1088, 64, 64}}, "material")
+      | kdl::value()};
+    addNodes(map, {{&parentForNodes(map), {brushNode1, brushNode2, brushNode3}}});
+
+    const auto ray = vm::ray3d{{-32, 32, 32}, {1, 0, 0}};
+    const auto hitNodes = [](const std::vector<Hit>& hits) {
+      return hits | std::views::transform(hitToNode) | kdl::ranges::to<std::vector>();
+    };
+
+    SECTION("Stops after the nearest hit")
+    {
+      auto pickResult = PickResult::byDistance();
+      pickNearest(map, ray, type(BrushNode::BrushHitType), 1, pickResult);
+
+      const auto& hit = pickResult.first(type(BrushNode::BrushHitType));
+      CHECK(hitToNode(hit) == brushNode1);
+      CHECK(hit.distance() == vm::approx{32.0});
+
+      // the far brush is not picked
+      CHECK(!kdl::vec_contains(hitNodes(pickResult.all()), brushNode3));
+    }
+
+    SECTION("Finds the given number of hits")
+    {
+      auto pickResult = PickResult::byDistance();
+      pickNearest(map, ray, type(BrushNode::BrushHitType), 3, pickResult);
+
+      CHECK(
+        hitNodes(pickResult.all())
+        == std::vector<Node*>{brushNode1, brushNode2, brushNode3});
+    }
+
+    SECTION("Only counts hits that match the filter")
+    {
+      auto* entityNode = new EntityNode{Entity{{{"origin", "-16 32 32"}}}};
+      addNodes(map, {{&parentForNodes(map), {entityNode}}});
+
+      auto pickResult = PickResult::byDistance();
+      pickNearest(map, ray, type(BrushNode::BrushHitType), 1, pickResult);
+
+      CHECK(hitToNode(pickResult.first(type(EntityNode::EntityHitType))) == entityNode);
+      CHECK(hitToNode(pickResult.first(type(BrushNode::BrushHitType))) == brushNode1);
+
+      pickResult.clear();
+      pickNearest(map, ray, type(EntityNode::EntityHitType), 1, pickResult);
+
+      CHECK(hitNodes(pickResult.all()) == std::vector<Node*>{entityNode});
+    }
+  }
+
   SECTION("findNodesContaining")
   {
     auto* brushNode = new BrushNode{
@@ -373,6 +373,56 @@ TEST_CASE("ModelUtils")
       Equals(std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
   }
 
+  SECTION("collectTouchingNodes and collectContainedNodes with node tree")
+  {
+    constexpr auto worldBounds = vm::bbox3d{8192.0};
+    constexpr auto mapFormat = MapFormat::Quake3;
+
+    const auto builder = BrushBuilder{mapFormat, worldBounds};
+    const auto createBrushNode = [&](const vm::bbox3d& bounds) {
+      return new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()};
+    };
+
+    auto worldNode = WorldNode{{}, {}, mapFormat};
+    auto* layerNode = worldNode.defaultLayer();
+
+    auto* brushNode = createBrushNode({{-16, -16, -16}, {16, 16, 16}});
+    auto* groupNode = new GroupNode{Group{"group"}};
+    auto* groupedBrushNode = createBrushNode({{32, -16, -16}, {64, 16, 16}});
+    auto* entityNode = new EntityNode{Entity{}};
+    auto* entityBrushNode = createBrushNode({{-64, -16, -16}, {-32, 16, 16}});
+    auto* farBrushNode = createBrushNode({{512, 512, 512}, {544, 544, 544}});
+
+    groupNode->addChild(groupedBrushNode);
+    entityNode->addChild(entityBrushNode);
+    layerNode->addChildren({brushNode, groupNode, entityNode, farBrushNode});
+
+    const auto& nodeTree = worldNode.nodeTree();
+
+    auto touchesAll = BrushNode{
+      builder.createCuboid(vm::bbox3d{{-48, -8, -8}, {48, 8, 8}}, "material")
+      | kdl::value()};
+    auto containsAll = BrushNode{
+      builder.createCuboid(vm::bbox3d{{-128, -32, -32}, {128, 32, 32}}, "material")
+      | kdl::value()};
+
+    CHECK_THAT(
+      collectTouchingNodes(nodeTree, {&touchesAll}),
+      UnorderedEquals(std::vector<Node*>{brushNode, groupNode, entityBrushNode}));
+    CHECK_THAT(
+      collectContainedNodes(nodeTree, {&containsAll}),
+      UnorderedEquals(std::vector<Node*>{brushNode, groupNode, entityBrushNode}));
+
+    // the query brushes themselves are not returned
+    CHECK_THAT(collectTouchingNodes(nodeTree, {brushNode}), Equals(std::vector<Node*>{}));
+
+    groupNode->open();
+
+    CHECK_THAT(
+      collectTouchingNodes(nodeTree, {&touchesAll}),
+      UnorderedEquals(std::vector<Node*>{brushNode, groupedBrushNode, entityBrushNode}));
+  }
+
   SECTION("collectSelectedNodes")
   {
     constexpr auto worldBounds = vm::bbox3d{8192.0};
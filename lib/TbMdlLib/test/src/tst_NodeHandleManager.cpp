@@ -87,6 +87,8 @@ struct TestVertexHandle
     return vm::distance(lhs.position, rhs.position);
   }
 
+  static vm::vec3d anchor(const TestVertexHandle& handle) { return handle.position; }
+
   std::optional<Hit> pick(
     const vm::ray3d& pickRay, const gl::Camera& camera, const double handleRadius) const
   {
@@ -134,6 +136,11 @@ struct TestEdgeHandle
       vm::distance(lhs.position.end(), rhs.position.end()));
   }
 
+  static vm::vec3d anchor(const TestEdgeHandle& handle)
+  {
+    return handle.position.start();
+  }
+
   std::optional<Hit> pick(
     const vm::ray3d& pickRay, const gl::Camera& camera, double handleRadius) const
   {
@@ -633,6 +640,78 @@ TEST_CASE("NodeHandleManager")
     }
   }
 
+  SECTION("clumping across cell boundaries")
+  {
+    // With clumpDistance=3, the handles are indexed in cells that are 3 units wide, e.g.
+    // [15, 18) and [18, 21) on the positive axes, [-18, -15) and [-15, -12) on the
+    // negative axes.
+
+    SECTION("handles in adjacent cells are clumped")
+    {
+      // V1 = {+16, +16, +16} and V2 = {+16, +16, +18.5} are 2.5 apart
+      // V3 = {-16, -16, -16} and V4 = {-16, -16, -13.5} are 2.5 apart
+      auto adjacentNode = BrushNode{translateBrush(
+        worldBounds, brushBuilder.createCube(32.0, "material").value(), {0, 0, 2.5})};
+      addNodeHandles(adjacentNode);
+
+      manager.selectHandle(TestVertexHandle{{+16.0, +16.0, +16.0}});
+      manager.selectHandle(TestVertexHandle{{-16.0, -16.0, -16.0}});
+
+      CHECK(manager.selectedHandleCount<TestVertexHandle>() == 2u);
+      CHECK_THAT(
+        manager.selectedHandles<TestVertexHandle>(),
+        UnorderedRangeEquals(std::vector<TestVertexHandle>{
+          TestVertexHandle{{+16.0, +16.0, +16.0}},
+          TestVertexHandle{{+16.0, +16.0, +18.5}},
+          TestVertexHandle{{-16.0, -16.0, -16.0}},
+          TestVertexHandle{{-16.0, -16.0, -13.5}},
+        }));
+    }
+
+    SECTION("handles at negative coordinates are clumped")
+    {
+      // all vertices are negative; the top vertices -82 and -80.5 lie in the cells
+      // [-84, -81) and [-81, -78), and the bottom vertices -114 and -112.5 both lie in
+      // the cell [-114, -111)
+      auto negativeNode = BrushNode{translateBrush(
+        worldBounds,
+        brushBuilder.createCube(32.0, "material").value(),
+        {-100, -100, -98})};
+      auto closeNegativeNode = BrushNode{translateBrush(
+        worldBounds,
+        brushBuilder.createCube(32.0, "material").value(),
+        {-100, -100, -96.5})};
+      addNodeHandles(negativeNode);
+      addNodeHandles(closeNegativeNode);
+
+      manager.selectHandle(TestVertexHandle{{-84.0, -84.0, -82.0}});
+      manager.selectHandle(TestVertexHandle{{-116.0, -116.0, -114.0}});
+
+      CHECK(manager.selectedHandleCount<TestVertexHandle>() == 2u);
+      CHECK_THAT(
+        manager.selectedHandles<TestVertexHandle>(),
+        UnorderedRangeEquals(std::vector<TestVertexHandle>{
+          TestVertexHandle{{-84.0, -84.0, -82.0}},
+          TestVertexHandle{{-84.0, -84.0, -80.5}},
+          TestVertexHandle{{-116.0, -116.0, -114.0}},
+          TestVertexHandle{{-116.0, -116.0, -112.5}},
+        }));
+
+      SECTION("removing a handle splits the clump across the cell boundary")
+      {
+        removeNodeHandles(closeNegativeNode);
+
+        CHECK_THAT(
+          manager.selectedHandles<TestVertexHandle>(),
+          UnorderedRangeEquals(std::vector<TestVertexHandle>{
+            TestVertexHandle{{-84.0, -84.0, -82.0}},
+            TestVertexHandle{{-116.0, -116.0, -114.0}},
+          }));
+        CHECK(manager.handleCount<TestVertexHandle>() == 16u);
+      }
+    }
+  }
+
   SECTION("selectHandle")
   {
     SECTION("handles are selected")
@@ -22,6 +22,7 @@
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
+#include "mdl/CachedMapText.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
@@ -29,6 +30,7 @@
 #include "mdl/LayerNode.h"
 #include "mdl/LockState.h"
 #include "mdl/MapFormat.h"
+#include "mdl/MemoryUsage.h"
 #include "mdl/NodeWriter.h"
 #include "mdl/PatchNode.h"
 #include "mdl/TestUtils.h"
@@ -40,7 +42,11 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <memory>
+#include <optional>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -1364,6 +1370,247 @@ some_material
 
     CHECK(actual == expected);
   }
+
+  SECTION("writeMapReusesCachedText")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+
+    auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+    auto* brushNode = new BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+    worldNode.defaultLayer()->addChild(brushNode);
+
+    // clang-format off
+    auto* patchNode = new PatchNode{BezierPatch{3, 3, {
+      {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+      {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+      {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "some_material"}};
+    // clang-format on
+    worldNode.defaultLayer()->addChild(patchNode);
+
+    const auto writeMap =
+      [&](const std::optional<size_t> maxCachedMapTextSize = MaxCachedMapTextSize) {
+        auto str = std::stringstream{};
+        auto writer = NodeWriter{worldNode, str};
+        writer.setMaxCachedMapTextSize(maxCachedMapTextSize);
+        writer.writeMap(taskManager);
+        return str.str();
+      };
+
+    REQUIRE(brushNode->cachedMapText() == nullptr);
+    REQUIRE(patchNode->cachedMapText() == nullptr);
+
+    const auto expected = writeMap();
+
+    SECTION("Brushes and patches keep the text that was written")
+    {
+      REQUIRE(brushNode->cachedMapText() != nullptr);
+      CHECK(brushNode->cachedMapText()->format == MapFormat::Standard);
+      CHECK(brushNode->cachedMapText()->lineCount == 6);
+      CHECK(
+        brushNode->cachedMapText()->text
+        == R"(( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+)");
+
+      REQUIRE(patchNode->cachedMapText() != nullptr);
+      CHECK(patchNode->cachedMapText()->format == MapFormat::Standard);
+      CHECK(patchNode->cachedMapText()->lineCount == 12);
+
+      CHECK(writeMap() == expected);
+    }
+
+    SECTION("Cached text is written instead of serializing the node again")
+    {
+      brushNode->setCachedMapText(std::make_shared<CachedMapText>(
+        CachedMapText{MapFormat::Standard, "cached\n", 1}));
+
+      CHECK(writeMap().find("// brush 0\n{\ncached\n}\n") != std::string::npos);
+    }
+
+    SECTION("Cached text of another format is ignored")
+    {
+      brushNode->setCachedMapText(
+        std::make_shared<CachedMapText>(CachedMapText{MapFormat::Valve, "cached\n", 1}));
+
+      CHECK(writeMap() == expected);
+      CHECK(brushNode->cachedMapText()->format == MapFormat::Standard);
+    }
+
+    SECTION("Changing a brush discards its cached text")
+    {
+      brushNode->setBrush(builder.createCube(32.0, "none") | kdl::value());
+      CHECK(brushNode->cachedMapText() == nullptr);
+
+      const auto actual = writeMap();
+      CHECK(
+        actual.find("( -16 -16 -16 ) ( -16 -15 -16 ) ( -16 -16 -15 )")
+        != std::string::npos);
+      CHECK(actual.find("( -32 -32 -32 )") == std::string::npos);
+    }
+
+    SECTION("Changing a patch discards its cached text")
+    {
+      auto patch = patchNode->patch();
+      patch.setMaterialName("other_material");
+      patchNode->setPatch(std::move(patch));
+      CHECK(patchNode->cachedMapText() == nullptr);
+
+      CHECK(writeMap().find("other_material") != std::string::npos);
+    }
+
+    SECTION("Clones share the cached text")
+    {
+      auto clone = std::unique_ptr<Node>{brushNode->clone(worldBounds)};
+      CHECK(clone->cachedMapText() == brushNode->cachedMapText());
+    }
+
+    SECTION("Nodes written after the limit is reached release their text")
+    {
+      const auto patchMemoryUsage = memoryUsage(*patchNode);
+      const auto brushTextSize = brushNode->cachedMapText()->text.size();
+
+      CHECK(writeMap(brushTextSize) == expected);
+      CHECK(brushNode->cachedMapText() != nullptr);
+      CHECK(patchNode->cachedMapText() == nullptr);
+      CHECK(memoryUsage(*patchNode) < patchMemoryUsage);
+    }
+
+    SECTION("Cached text is left as it is if there is no limit")
+    {
+      brushNode->setCachedMapText(nullptr);
+      const auto patchText = patchNode->cachedMapText();
+
+      CHECK(writeMap(std::nullopt) == expected);
+      CHECK(brushNode->cachedMapText() == nullptr);
+      CHECK(patchNode->cachedMapText() == patchText);
+    }
+  }
+
+  SECTION("writeLargeMap")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+    auto builder = BrushBuilder{worldNode.mapFormat(), worldBounds};
+
+    auto brushNo = 0;
+    const auto createBrushNode = [&]() {
+      const auto min = vm::vec3d{double(brushNo % 64), double(brushNo / 64), 0} * 64.0;
+      auto* brushNode = new BrushNode{
+        builder.createCuboid(
+          vm::bbox3d{min, min + vm::vec3d{32, 32, 32}}, fmt::format("brush{}", brushNo))
+        | kdl::value()};
+      ++brushNo;
+      return brushNode;
+    };
+
+    // clang-format off
+    const auto createPatchNode = [&]() {
+      return new PatchNode{BezierPatch{3, 3, {
+        {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+        {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+        {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, fmt::format("patch{}", brushNo++)}};
+    };
+    // clang-format on
+
+    const auto addNodes = [&](Node& parentNode) {
+      for (size_t i = 0; i < 100; ++i)
+      {
+        auto* entityNode = new EntityNode{Entity{{
+          {"classname", i % 10 == 0 ? "info_detail" : "func_detail"},
+        }}};
+        entityNode->addChildren(
+          {createBrushNode(), createPatchNode(), createBrushNode()});
+        parentNode.addChild(entityNode);
+
+        parentNode.addChild(createBrushNode());
+      }
+
+      auto* outerGroupNode = new GroupNode{Group{"Outer"}};
+      auto* innerGroupNode = new GroupNode{Group{"Inner"}};
+      innerGroupNode->addChildren({createBrushNode(), createBrushNode()});
+      outerGroupNode->addChildren({createBrushNode(), innerGroupNode, createBrushNode()});
+      parentNode.addChild(outerGroupNode);
+    };
+
+    addNodes(*worldNode.defaultLayer());
+
+    auto* layerNode = new LayerNode{Layer{"Custom Layer"}};
+    addNodes(*layerNode);
+    worldNode.addChild(layerNode);
+
+    auto* omittedLayerNode = new LayerNode{Layer{"Omitted Layer"}};
+    auto omittedLayer = omittedLayerNode->layer();
+    omittedLayer.setOmitFromExport(true);
+    omittedLayerNode->setLayer(std::move(omittedLayer));
+    addNodes(*omittedLayerNode);
+    worldNode.addChild(omittedLayerNode);
+
+    const auto write = [&](const size_t concurrency, const auto& configure) {
+      auto taskManager_ = kdl::task_manager{concurrency};
+      auto str = std::stringstream{};
+      auto writer = NodeWriter{worldNode, str};
+      configure(writer, taskManager_);
+      return str.str();
+    };
+
+    const auto writeWithAllConcurrencies = [&](const auto& configure) {
+      const auto expected = write(0, configure);
+      CHECK(write(1, configure) == expected);
+      CHECK(write(4, configure) == expected);
+      return expected;
+    };
+
+    SECTION("Writing the map")
+    {
+      const auto actual = writeWithAllConcurrencies(
+        [](auto& writer, auto& taskManager_) { writer.writeMap(taskManager_); });
+
+      // every brush and patch is written exactly once
+      const auto count = [&](const auto& str) {
+        auto result = 0;
+        for (auto pos = actual.find(str); pos != std::string::npos;
+             pos = actual.find(str, pos + 1))
+        {
+          ++result;
+        }
+        return result;
+      };
+
+      for (auto i = 0; i < brushNo; ++i)
+      {
+        const auto faceCount = count(fmt::format(" brush{} ", i));
+        const auto patchCount = count(fmt::format("\npatch{}\n", i));
+        CHECK(
+          ((faceCount == 6 && patchCount == 0) || (faceCount == 0 && patchCount == 1)));
+      }
+    }
+
+    SECTION("Exporting the map and stripping entities")
+    {
+      writeWithAllConcurrencies([](auto& writer, auto& taskManager_) {
+        writer.setExporting(true);
+        writer.setStripEntityPattern("info_*");
+        writer.writeMap(taskManager_);
+      });
+    }
+
+    SECTION("Writing nodes")
+    {
+      auto nodes = worldNode.defaultLayer()->children();
+      std::ranges::reverse(nodes);
+
+      writeWithAllConcurrencies([&](auto& writer, auto& taskManager_) {
+        writer.writeNodes(nodes, taskManager_);
+      });
+    }
+  }
 }
 
 } // namespace tb::mdl
@@ -20,6 +20,9 @@
 #include "mdl/CatchConfig.h"
 #include "mdl/Octree.h"
 
+#include <limits>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -682,6 +685,87 @@ TEST_CASE("octree")
     }
   }
 
+  SECTION("visit_intersectors")
+  {
+    auto tree = octree<double, int>{32.0};
+
+    const auto ray = vm::ray3d{{0, 16, 16}, {1, 0, 0}};
+    auto visited = std::vector<int>{};
+
+    SECTION("empty tree")
+    {
+      tree.visit_intersectors(ray, [&](const int i) {
+        visited.push_back(i);
+        return std::numeric_limits<double>::max();
+      });
+      CHECK(visited.empty());
+    }
+
+    SECTION("multiple nodes")
+    {
+      REQUIRE(tree.insert({{256, 0, 0}, {288, 32, 32}}, 1));
+      REQUIRE(tree.insert({{64, 0, 0}, {96, 32, 32}}, 2));
+      REQUIRE(tree.insert({{512, 0, 0}, {544, 32, 32}}, 3));
+      REQUIRE(tree.insert({{64, 64, 0}, {96, 96, 32}}, 4));
+
+      SECTION("visits intersectors front to back")
+      {
+        tree.visit_intersectors(ray, [&](const int i) {
+          visited.push_back(i);
+          return std::numeric_limits<double>::max();
+        });
+        CHECK(visited == std::vector<int>{2, 1, 3});
+      }
+
+      SECTION("stops at the returned distance")
+      {
+        tree.visit_intersectors(ray, [&](const int i) {
+          visited.push_back(i);
+          return 300.0;
+        });
+        CHECK(visited == std::vector<int>{2, 1});
+      }
+    }
+  }
+
+  SECTION("find_in_frustum")
+  {
+    auto tree = octree<double, int>{32.0};
+
+    SECTION("empty tree")
+    {
+      CHECK(tree.find_in_frustum({vm::plane3d{16.0, vm::vec3d{1, 0, 0}}}).empty());
+    }
+
+    SECTION("single node")
+    {
+      REQUIRE(tree.insert({{32, 32, 32}, {64, 64, 64}}, 1));
+
+      // the leaf that contains the data is outside of one plane
+      CHECK(tree
+              .find_in_frustum({
+                vm::plane3d{64.0, vm::vec3d{0, 1, 0}},
+                vm::plane3d{16.0, vm::vec3d{1, 0, 0}},
+              })
+              .empty());
+      CHECK(tree.find_in_frustum({vm::plane3d{-80.0, vm::vec3d{-1, 0, 0}}}).empty());
+
+      // the leaf that contains the data is inside of all planes
+      CHECK(
+        tree.find_in_frustum({
+          vm::plane3d{128.0, vm::vec3d{1, 0, 0}},
+          vm::plane3d{128.0, vm::vec3d{0, 1, 0}},
+          vm::plane3d{128.0, vm::vec3d{0, 0, 1}},
+        })
+        == std::vector<int>{1});
+
+      // the leaf that contains the data straddles a plane
+      CHECK(
+        tree.find_in_frustum({vm::plane3d{48.0, vm::vec3d{1, 0, 0}}})
+        == std::vector<int>{1});
+    }
+  }
+
   SECTION("find_containers")
   {
     auto tree = octree<double, int>{32.0};
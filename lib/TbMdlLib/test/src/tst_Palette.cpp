@@ -20,19 +20,147 @@
 #include "TestEnvironment.h"
 #include "base/Result.h"
 #include "fs/DiskIO.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+#include "gl/TextureBuffer.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Palette.h"
 
 #include "kd/result.h"
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
 namespace tb::mdl
 {
+namespace
+{
+
+/**
+ * The straightforward implementation of Palette::indexedToRgba that the optimized
+ * implementation must match bit for bit.
+ */
+bool indexedToRgbaReference(
+  const std::vector<unsigned char>& paletteData,
+  fs::Reader& reader,
+  const size_t pixelCount,
+  gl::TextureBuffer& rgbaImage,
+  const PaletteTransparency transparency,
+  Color& averageColor)
+{
+  auto* const rgbaData = rgbaImage.data();
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    const auto index = size_t(reader.readUnsignedChar<unsigned char>());
+    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+  }
+
+  uint32_t colorSum[3] = {0, 0, 0};
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
+    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
+    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+  }
+  averageColor = RgbaF{
+    float(colorSum[0]) / (255.0f * float(pixelCount)),
+    float(colorSum[1]) / (255.0f * float(pixelCount)),
+    float(colorSum[2]) / (255.0f * float(pixelCount)),
+    1.0f};
+
+  unsigned char andAlpha = 0xFF;
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
+  }
+  return transparency == PaletteTransparency::Index255Transparent && andAlpha != 0xFF;
+}
+
+} // namespace
 
 TEST_CASE("Palette")
 {
+  SECTION("indexedToRgba")
+  {
+    auto rng = std::mt19937{};
+
+    auto rgbData = std::vector<unsigned char>{};
+    auto opaqueData = std::vector<unsigned char>{};
+    for (size_t i = 0; i < 256; ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        const auto c = static_cast<unsigned char>(rng());
+        rgbData.push_back(c);
+        opaqueData.push_back(c);
+      }
+      opaqueData.push_back(0xFF);
+    }
+
+    auto index255TransparentData = opaqueData;
+    index255TransparentData.back() = 0;
+
+    const auto palette = makePalette(rgbData, PaletteColorFormat::Rgb) | kdl::value();
+
+    const auto pixelCount =
+      size_t(GENERATE(1u, 3u, 16u, 17u, 64u * 64u, 256u * 256u + 5u));
+    const auto transparency = GENERATE(
+      PaletteTransparency::Opaque, PaletteTransparency::Index255Transparent);
+    const auto maxIndex = GENERATE(254u, 255u);
+    const auto runLength = size_t(GENERATE(1u, 7u));
+
+    CAPTURE(pixelCount, transparency, maxIndex, runLength);
+
+    auto indices = std::string(pixelCount, '\0');
+    for (size_t i = 0; i < pixelCount; i += runLength)
+    {
+      const auto index = static_cast<char>(rng() % (maxIndex + 1));
+      for (size_t j = i; j < std::min(i + runLength, pixelCount); ++j)
+      {
+        indices[j] = index;
+      }
+    }
+
+    auto reader = fs::Reader::from(indices.data(), indices.data() + indices.size());
+    auto rgbaImage = gl::TextureBuffer{4 * pixelCount};
+    auto averageColor = Color{};
+    const auto hasTransparency =
+      palette.indexedToRgba(reader, pixelCount, rgbaImage, transparency, averageColor);
+
+    auto expectedReader =
+      fs::Reader::from(indices.data(), indices.data() + indices.size());
+    auto expectedRgbaImage = gl::TextureBuffer{4 * pixelCount};
+    auto expectedAverageColor = Color{};
+    const auto expectedHasTransparency = indexedToRgbaReference(
+      transparency == PaletteTransparency::Opaque ? opaqueData : index255TransparentData,
+      expectedReader,
+      pixelCount,
+      expectedRgbaImage,
+      transparency,
+      expectedAverageColor);
+
+    CHECK(hasTransparency == expectedHasTransparency);
+    CHECK(averageColor == expectedAverageColor);
+    CHECK(
+      std::memcmp(rgbaImage.data(), expectedRgbaImage.data(), rgbaImage.size()) == 0);
+    CHECK(reader.eof());
+
+    SECTION("throws if there are not enough indices")
+    {
+      auto shortReader =
+        fs::Reader::from(indices.data(), indices.data() + indices.size() - 1);
+      CHECK_THROWS_AS(
+        palette.indexedToRgba(
+          shortReader, pixelCount, rgbaImage, transparency, averageColor),
+        fs::ReaderException);
+    }
+  }
+
   SECTION("makePalette")
   {
     using T =
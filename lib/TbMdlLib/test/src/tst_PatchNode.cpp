@@ -26,8 +26,12 @@
 #include "kd/contracts.h"
 
 #include "vm/approx.h"
+#include "vm/intersection.h"
+#include "vm/ray.h"
+#include "vm/ray_io.h" // IWYU pragma: keep
 #include "vm/vec.h"
 
+#include <optional>
 #include <ranges>
 
 #include <catch2/catch_test_macros.hpp>
@@ -169,6 +173,91 @@ TEST_CASE("makePatchGrid")
                 })));
 }
 
+TEST_CASE("makePatchGridBvh")
+{
+  using P = BezierPatch::Point;
+
+  // clang-format off
+  const auto patch = BezierPatch{3, 5, {
+    P{0.0, 0.0,  0.0}, P{2.0, 0.0,  4.0}, P{4.0, 0.0, 0.0}, P{6.0, 0.0, -4.0}, P{8.0, 0.0, 0.0},
+    P{0.0, 4.0,  8.0}, P{2.0, 4.0, 12.0}, P{4.0, 4.0, 8.0}, P{6.0, 4.0,  4.0}, P{8.0, 4.0, 8.0},
+    P{0.0, 8.0, 16.0}, P{2.0, 8.0, 20.0}, P{4.0, 8.0, 16.0}, P{6.0, 8.0, 12.0}, P{8.0, 8.0, 16.0},
+  }, "material"};
+  // clang-format on
+
+  const auto grid = makePatchGrid(patch, 3);
+  const auto bvh = makePatchGridBvh(grid);
+
+  SECTION("The root cell contains the grid")
+  {
+    REQUIRE(!bvh.cells.empty());
+    CHECK(bvh.cells.front().bounds.contains(grid.bounds));
+  }
+
+  SECTION("Every quad is covered by exactly one leaf cell")
+  {
+    auto quadCount = size_t(0);
+    for (const auto& cell : bvh.cells)
+    {
+      if (cell.secondChild == 0u)
+      {
+        quadCount += (cell.rowEnd - cell.rowBegin) * (cell.columnEnd - cell.columnBegin);
+      }
+    }
+    CHECK(quadCount == grid.quadRowCount() * grid.quadColumnCount());
+  }
+
+  SECTION("intersect finds the closest hit")
+  {
+    const auto intersectAllQuads = [&](const vm::ray3d& ray) {
+      auto result = std::optional<double>{};
+      for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+      {
+        for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
+        {
+          const auto& v0 = grid.point(row, col).position;
+          const auto& v1 = grid.point(row, col + 1u).position;
+          const auto& v2 = grid.point(row + 1u, col + 1u).position;
+          const auto& v3 = grid.point(row + 1u, col).position;
+
+          for (const auto distance :
+               {vm::intersect_ray_triangle(ray, v0, v1, v2),
+                vm::intersect_ray_triangle(ray, v2, v3, v0)})
+          {
+            if (distance && (!result || *distance < *result))
+            {
+              result = distance;
+            }
+          }
+        }
+      }
+      return result;
+    };
+
+    for (double x = -1.0; x <= 9.0; x += 0.75)
+    {
+      for (double y = -1.0; y <= 9.0; y += 0.75)
+      {
+        for (const auto& ray :
+             {vm::ray3d{vm::vec3d{x, y, 32.0}, vm::vec3d{0, 0, -1}},
+              vm::ray3d{vm::vec3d{x, y, -32.0}, vm::vec3d{0, 0, 1}},
+              vm::ray3d{vm::vec3d{-4.0, y, x}, vm::vec3d{1, 0, 0}}})
+        {
+          CAPTURE(ray);
+
+          const auto expected = intersectAllQuads(ray);
+          const auto actual = bvh.intersect(ray, grid);
+          REQUIRE(actual.has_value() == expected.has_value());
+          if (expected)
+          {
+            CHECK(*actual == vm::approx{*expected});
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST_CASE("PatchNode")
 {
   SECTION("pick")
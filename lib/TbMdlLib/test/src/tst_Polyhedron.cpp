@@ -23,6 +23,8 @@
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
+#include "kd/range_utils.h"
+
 #include "vm/approx.h"
 #include "vm/ray.h"
 #include "vm/vec.h"
@@ -880,6 +882,87 @@ TEST_CASE("Polyhedron")
     }
   }
 
+  SECTION("fromFaces")
+  {
+    const auto p1 = vm::vec3d{-8, -8, -8};
+    const auto p2 = vm::vec3d{-8, -8, +8};
+    const auto p3 = vm::vec3d{-8, +8, -8};
+    const auto p4 = vm::vec3d{-8, +8, +8};
+    const auto p5 = vm::vec3d{+8, -8, -8};
+    const auto p6 = vm::vec3d{+8, -8, +8};
+    const auto p7 = vm::vec3d{+8, +8, -8};
+    const auto p8 = vm::vec3d{+8, +8, +8};
+
+    const auto cube = Polyhedron3d{p1, p2, p3, p4, p5, p6, p7, p8};
+
+    auto positions = std::vector<vm::vec3d>{};
+    for (const auto* vertex : cube.vertices())
+    {
+      positions.push_back(vertex->position());
+    }
+
+    auto faceVertexIndices = std::vector<std::vector<size_t>>{};
+    auto facePlanes = std::vector<vm::plane3d>{};
+    for (const auto* face : cube.faces())
+    {
+      auto vertexIndices = std::vector<size_t>{};
+      for (const auto* halfEdge : face->boundary())
+      {
+        vertexIndices.push_back(
+          *kdl::index_of(positions, halfEdge->origin()->position()));
+      }
+      faceVertexIndices.push_back(std::move(vertexIndices));
+      facePlanes.push_back(face->plane());
+    }
+
+    SECTION("With the faces of a cube")
+    {
+      const auto p = Polyhedron3d::fromFaces(positions, faceVertexIndices, facePlanes);
+      REQUIRE(p != std::nullopt);
+
+      CHECK(p->closed());
+      CHECK(*p == cube);
+      CHECK(p->bounds() == cube.bounds());
+      CHECK(hasFaces(
+        *p,
+        {{p1, p5, p6, p2},
+         {p3, p1, p2, p4},
+         {p7, p3, p4, p8},
+         {p5, p7, p8, p6},
+         {p3, p7, p5, p1},
+         {p2, p6, p8, p4}}));
+    }
+
+    SECTION("With a missing face")
+    {
+      faceVertexIndices.pop_back();
+      facePlanes.pop_back();
+      CHECK(Polyhedron3d::fromFaces(positions, faceVertexIndices, facePlanes)
+            == std::nullopt);
+    }
+
+    SECTION("With an unused vertex")
+    {
+      positions.push_back(vm::vec3d{16, 16, 16});
+      CHECK(Polyhedron3d::fromFaces(positions, faceVertexIndices, facePlanes)
+            == std::nullopt);
+    }
+
+    SECTION("With an invalid vertex index")
+    {
+      faceVertexIndices.front().front() = positions.size();
+      CHECK(Polyhedron3d::fromFaces(positions, faceVertexIndices, facePlanes)
+            == std::nullopt);
+    }
+
+    SECTION("With a reversed face")
+    {
+      std::ranges::reverse(faceVertexIndices.front());
+      CHECK(Polyhedron3d::fromFaces(positions, faceVertexIndices, facePlanes)
+            == std::nullopt);
+    }
+  }
+
   SECTION("clip")
   {
     SECTION("With a horizontal plane through the center of a cube")
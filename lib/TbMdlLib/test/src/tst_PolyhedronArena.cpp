@@ -0,0 +1,262 @@
+/*
+ Copyright (C) 2010 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Polyhedron.h"
+#include "mdl/PolyhedronArena.h"
+#include "mdl/Polyhedron_DefaultPayload.h"
+#include "mdl/Polyhedron_Instantiation.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+#include "vm/vec.h"
+
+#include <optional>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+using Polyhedron3d =
+  Polyhedron<double, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
+
+struct Element : public PolyhedronArenaElement
+{
+  double value;
+
+  explicit Element(const double i_value)
+    : value{i_value}
+  {
+  }
+};
+
+} // namespace
+
+TEST_CASE("PolyhedronArena")
+{
+  SECTION("allocate")
+  {
+    auto arena = PolyhedronArena::create();
+    CHECK(arena->blockCount() == 0);
+    CHECK(arena->allocatedBytes() == 0);
+
+    auto* e1 = new (*arena) Element{1.0};
+    auto* e2 = new (*arena) Element{2.0};
+    CHECK(arena->blockCount() == 1);
+    CHECK(arena->allocatedBytes() > PolyhedronArena::DefaultBlockSize);
+    CHECK(&PolyhedronArena::of(e1) == arena.get());
+    CHECK(&PolyhedronArena::of(e2) == arena.get());
+    CHECK(e2 != e1);
+
+    delete e1;
+    delete e2;
+  }
+
+  SECTION("freed memory is reused")
+  {
+    auto arena = PolyhedronArena::create();
+
+    auto* e1 = new (*arena) Element{1.0};
+    auto* e2 = new (*arena) Element{2.0};
+    auto* address = static_cast<void*>(e1);
+    delete e1;
+
+    auto* e3 = new (*arena) Element{3.0};
+    CHECK(static_cast<void*>(e3) == address);
+    CHECK(e3->value == 3.0);
+    CHECK(e2->value == 2.0);
+
+    delete e2;
+    delete e3;
+  }
+
+  SECTION("arena grows")
+  {
+    auto arena = PolyhedronArena::create();
+
+    const auto count =
+      PolyhedronArena::DefaultBlockSize / PolyhedronArena::slotSize(sizeof(Element)) + 1;
+    auto elements = std::vector<Element*>{};
+    for (size_t i = 0; i < count; ++i)
+    {
+      elements.push_back(new (*arena) Element{double(i)});
+    }
+    CHECK(arena->blockCount() == 2);
+    CHECK(arena->allocatedBytes() > 3 * PolyhedronArena::DefaultBlockSize);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      CHECK(elements[i]->value == double(i));
+      delete elements[i];
+    }
+  }
+
+  SECTION("reserve")
+  {
+    auto arena = PolyhedronArena::create();
+
+    const auto count = size_t(1000);
+    arena->reserve(count * PolyhedronArena::slotSize(sizeof(Element)));
+    CHECK(arena->blockCount() == 1);
+
+    auto elements = std::vector<Element*>{};
+    for (size_t i = 0; i < count; ++i)
+    {
+      elements.push_back(new (*arena) Element{double(i)});
+    }
+    CHECK(arena->blockCount() == 1);
+
+    for (auto* element : elements)
+    {
+      delete element;
+    }
+  }
+
+  SECTION("elements keep their arena alive")
+  {
+    auto arena = PolyhedronArena::create();
+    auto* element = new (*arena) Element{1.0};
+    arena.reset();
+
+    CHECK(PolyhedronArena::of(element).blockCount() == 1);
+    CHECK(element->value == 1.0);
+    delete element;
+  }
+}
+
+TEST_CASE("Polyhedron.arena")
+{
+  const auto cube = Polyhedron3d{vm::bbox3d{{-8, -8, -8}, {8, 8, 8}}};
+
+  SECTION("all elements are allocated from the same arena")
+  {
+    auto polyhedron = cube;
+    REQUIRE(polyhedron
+              .clip(vm::plane3d{vm::vec3d{0, 0, 4}, vm::normalize(vm::vec3d{1, 1, 1})})
+              .success());
+
+    const auto& arena = PolyhedronArena::of(polyhedron.vertices().front());
+    for (const auto* vertex : polyhedron.vertices())
+    {
+      CHECK(&PolyhedronArena::of(vertex) == &arena);
+    }
+    for (const auto* edge : polyhedron.edges())
+    {
+      CHECK(&PolyhedronArena::of(edge) == &arena);
+      CHECK(&PolyhedronArena::of(edge->firstEdge()) == &arena);
+      CHECK(&PolyhedronArena::of(edge->secondEdge()) == &arena);
+    }
+    for (const auto* face : polyhedron.faces())
+    {
+      CHECK(&PolyhedronArena::of(face) == &arena);
+    }
+  }
+
+  SECTION("copies are allocated in a single block")
+  {
+    auto original = cube;
+    REQUIRE(original
+              .clip(vm::plane3d{vm::vec3d{0, 0, 4}, vm::normalize(vm::vec3d{1, 1, 1})})
+              .success());
+
+    const auto copy = original;
+    const auto& arena = PolyhedronArena::of(copy.vertices().front());
+    CHECK(&arena != &PolyhedronArena::of(original.vertices().front()));
+    CHECK(arena.blockCount() == 1);
+    CHECK(copy == original);
+  }
+
+  SECTION("allocatedBytes")
+  {
+    CHECK(Polyhedron3d{}.allocatedBytes() == 0);
+    CHECK(
+      cube.allocatedBytes()
+      == PolyhedronArena::of(cube.vertices().front()).allocatedBytes());
+    CHECK(cube.allocatedBytes() > 0);
+  }
+
+  SECTION("copies outlive the original")
+  {
+    auto copy = std::optional<Polyhedron3d>{};
+    {
+      auto original = cube;
+      copy = original;
+      original = Polyhedron3d{};
+    }
+
+    CHECK(*copy == cube);
+  }
+
+  SECTION("edge polyhedra free all of their elements")
+  {
+    // two vertices, one edge and two half edges that are not owned by a face
+    const auto elementCount = size_t(5);
+
+    auto edge = Polyhedron3d{vm::vec3d{0, 0, 0}, vm::vec3d{8, 0, 0}};
+    REQUIRE(edge.edge());
+
+    auto& arena = PolyhedronArena::of(edge.vertices().front());
+    REQUIRE(arena.referenceCount() == elementCount + 1);
+
+    SECTION("clear")
+    {
+      edge.clear();
+      CHECK(arena.referenceCount() == 1);
+    }
+
+    SECTION("destructor")
+    {
+      // keeps the arena alive after the polyhedron was destroyed
+      auto* element = new (arena) Element{1.0};
+      {
+        [[maybe_unused]] auto destroyed = std::move(edge);
+      }
+
+      CHECK(arena.referenceCount() == 1);
+      delete element;
+    }
+
+    SECTION("copy and move assignment")
+    {
+      auto copy = Polyhedron3d{edge};
+      auto& copyArena = PolyhedronArena::of(copy.vertices().front());
+      REQUIRE(copyArena.referenceCount() == elementCount + 1);
+
+      auto* element = new (copyArena) Element{1.0};
+      copy = Polyhedron3d{};
+
+      CHECK(copyArena.referenceCount() == 1);
+      delete element;
+    }
+  }
+
+  SECTION("moved polyhedra keep their arena")
+  {
+    auto original = cube;
+    const auto& arena = PolyhedronArena::of(original.vertices().front());
+
+    auto moved = std::move(original);
+    CHECK(&PolyhedronArena::of(moved.vertices().front()) == &arena);
+    CHECK(moved == cube);
+  }
+}
+
+} // namespace tb::mdl
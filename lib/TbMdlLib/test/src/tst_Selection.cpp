@@ -37,6 +37,9 @@
 
 #include "kd/result.h"
 
+#include "vm/bbox.h"
+
+#include <optional>
 #include <ostream>
 #include <vector>
 
@@ -511,6 +514,27 @@ TEST_CASE("Selection")
       CHECK_THAT(
         map.selection().allBrushes(), UnorderedEquals(std::vector<BrushNode*>{}));
     }
+
+    SECTION("cached brushes are updated when the selection changes")
+    {
+      selectNodes(map, {entityNode});
+      REQUIRE(map.selection().allBrushes().empty());
+
+      selectNodes(map, {brushNode});
+      CHECK_THAT(
+        map.selection().allBrushes(),
+        UnorderedEquals(std::vector<BrushNode*>{brushNode}));
+
+      selectNodes(map, {entityBrushNode});
+      CHECK_THAT(
+        map.selection().allBrushes(),
+        UnorderedEquals(std::vector<BrushNode*>{brushNode, entityBrushNode}));
+
+      deselectNodes(map, {brushNode});
+      CHECK_THAT(
+        map.selection().allBrushes(),
+        UnorderedEquals(std::vector<BrushNode*>{entityBrushNode}));
+    }
   }
 
   SECTION("allBrushFaces")
@@ -535,6 +559,25 @@ TEST_CASE("Selection")
       CHECK(map.selection().allBrushFaces().size() == 6);
     }
   }
+
+  SECTION("selectionBounds")
+  {
+    CHECK(map.selectionBounds() == std::nullopt);
+
+    selectNodes(map, {patchNode});
+    CHECK(map.selectionBounds() == patchNode->logicalBounds());
+
+    selectNodes(map, {entityNode});
+    CHECK(
+      map.selectionBounds()
+      == vm::merge(patchNode->logicalBounds(), entityNode->logicalBounds()));
+
+    deselectNodes(map, {entityNode});
+    CHECK(map.selectionBounds() == patchNode->logicalBounds());
+
+    deselectAll(map);
+    CHECK(map.selectionBounds() == std::nullopt);
+  }
 }
 
 } // namespace tb::mdl
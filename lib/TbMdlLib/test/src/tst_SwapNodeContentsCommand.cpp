@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/MapFixture.h"
+#include "mdl/MapFormat.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/MemoryUsage.h"
+#include "mdl/NodeContents.h"
+#include "mdl/SwapNodeContentsCommand.h"
+#include "mdl/TestFactory.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+Brush changeUv(Brush brush, const size_t faceIndex)
+{
+  auto& face = brush.face(faceIndex);
+  face.rotateUv(15.0f);
+
+  auto surfaceAttributes = face.surfaceAttributes();
+  surfaceAttributes.value = 2.0f;
+  face.setSurfaceAttributes(surfaceAttributes);
+
+  return brush;
+}
+
+Brush changeGeometry(Brush brush)
+{
+  REQUIRE(brush.transform(
+    vm::bbox3d{8192.0}, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+  return brush;
+}
+
+void checkFacesEqual(const Brush& actual, const Brush& expected)
+{
+  REQUIRE(actual.faceCount() == expected.faceCount());
+  for (size_t i = 0; i < actual.faceCount(); ++i)
+  {
+    const auto& actualFace = actual.face(i);
+    const auto& expectedFace = expected.face(i);
+    CHECK(actualFace.points() == expectedFace.points());
+    CHECK(actualFace.uvCoordSystem() == expectedFace.uvCoordSystem());
+    CHECK(actualFace.materialName() == expectedFace.materialName());
+    CHECK(actualFace.surfaceAttributes() == expectedFace.surfaceAttributes());
+  }
+  CHECK(actual == expected);
+}
+
+} // namespace
+
+TEST_CASE("SwapNodeContentsCommand")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create({.mapFormat = MapFormat::Valve});
+
+  auto* brushNode = createBrushNode(map);
+  addNodes(map, {{&parentForNodes(map), {brushNode}}});
+
+  const auto original = brushNode->brush();
+
+  SECTION("A change of face attributes is undone and redone exactly")
+  {
+    const auto changed = changeUv(original, 0);
+    REQUIRE(changed != original);
+
+    auto command =
+      SwapNodeContentsCommand{"Change UV", {{brushNode, NodeContents{changed}}}};
+
+    REQUIRE(command.performDo(map));
+    checkFacesEqual(brushNode->brush(), changed);
+
+    // the replaced brush is stored as a delta
+    CHECK(command.memoryUsage() < memoryUsage(original));
+
+    REQUIRE(command.performUndo(map));
+    checkFacesEqual(brushNode->brush(), original);
+    CHECK(command.memoryUsage() < memoryUsage(original));
+
+    REQUIRE(command.performDo(map));
+    checkFacesEqual(brushNode->brush(), changed);
+  }
+
+  SECTION("Collated changes of face attributes are undone to the original brush")
+  {
+    const auto firstChanged = changeUv(original, 0);
+    const auto secondChanged = changeUv(firstChanged, 1);
+
+    auto firstCommand =
+      SwapNodeContentsCommand{"Change UV", {{brushNode, NodeContents{firstChanged}}}};
+    auto secondCommand =
+      SwapNodeContentsCommand{"Change UV", {{brushNode, NodeContents{secondChanged}}}};
+
+    REQUIRE(firstCommand.performDo(map));
+    REQUIRE(secondCommand.performDo(map));
+    REQUIRE(firstCommand.collateWith(secondCommand));
+    CHECK(firstCommand.memoryUsage() < memoryUsage(original));
+
+    REQUIRE(firstCommand.performUndo(map));
+    checkFacesEqual(brushNode->brush(), original);
+
+    REQUIRE(firstCommand.performDo(map));
+    checkFacesEqual(brushNode->brush(), secondChanged);
+  }
+
+  SECTION("A change of the geometry is stored as a full copy")
+  {
+    const auto changed = changeGeometry(original);
+
+    auto command =
+      SwapNodeContentsCommand{"Move", {{brushNode, NodeContents{changed}}}};
+
+    REQUIRE(command.performDo(map));
+    CHECK(command.memoryUsage() >= memoryUsage(original));
+
+    REQUIRE(command.performUndo(map));
+    checkFacesEqual(brushNode->brush(), original);
+  }
+
+  SECTION("Collating a change of face attributes with a change of the geometry")
+  {
+    const auto firstChanged = changeUv(original, 0);
+    const auto secondChanged = changeGeometry(firstChanged);
+
+    auto firstCommand =
+      SwapNodeContentsCommand{"Change UV", {{brushNode, NodeContents{firstChanged}}}};
+    auto secondCommand =
+      SwapNodeContentsCommand{"Move", {{brushNode, NodeContents{secondChanged}}}};
+
+    REQUIRE(firstCommand.performDo(map));
+    REQUIRE(secondCommand.performDo(map));
+    REQUIRE(firstCommand.collateWith(secondCommand));
+
+    // the original brush can no longer be stored as a delta of the moved brush
+    CHECK(firstCommand.memoryUsage() >= memoryUsage(original));
+
+    REQUIRE(firstCommand.performUndo(map));
+    checkFacesEqual(brushNode->brush(), original);
+
+    REQUIRE(firstCommand.performDo(map));
+    checkFacesEqual(brushNode->brush(), secondChanged);
+  }
+}
+
+} // namespace tb::mdl
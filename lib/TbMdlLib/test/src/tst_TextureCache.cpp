@@ -0,0 +1,263 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestEnvironment.h"
+#include "fs/DiskFileSystem.h"
+#include "fs/TestEnvironment.h"
+#include "gl/Texture.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/LoadImageTexture.h"
+#include "mdl/TextureCache.h"
+
+#include "kd/result.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+void checkTexturesEqual(const gl::Texture& lhs, const gl::Texture& rhs)
+{
+  CHECK(lhs.width() == rhs.width());
+  CHECK(lhs.height() == rhs.height());
+  CHECK(lhs.averageColor() == rhs.averageColor());
+  CHECK(lhs.format() == rhs.format());
+  CHECK(lhs.mask() == rhs.mask());
+  CHECK(lhs.embeddedDefaults() == rhs.embeddedDefaults());
+
+  const auto& lhsBuffers = lhs.buffersIfLoaded();
+  const auto& rhsBuffers = rhs.buffersIfLoaded();
+  REQUIRE(lhsBuffers.size() == rhsBuffers.size());
+  for (size_t i = 0; i < lhsBuffers.size(); ++i)
+  {
+    REQUIRE(lhsBuffers[i].size() == rhsBuffers[i].size());
+    CHECK(std::equal(
+      lhsBuffers[i].data(),
+      lhsBuffers[i].data() + lhsBuffers[i].size(),
+      rhsBuffers[i].data()));
+  }
+}
+
+} // namespace
+
+TEST_CASE("TextureCache")
+{
+  auto env = fs::TestEnvironment{};
+  auto diskFS =
+    fs::DiskFileSystem{getFixtureRoot() / "test" / "mdl" / "LoadImageTexture"};
+
+  const auto imagePath = std::filesystem::path{"alphaMaskTest.png"};
+  const auto absoluteImagePath = diskFS.makeAbsolute(imagePath) | kdl::value();
+  const auto imageTexture = diskFS.openFile(imagePath) | kdl::and_then([](auto file) {
+                              auto reader = file->reader().buffer();
+                              return loadImageTexture(reader);
+                            })
+                            | kdl::value();
+
+  SECTION("makeTextureCachePath")
+  {
+    const auto path = makeTextureCachePath(env.dir(), "textures/test.png");
+    CHECK(path.parent_path() == env.dir());
+    CHECK(path != makeTextureCachePath(env.dir(), "textures/other.png"));
+  }
+
+  SECTION("computeTextureCacheKey")
+  {
+    CHECK(computeTextureCacheKey("contents") == computeTextureCacheKey("contents"));
+    CHECK(computeTextureCacheKey("contents") != computeTextureCacheKey("other"));
+
+    const auto time = std::filesystem::file_time_type::clock::now();
+    CHECK(computeTextureCacheKey(8, time) == computeTextureCacheKey(8, time));
+    CHECK(computeTextureCacheKey(8, time) != computeTextureCacheKey(9, time));
+    CHECK(
+      computeTextureCacheKey(8, time)
+      != computeTextureCacheKey(8, time + std::chrono::seconds{1}));
+  }
+
+  SECTION("Writing and reading a cache")
+  {
+    const auto key = computeTextureCacheKey("some contents");
+    const auto path = makeTextureCachePath(env.dir(), absoluteImagePath);
+
+    REQUIRE(writeTextureCache(path, key, imageTexture).is_success());
+
+    SECTION("With the correct key")
+    {
+      const auto cachedTexture = readTextureCache(path, key) | kdl::value();
+      checkTexturesEqual(cachedTexture, imageTexture);
+    }
+
+    SECTION("With a stale key")
+    {
+      CHECK(readTextureCache(path, key + 1).is_error());
+    }
+
+    SECTION("With a corrupt header")
+    {
+      auto contents = env.loadFile(path);
+      contents[20] ^= 0x01;
+      env.createFile(path, contents);
+
+      CHECK(readTextureCache(path, key).is_error());
+    }
+
+    SECTION("With a truncated file")
+    {
+      const auto contents = env.loadFile(path);
+      env.createFile(path, contents.substr(0, contents.size() - 1));
+
+      CHECK(readTextureCache(path, key).is_error());
+    }
+  }
+
+  SECTION("Writing a texture that is not loaded")
+  {
+    auto texture = gl::Texture{4, 4};
+    const auto path = makeTextureCachePath(env.dir(), absoluteImagePath);
+
+    CHECK(writeTextureCache(path, 1, texture).is_error());
+  }
+
+  SECTION("loadImageTexture")
+  {
+    const auto textureCache = TextureCache{env.dir() / "TextureCache"};
+    const auto cachePath =
+      makeTextureCachePath(textureCache.cacheFolderPath(), absoluteImagePath);
+    REQUIRE(!env.fileExists(cachePath));
+
+    const auto texture = textureCache.loadImageTexture(diskFS, imagePath) | kdl::value();
+    checkTexturesEqual(texture, imageTexture);
+    CHECK(env.fileExists(cachePath));
+
+    SECTION("Loads the cached texture")
+    {
+      // replace the cache file with a valid cache file containing a different texture;
+      // the key of a file on disk depends on its size and modification time only
+      const auto key = computeTextureCacheKey(
+        std::filesystem::file_size(absoluteImagePath),
+        std::filesystem::last_write_time(absoluteImagePath));
+      const auto otherTexture = gl::Texture{
+        1,
+        1,
+        RgbaF{1, 0, 0, 1},
+        GL_RGBA,
+        gl::TextureMask::Off,
+        gl::NoEmbeddedDefaults{},
+        gl::TextureBuffer{4}};
+      REQUIRE(writeTextureCache(cachePath, key, otherTexture).is_success());
+
+      const auto cachedTexture =
+        textureCache.loadImageTexture(diskFS, imagePath) | kdl::value();
+      checkTexturesEqual(cachedTexture, otherTexture);
+    }
+
+    SECTION("Replaces a corrupt cache")
+    {
+      env.createFile(cachePath, "corrupt");
+
+      const auto reloadedTexture =
+        textureCache.loadImageTexture(diskFS, imagePath) | kdl::value();
+      checkTexturesEqual(reloadedTexture, imageTexture);
+      CHECK(env.loadFile(cachePath) != "corrupt");
+    }
+  }
+
+  SECTION("loadImageTexture with a disabled cache")
+  {
+    auto textureCache = TextureCache{env.dir() / "TextureCache"};
+    const auto cachePath =
+      makeTextureCachePath(textureCache.cacheFolderPath(), absoluteImagePath);
+
+    textureCache.setEnabled(false);
+    REQUIRE(!textureCache.enabled());
+
+    const auto texture = textureCache.loadImageTexture(diskFS, imagePath) | kdl::value();
+    checkTexturesEqual(texture, imageTexture);
+    CHECK(!env.fileExists(cachePath));
+  }
+
+  SECTION("trimTextureCache")
+  {
+    const auto cacheFolderPath = env.dir() / "TextureCache";
+    const auto now = std::filesystem::file_time_type::clock::now();
+    env.createDirectory(cacheFolderPath);
+
+    // the cache files are used in the order of their names
+    const auto cacheFileNames = std::vector<std::string>{"a.bin", "b.bin", "c.bin"};
+    for (size_t i = 0; i < cacheFileNames.size(); ++i)
+    {
+      const auto path = cacheFolderPath / cacheFileNames[i];
+      env.createFile(path, std::string(10, 'x'));
+      std::filesystem::last_write_time(
+        path, now - std::chrono::seconds{cacheFileNames.size() - i});
+    }
+    env.createFile(cacheFolderPath / "other.txt", std::string(100, 'x'));
+
+    SECTION("Keeps the cache files if they fit")
+    {
+      CHECK(trimTextureCache(cacheFolderPath, 30).is_success());
+      CHECK(env.fileExists(cacheFolderPath / "a.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "b.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "c.bin"));
+    }
+
+    SECTION("Deletes the least recently used cache files")
+    {
+      CHECK(trimTextureCache(cacheFolderPath, 25).is_success());
+      CHECK(!env.fileExists(cacheFolderPath / "a.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "b.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "c.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "other.txt"));
+    }
+
+    SECTION("Reading a cache file counts as using it")
+    {
+      const auto textureCache = TextureCache{cacheFolderPath};
+      const auto cachePath = makeTextureCachePath(cacheFolderPath, absoluteImagePath);
+      const auto key = computeTextureCacheKey(
+        std::filesystem::file_size(absoluteImagePath),
+        std::filesystem::last_write_time(absoluteImagePath));
+      REQUIRE(writeTextureCache(cachePath, key, imageTexture).is_success());
+      std::filesystem::last_write_time(cachePath, now - std::chrono::seconds{10});
+
+      textureCache.loadImageTexture(diskFS, imagePath) | kdl::value();
+
+      const auto cacheFileSize = size_t(std::filesystem::file_size(cachePath));
+      CHECK(trimTextureCache(cacheFolderPath, cacheFileSize + 10).is_success());
+      CHECK(env.fileExists(cachePath));
+      CHECK(!env.fileExists(cacheFolderPath / "a.bin"));
+      CHECK(!env.fileExists(cacheFolderPath / "b.bin"));
+      CHECK(env.fileExists(cacheFolderPath / "c.bin"));
+    }
+  }
+
+  SECTION("trimTextureCache without a cache folder")
+  {
+    CHECK(trimTextureCache(env.dir() / "TextureCache", 0).is_success());
+  }
+}
+
+} // namespace tb::mdl
@@ -33,6 +33,7 @@
 #include "mdl/WorldNode.h"
 #include "mdl/WorldReader.h"
 
+#include "kd/overload.h"
 #include "kd/task_manager.h"
 
 #include "vm/mat.h"
@@ -43,6 +44,8 @@
 
 #include <filesystem>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -52,6 +55,88 @@ namespace tb::mdl
 {
 using namespace Catch::Matchers;
 
+namespace
+{
+
+/**
+ * Generates a map with the given number of brush entities. Every entity contains a
+ * duplicate property and every tenth brush contains an invalid face so that warnings and
+ * errors are logged while parsing.
+ */
+std::string makeLargeMap(const size_t entityCount)
+{
+  auto str = std::string{"{\n\"classname\" \"worldspawn\"\n}\n"};
+  for (size_t i = 0; i < entityCount; ++i)
+  {
+    const auto x = double(i % 100) * 64.0;
+    const auto y = double(i / 100) * 64.0;
+
+    str += fmt::format(
+      R"(// entity {0}
+{{
+"classname" "func_detail"
+"targetname" "detail{0}"
+"targetname" "duplicate"
+// brush 0
+{{
+( {1} {2} -16 ) ( {1} {2} 0 ) ( {3} {2} -16 ) tex1 0 0 0 1 1
+( {1} {2} -16 ) ( {1} {4} -16 ) ( {1} {2} 0 ) tex2 0 0 0 1 1
+( {1} {2} -16 ) ( {3} {2} -16 ) ( {1} {4} -16 ) tex3 0 0 0 1 1
+( {3} {4} 0 ) ( {1} {4} 0 ) ( {3} {4} -16 ) tex4 0 0 0 1 1
+( {3} {4} 0 ) ( {3} {4} -16 ) ( {3} {2} 0 ) tex5 0 0 0 1 1
+( {3} {4} 0 ) ( {3} {2} 0 ) ( {1} {4} 0 ) tex6 0 0 0 1 1
+{5}}}
+}}
+)",
+      i,
+      x,
+      y,
+      x + 32.0,
+      y + 32.0,
+      i % 10 == 0 ? "( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) invalid 0 0 0 1 1\n" : "");
+  }
+  return str;
+}
+
+/**
+ * Returns the file positions of all nodes and brush faces in visiting order.
+ */
+std::vector<std::tuple<std::string, size_t, size_t>> getFilePositions(const Node& node)
+{
+  auto result = std::vector<std::tuple<std::string, size_t, size_t>>{};
+  node.accept(kdl::overload(
+    [&](auto&& thisLambda, const WorldNode& worldNode) {
+      result.emplace_back(worldNode.name(), worldNode.lineNumber(), worldNode.lineCount());
+      worldNode.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const LayerNode& layerNode) {
+      result.emplace_back(layerNode.name(), layerNode.lineNumber(), layerNode.lineCount());
+      layerNode.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const GroupNode& groupNode) {
+      result.emplace_back(groupNode.name(), groupNode.lineNumber(), groupNode.lineCount());
+      groupNode.visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const EntityNode& entityNode) {
+      result.emplace_back(
+        entityNode.name(), entityNode.lineNumber(), entityNode.lineCount());
+      entityNode.visitChildren(thisLambda);
+    },
+    [&](const BrushNode& brushNode) {
+      result.emplace_back(brushNode.name(), brushNode.lineNumber(), brushNode.lineCount());
+      for (const auto& face : brushNode.brush().faces())
+      {
+        result.emplace_back(face.materialName(), face.lineNumber(), 0);
+      }
+    },
+    [&](const PatchNode& patchNode) {
+      result.emplace_back(patchNode.name(), patchNode.lineNumber(), patchNode.lineCount());
+    }));
+  return result;
+}
+
+} // namespace
+
 TEST_CASE("WorldReader")
 {
   using namespace std::string_literals;
@@ -1992,6 +2077,112 @@ common/caulk
     CHECK(world->mapFormat() == mdl::MapFormat::Standard);
   }
 
+  SECTION("Sniffing the format of a large map")
+  {
+    const auto valveBrush = std::string{R"({
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1
+}
+)"};
+
+    auto data = std::string{"{\n\"classname\" \"worldspawn\"\n"};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      data += valveBrush;
+    }
+    data += "}\n";
+
+    SECTION("Skips formats that cannot parse the beginning of the map")
+    {
+      auto worldResult = WorldReader::tryRead(
+        data,
+        {mdl::MapFormat::Standard, mdl::MapFormat::Valve},
+        worldBounds,
+        {},
+        status,
+        taskManager);
+      REQUIRE(worldResult);
+
+      const auto& world = worldResult.value();
+      CHECK(world->mapFormat() == mdl::MapFormat::Valve);
+      CHECK(world->defaultLayer()->childCount() == 1000);
+    }
+
+    SECTION("Reports errors in the order of the given formats")
+    {
+      // the beginning can be parsed as Valve, but the end cannot
+      data += "{\n\"classname\" \"light\"\n";
+
+      const auto worldResult = WorldReader::tryRead(
+        data,
+        {mdl::MapFormat::Standard, mdl::MapFormat::Valve},
+        worldBounds,
+        {},
+        status,
+        taskManager);
+      REQUIRE(worldResult.is_error());
+
+      const auto message = std::get<Error>(worldResult.error()).msg;
+      CHECK(
+        message.find("Error parsing as Standard")
+        < message.find("Error parsing as Valve"));
+    }
+  }
+
+  SECTION("Parsing large maps in parallel")
+  {
+    auto serialTaskManager = kdl::task_manager{0};
+    auto parallelTaskManager = kdl::task_manager{2};
+    auto serialStatus = TestParserStatus{};
+
+    SECTION("Creates the same nodes and messages as parsing serially")
+    {
+      const auto data = makeLargeMap(5000);
+
+      auto serialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+      auto serialWorldResult =
+        serialReader.read(worldBounds, serialStatus, serialTaskManager);
+      REQUIRE(serialWorldResult);
+
+      auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+      auto worldResult = reader.read(worldBounds, status, parallelTaskManager);
+      REQUIRE(worldResult);
+
+      const auto& serialWorldNode = *serialWorldResult.value();
+      const auto& worldNode = *worldResult.value();
+      CHECK(worldNode.defaultLayer()->childCount() == 5000);
+      CHECK(getFilePositions(worldNode) == getFilePositions(serialWorldNode));
+
+      CHECK(status.countStatus(LogLevel::Warn) == 5000);
+      CHECK(status.countStatus(LogLevel::Error) == 500);
+      CHECK(status.messages(LogLevel::Warn) == serialStatus.messages(LogLevel::Warn));
+      CHECK(status.messages(LogLevel::Error) == serialStatus.messages(LogLevel::Error));
+    }
+
+    SECTION("Reports the same error as parsing serially")
+    {
+      auto data = makeLargeMap(5000);
+      data.replace(data.find("// entity 4000"), 0, "{\n\"classname\" \"broken\"\n(\n");
+
+      auto serialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+      auto serialWorldResult =
+        serialReader.read(worldBounds, serialStatus, serialTaskManager);
+      REQUIRE(serialWorldResult.is_error());
+
+      auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+      auto worldResult = reader.read(worldBounds, status, parallelTaskManager);
+      REQUIRE(worldResult.is_error());
+
+      CHECK(worldResult.error() == serialWorldResult.error());
+      CHECK(status.messages(LogLevel::Warn) == serialStatus.messages(LogLevel::Warn));
+      CHECK(status.messages(LogLevel::Error) == serialStatus.messages(LogLevel::Error));
+    }
+  }
+
   SECTION("Regression tests")
   {
     SECTION("1424")
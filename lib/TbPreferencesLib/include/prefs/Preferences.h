@@ -202,9 +202,21 @@ inline auto TextureMinFilter = Preference<int>{"render/Texture mode min filter",
 inline auto TextureMagFilter = Preference<int>{"render/Texture mode mag filter", 0x2600};
 inline auto EnableMSAA = Preference<bool>{"render/Enable multisampling", true};
 
+// in MiB
+inline auto TextureMemoryBudget = Preference<int>{"render/Texture memory budget", 2048};
+inline constexpr auto MinTextureMemoryBudget = 64;
+
+inline auto EnableTextureCache = Preference<bool>{"render/Enable texture cache", true};
+
+// in MiB
+inline auto TextureCacheSize = Preference<int>{"render/Texture cache size", 1024};
+
 inline auto AlignmentLock = Preference<bool>{"Editor/Texture lock", true};
 inline auto UvLock = Preference<bool>{"Editor/UV lock", false};
 
+// in MiB
+inline auto UndoMemoryLimit = Preference<int>{"Editor/Undo memory limit", 1024};
+
 inline auto RendererFontPath = Preference<std::filesystem::path>{
   "render/Font name", "fonts/SourceSansPro-Regular.otf"};
 
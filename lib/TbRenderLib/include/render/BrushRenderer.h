@@ -23,11 +23,16 @@
 #include "base/Macros.h"
 #include "gl/MiniGl.h"
 #include "mdl/BrushGeometry.h"
+#include "mdl/Octree.h"
 #include "render/AllocationTracker.h"
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/bbox.h"
 
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -63,6 +68,14 @@ size_t triIndicesCountForPolygon(size_t vertexCount);
  */
 void addTriIndicesForPolygon(GLuint* dest, GLuint baseIndex, size_t vertexCount);
 
+/**
+ * Sorts the given ranges by position and merges ranges that are separated by at most
+ * `maxGap` elements, so that they can be rendered with fewer draw calls. The ranges must
+ * not overlap.
+ */
+std::vector<AllocationTracker::Range> mergeRanges(
+  std::vector<AllocationTracker::Range> ranges, size_t maxGap);
+
 class BrushRenderer
 {
 public:
@@ -142,6 +155,7 @@ private:
 
   struct BrushInfo
   {
+    vm::bbox3f bounds;
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
     std::vector<std::pair<const gl::Material*, AllocationTracker::Block*>>
@@ -155,6 +169,12 @@ private:
    */
   std::unordered_map<const mdl::BrushNode*, BrushInfo> m_brushInfo;
 
+  /**
+   * Indexes the bounds of the brushes in m_brushInfo so that culling only visits the
+   * brushes near the view frustum.
+   */
+  mdl::octree<float, const mdl::BrushNode*> m_brushTree{256.0f};
+
   /**
    * If a brush is in the VBO, it's always valid.
    * If a brush is valid, it might not be in the VBO if it was hidden by the Filter.
@@ -172,6 +192,12 @@ private:
   std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
   std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
 
+  /**
+   * The frustum that the visible ranges of the index arrays were last computed for, or
+   * std::nullopt if they must be recomputed.
+   */
+  std::optional<ViewFrustum> m_cullingFrustum;
+
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
   IndexedEdgeRenderer m_edgeRenderer;
@@ -307,6 +333,15 @@ public:
    */
   void validate();
 
+  /**
+   * Restricts rendering to the brushes whose bounds intersect the given frustum. The
+   * visible index ranges are only recomputed if the frustum or the brushes have changed
+   * since the last call, and only the brushes near the frustum are visited.
+   *
+   * Only exposed for benchmarking.
+   */
+  void cull(const ViewFrustum& frustum);
+
 private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
@@ -257,6 +257,7 @@ class BrushIndexArray
 private:
   IndexHolder m_indexHolder;
   AllocationTracker m_allocationTracker = AllocationTracker{0};
+  std::optional<std::vector<AllocationTracker::Range>> m_visibleRanges;
 
 public:
   BrushIndexArray();
@@ -267,6 +268,18 @@ public:
    */
   bool hasValidIndices() const;
 
+  /**
+   * Returns true if render() would issue any draw calls.
+   */
+  bool hasVisibleIndices() const;
+
+  /**
+   * Restricts render() to the given ranges of indices, e.g. to the blocks of the brushes
+   * that are in view. The ranges must be sorted by position and must not overlap. Passing
+   * std::nullopt renders all indices again.
+   */
+  void setVisibleRanges(std::optional<std::vector<AllocationTracker::Range>> ranges);
+
   /**
    * Call this to request writing the given number of indices.
    *
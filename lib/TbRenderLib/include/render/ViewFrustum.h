@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <array>
+
+namespace tb
+{
+namespace gl
+{
+class Camera;
+}
+
+namespace render
+{
+
+/**
+ * The side planes of a camera's view frustum, used to skip geometry that cannot be on
+ * screen. The plane normals point out of the frustum.
+ *
+ * The near and far planes are not considered, so the culling is conservative: anything
+ * that is reported as outside is guaranteed to be invisible, but not vice versa.
+ */
+class ViewFrustum
+{
+private:
+  std::array<vm::plane3f, 4> m_planes;
+
+public:
+  explicit ViewFrustum(const gl::Camera& camera);
+  explicit ViewFrustum(const std::array<vm::plane3f, 4>& planes);
+
+  const std::array<vm::plane3f, 4>& planes() const;
+
+  /**
+   * Returns false if the given box lies entirely on the outer side of one of the
+   * frustum planes.
+   */
+  bool intersects(const vm::bbox3f& bounds) const;
+  bool intersects(const vm::bbox3d& bounds) const;
+
+  friend bool operator==(const ViewFrustum& lhs, const ViewFrustum& rhs) = default;
+};
+
+} // namespace render
+} // namespace tb
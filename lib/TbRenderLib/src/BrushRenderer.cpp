@@ -32,6 +32,7 @@
 
 #include "kd/contracts.h"
 
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -41,6 +42,12 @@ namespace tb::render
 namespace
 {
 
+/**
+ * Drawing a short run of indices of invisible or removed brushes is cheaper than issuing
+ * another draw call, so visible ranges that are closer than this are merged.
+ */
+constexpr auto MaxSkippedIndices = size_t(1024);
+
 class FilterWrapper : public BrushRenderer::Filter
 {
 private:
@@ -155,6 +162,26 @@ void addTriIndicesForPolygon(
   }
 }
 
+std::vector<AllocationTracker::Range> mergeRanges(
+  std::vector<AllocationTracker::Range> ranges, const size_t maxGap)
+{
+  std::ranges::sort(ranges, {}, &AllocationTracker::Range::pos);
+
+  auto result = std::vector<AllocationTracker::Range>{};
+  for (const auto& range : ranges)
+  {
+    if (!result.empty() && range.pos <= result.back().pos + result.back().size + maxGap)
+    {
+      result.back().size = range.pos + range.size - result.back().pos;
+    }
+    else
+    {
+      result.push_back(range);
+    }
+  }
+  return result;
+}
+
 // Filter
 
 BrushRenderer::Filter::Filter() = default;
@@ -273,6 +300,8 @@ void BrushRenderer::invalidate()
   }
   m_invalidBrushes = m_allBrushes;
 
+  m_cullingFrustum = std::nullopt;
+
   contract_post(m_brushInfo.empty());
   contract_post(m_transparentFaces->empty());
   contract_post(m_opaqueFaces->empty());
@@ -319,6 +348,7 @@ bool BrushRenderer::valid() const
 void BrushRenderer::clear()
 {
   m_brushInfo.clear();
+  m_brushTree.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
 
@@ -326,6 +356,7 @@ void BrushRenderer::clear()
   m_edgeIndices = std::make_shared<BrushIndexArray>();
   m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
+  m_cullingFrustum = std::nullopt;
 
   m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
   m_transparentFaceRenderer =
@@ -414,6 +445,7 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
+    cull(ViewFrustum{renderContext.camera()});
     if (renderContext.showFaces())
     {
       renderOpaqueFaces(renderBatch);
@@ -434,6 +466,7 @@ void BrushRenderer::renderTransparent(
     {
       validate();
     }
+    cull(ViewFrustum{renderContext.camera()});
     if (renderContext.showFaces())
     {
       renderTransparentFaces(renderBatch);
@@ -476,6 +509,7 @@ void BrushRenderer::validate()
     validateBrush(*brushNode);
   }
   m_invalidBrushes.clear();
+  m_cullingFrustum = std::nullopt;
 
   contract_assert(valid());
 
@@ -485,6 +519,59 @@ void BrushRenderer::validate()
   m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
 }
 
+void BrushRenderer::cull(const ViewFrustum& frustum)
+{
+  if (m_cullingFrustum == frustum)
+  {
+    return;
+  }
+
+  using Ranges = std::vector<AllocationTracker::Range>;
+  using MaterialToRangesMap = std::unordered_map<const gl::Material*, Ranges>;
+
+  auto edgeRanges = Ranges{};
+  auto opaqueRanges = MaterialToRangesMap{};
+  auto transparentRanges = MaterialToRangesMap{};
+
+  const auto& planes = frustum.planes();
+  for (const auto* brushNode :
+       m_brushTree.find_in_frustum({planes.begin(), planes.end()}))
+  {
+    const auto& info = m_brushInfo.at(brushNode);
+    if (frustum.intersects(info.bounds))
+    {
+      if (info.edgeIndicesKey != nullptr)
+      {
+        edgeRanges.emplace_back(info.edgeIndicesKey->pos, info.edgeIndicesKey->size);
+      }
+      for (const auto& [material, key] : info.opaqueFaceIndicesKeys)
+      {
+        opaqueRanges[material].emplace_back(key->pos, key->size);
+      }
+      for (const auto& [material, key] : info.transparentFaceIndicesKeys)
+      {
+        transparentRanges[material].emplace_back(key->pos, key->size);
+      }
+    }
+  }
+
+  const auto setVisibleRanges = [](auto& indexArrayMap, auto& rangesMap) {
+    for (auto& [material, indexArray] : indexArrayMap)
+    {
+      auto it = rangesMap.find(material);
+      indexArray->setVisibleRanges(
+        it != rangesMap.end() ? mergeRanges(std::move(it->second), MaxSkippedIndices)
+                              : Ranges{});
+    }
+  };
+
+  m_edgeIndices->setVisibleRanges(mergeRanges(std::move(edgeRanges), MaxSkippedIndices));
+  setVisibleRanges(*m_opaqueFaces, opaqueRanges);
+  setVisibleRanges(*m_transparentFaces, transparentRanges);
+
+  m_cullingFrustum = frustum;
+}
+
 bool BrushRenderer::shouldDrawFaceInTransparentPass(
   const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const
 {
@@ -531,6 +618,8 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
   }
 
   BrushInfo& info = m_brushInfo[&brushNode];
+  info.bounds = vm::bbox3f{brushNode.logicalBounds()};
+  m_brushTree.insert(info.bounds, &brushNode);
 
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
@@ -749,6 +838,7 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
     }
   }
 
+  m_brushTree.remove(&brushNode);
   m_brushInfo.erase(it);
 }
 
@@ -144,9 +144,23 @@ bool BrushIndexArray::hasValidIndices() const
   return m_allocationTracker.hasAllocations();
 }
 
+bool BrushIndexArray::hasVisibleIndices() const
+{
+  return hasValidIndices() && (!m_visibleRanges || !m_visibleRanges->empty());
+}
+
+void BrushIndexArray::setVisibleRanges(
+  std::optional<std::vector<AllocationTracker::Range>> ranges)
+{
+  m_visibleRanges = std::move(ranges);
+}
+
 std::pair<AllocationTracker::Block*, GLuint*> BrushIndexArray::
   getPointerToInsertElementsAt(const size_t elementCount)
 {
+  // the new indices would not be covered by the visible ranges
+  m_visibleRanges = std::nullopt;
+
   auto block = m_allocationTracker.allocate(elementCount);
   if (block != nullptr)
   {
@@ -202,7 +216,17 @@ void BrushIndexArray::render(gl::Gl& gl, const gl::PrimType primType) const
 {
   contract_pre(m_indexHolder.prepared());
 
-  m_indexHolder.render(gl, primType, 0, m_indexHolder.size());
+  if (m_visibleRanges)
+  {
+    for (const auto& range : *m_visibleRanges)
+    {
+      m_indexHolder.render(gl, primType, range.pos, range.size);
+    }
+  }
+  else
+  {
+    m_indexHolder.render(gl, primType, 0, m_indexHolder.size());
+  }
 }
 
 // BrushVertexArray
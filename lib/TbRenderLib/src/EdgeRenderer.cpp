@@ -255,7 +255,7 @@ void IndexedEdgeRenderer::Render::prepare(gl::Gl& gl, gl::VboManager& vboManager
 
 void IndexedEdgeRenderer::Render::render(RenderContext& renderContext)
 {
-  if (m_indexArray->hasValidIndices())
+  if (m_indexArray->hasVisibleIndices())
   {
     renderEdges(renderContext);
   }
@@ -36,10 +36,11 @@
 #include "prefs/Preferences.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
-#include "render/Transformation.h"
+#include "render/ViewFrustum.h"
 
 #include "vm/mat.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace tb::render
@@ -189,6 +190,16 @@ void EntityModelRenderer::render(RenderContext& renderContext)
     const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
     const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
 
+    const auto frustum = ViewFrustum{renderContext.camera()};
+
+    // group the entities by model frame so that each frame is set up only once
+    struct Instances
+    {
+      int orientation;
+      std::vector<vm::mat4x4f> transformations;
+    };
+    auto instancesByRenderer = std::unordered_map<gl::MaterialRenderer*, Instances>{};
+
     for (const auto& [entityNode, renderer] : m_entities)
     {
       if (!m_showHiddenEntities && !m_editorContext.visible(*entityNode))
@@ -196,6 +207,11 @@ void EntityModelRenderer::render(RenderContext& renderContext)
         continue;
       }
 
+      if (!frustum.intersects(entityNode->physicalBounds()))
+      {
+        continue;
+      }
+
       const auto* model = entityNode->entity().model();
       const auto* modelData = model ? model->data() : nullptr;
       if (!modelData)
@@ -203,18 +219,31 @@ void EntityModelRenderer::render(RenderContext& renderContext)
         continue;
       }
 
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
-
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
-      const auto multMatrix =
-        MultiplyModelMatrix{renderContext.transformation(), transformation};
+      auto& instances = instancesByRenderer
+                          .try_emplace(
+                            renderer,
+                            Instances{static_cast<int>(modelData->orientation()), {}})
+                          .first->second;
+      instances.transformations.emplace_back(
+        entityNode->entity().modelTransformation(defaultModelScaleExpression));
+    }
 
-      shader.set("ModelMatrix", transformation);
+    auto renderFunc = gl::DefaultMaterialRenderFunc{
+      renderContext.minFilterMode(), renderContext.magFilterMode()};
 
-      auto renderFunc = gl::DefaultMaterialRenderFunc{
-        renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(gl, shader.program(), renderFunc);
+    for (const auto& [renderer, instances] : instancesByRenderer)
+    {
+      shader.set("Orientation", instances.orientation);
+
+      // the shader only uses the model matrix uniform, so the fixed function model view
+      // matrix does not need to be updated per instance
+      const auto& transformations = instances.transformations;
+      renderer->renderInstances(
+        gl,
+        shader.program(),
+        renderFunc,
+        transformations.size(),
+        [&](const size_t i) { shader.set("ModelMatrix", transformations[i]); });
     }
   }
 }
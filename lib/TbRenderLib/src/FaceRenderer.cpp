@@ -190,7 +190,7 @@ void FaceRenderer::render(RenderContext& context)
     }
     for (const auto& [material, brushIndexHolderPtr] : *m_indexArrayMap)
     {
-      if (brushIndexHolderPtr->hasValidIndices())
+      if (brushIndexHolderPtr->hasVisibleIndices())
       {
         const auto* texture = getTexture(material);
         const auto enableMasked = texture && texture->mask() == gl::TextureMask::On;
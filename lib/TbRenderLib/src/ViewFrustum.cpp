@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/ViewFrustum.h"
+
+#include "gl/Camera.h"
+
+#include "vm/intersection.h"
+
+#include <algorithm>
+
+namespace tb::render
+{
+
+ViewFrustum::ViewFrustum(const gl::Camera& camera)
+{
+  camera.frustumPlanes(m_planes[0], m_planes[1], m_planes[2], m_planes[3]);
+}
+
+ViewFrustum::ViewFrustum(const std::array<vm::plane3f, 4>& planes)
+  : m_planes{planes}
+{
+}
+
+const std::array<vm::plane3f, 4>& ViewFrustum::planes() const
+{
+  return m_planes;
+}
+
+bool ViewFrustum::intersects(const vm::bbox3f& bounds) const
+{
+  return std::ranges::none_of(
+    m_planes, [&](const auto& plane) { return vm::bbox_above_plane(bounds, plane); });
+}
+
+bool ViewFrustum::intersects(const vm::bbox3d& bounds) const
+{
+  return intersects(vm::bbox3f{bounds});
+}
+
+} // namespace tb::render
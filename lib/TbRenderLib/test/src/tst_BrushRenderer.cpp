@@ -17,14 +17,66 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "TestPreferenceStore.h"
+#include "base/PreferenceManager.h"
+#include "gl/FontManager.h"
+#include "gl/MockGl.h"
+#include "gl/PerspectiveCamera.h"
+#include "gl/ShaderManager.h"
+#include "gl/Shaders.h"
+#include "gl/TestUtils.h"
+#include "gl/VboManager.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
 #include "render/BrushRenderer.h"
+#include "render/RenderBatch.h"
+#include "render/RenderContext.h"
 
+#include "kd/filesystem_utils.h"
+#include "kd/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::render
 {
+namespace
+{
+
+// creates the global PreferenceManager instance (the edge shader reads
+// Preferences::SoftMapBoundsColor) and destroys it again when it goes out of scope
+struct PreferenceManagerInstance
+{
+  PreferenceManagerInstance()
+  {
+    PreferenceManager::createInstance(std::make_unique<TestPreferenceStore>(), true);
+  }
+
+  ~PreferenceManagerInstance() { PreferenceManager::destroyInstance(); }
+};
+
+gl::PerspectiveCamera makeCamera(const vm::vec3f& position, const vm::vec3f& direction)
+{
+  return gl::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    gl::Camera::Viewport{0, 0, 100, 100},
+    position,
+    direction,
+    vm::vec3f{0, 0, 1}};
+}
+
+} // namespace
 
 TEST_CASE("BrushRenderer")
 {
@@ -76,6 +128,135 @@ TEST_CASE("BrushRenderer")
       CHECK(dest == std::vector<GLuint>{10, 11, 12, 10, 12, 13});
     }
   }
+
+  SECTION("mergeRanges")
+  {
+    using Ranges = std::vector<AllocationTracker::Range>;
+
+    SECTION("sorts the ranges by position")
+    {
+      CHECK(mergeRanges(Ranges{{20, 5}, {0, 5}}, 0) == Ranges{{0, 5}, {20, 5}});
+    }
+
+    SECTION("merges adjacent ranges")
+    {
+      CHECK(mergeRanges(Ranges{{0, 5}, {5, 5}, {10, 2}}, 0) == Ranges{{0, 12}});
+    }
+
+    SECTION("merges ranges separated by at most the given gap")
+    {
+      CHECK(mergeRanges(Ranges{{0, 5}, {8, 2}, {20, 5}}, 3) == Ranges{{0, 10}, {20, 5}});
+    }
+
+    SECTION("returns an empty vector for no ranges")
+    {
+      CHECK(mergeRanges(Ranges{}, 10).empty());
+    }
+  }
+
+  SECTION("render only draws the edges of brushes in the view frustum")
+  {
+    auto preferenceManager = PreferenceManagerInstance{};
+
+    auto shaderFile = kdl::tmp_file{};
+    {
+      auto ofs = std::ofstream{shaderFile.path()};
+      ofs << "void main() {}\n";
+    }
+
+    auto gl = gl::MockGl{};
+    gl::installVboSupport(gl);
+    gl::installShaderCompileSupport(gl);
+    gl.onMatrixMode = [](GLenum) {};
+    gl.onLoadMatrixf = [](const GLfloat*) {};
+    gl.onLineWidth = [](GLfloat) {};
+    gl.onUseProgram = [](GLuint) {};
+    gl.onGetIntegerv = [](GLenum, GLint* params) { *params = 1; };
+    gl.onGetUniformLocation = [](GLuint, const GLchar*) { return GLint{0}; };
+    gl.onUniform1i = [](GLint, GLint) {};
+    gl.onUniform3f = [](GLint, GLfloat, GLfloat, GLfloat) {};
+    gl.onUniform4f = [](GLint, GLfloat, GLfloat, GLfloat, GLfloat) {};
+    gl.onVertexPointer = [](GLint, GLenum, GLsizei, const GLvoid*) {};
+    gl.onNormalPointer = [](GLenum, GLsizei, const GLvoid*) {};
+    gl.onTexCoordPointer = [](GLint, GLenum, GLsizei, const GLvoid*) {};
+    gl.onEnableClientState = [](GLenum) {};
+    gl.onDisableClientState = [](GLenum) {};
+    gl.onClientActiveTexture = [](GLenum) {};
+
+    using Draws = std::vector<std::tuple<size_t, GLsizei>>;
+    auto draws = Draws{};
+    gl.onDrawElements =
+      [&](GLenum, const GLsizei count, GLenum, const void* indices) {
+        const auto offset = reinterpret_cast<size_t>(indices) / sizeof(GLuint);
+        draws.emplace_back(offset, count);
+      };
+
+    auto vboManager = gl::VboManager{};
+    auto fontManager = gl::FontManager{[](const auto& path) { return path; }};
+    auto shaderManager =
+      gl::ShaderManager{[&](const std::filesystem::path&) { return shaderFile.path(); }};
+    REQUIRE(shaderManager.loadProgram(gl, gl::Shaders::EdgeShader).is_success());
+
+    const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, vm::bbox3d{8192.0}};
+    auto frontBrushNode = mdl::BrushNode{
+      builder.createCuboid(vm::bbox3d{{100, -8, -8}, {116, 8, 8}}, "material")
+      | kdl::value()};
+    auto backBrushNode = mdl::BrushNode{
+      builder.createCuboid(vm::bbox3d{{-116, -8, -8}, {-100, 8, 8}}, "material")
+      | kdl::value()};
+
+    {
+      auto renderer = BrushRenderer{};
+      renderer.setShowEdges(true);
+      renderer.addBrush(frontBrushNode);
+      renderer.addBrush(backBrushNode);
+
+      const auto render = [&](const gl::Camera& camera) {
+        auto renderContext =
+          RenderContext{gl, RenderMode::Render3D, camera, fontManager, shaderManager};
+        renderContext.setShowFaces(false);
+
+        auto renderBatch = RenderBatch{vboManager};
+        draws.clear();
+        renderer.render(renderContext, renderBatch);
+        renderBatch.render(renderContext);
+        return draws;
+      };
+
+      const auto frontCamera = makeCamera({0, 0, 0}, {1, 0, 0});
+      const auto backCamera = makeCamera({0, 0, 0}, {-1, 0, 0});
+      const auto overviewCamera = makeCamera({0, -1000, 0}, {0, 1, 0});
+      const auto sideCamera = makeCamera({0, 0, 0}, {0, 1, 0});
+
+      // each cube has 12 edges with 2 indices each
+      const auto frontDraws = render(frontCamera);
+      REQUIRE(frontDraws.size() == 1u);
+      CHECK(std::get<1>(frontDraws.front()) == 24);
+
+      const auto backDraws = render(backCamera);
+      REQUIRE(backDraws.size() == 1u);
+      CHECK(std::get<1>(backDraws.front()) == 24);
+
+      const auto frontOffset = std::get<0>(frontDraws.front());
+      const auto backOffset = std::get<0>(backDraws.front());
+      CHECK(frontOffset != backOffset);
+
+      // the edges of both brushes are adjacent, so they are drawn in one call
+      CHECK(render(overviewCamera) == Draws{{std::min(frontOffset, backOffset), 48}});
+      CHECK(render(sideCamera).empty());
+
+      // alternating between the views of several panes culls for each view
+      CHECK(render(frontCamera) == frontDraws);
+      CHECK(render(backCamera) == backDraws);
+      CHECK(render(frontCamera) == frontDraws);
+
+      renderer.removeBrush(frontBrushNode);
+      CHECK(render(overviewCamera) == backDraws);
+      CHECK(render(frontCamera).empty());
+    }
+
+    vboManager.destroyPendingVbos(gl);
+  }
 }
 
 } // namespace tb::render
@@ -27,6 +27,8 @@
 #include "vm/vec.h"
 
 #include <stdexcept>
+#include <tuple>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -242,6 +244,77 @@ TEST_CASE("BrushIndexArray")
     CHECK(capturedCount == 3);
   }
 
+  SECTION("setVisibleRanges")
+  {
+    auto array = BrushIndexArray{};
+    const auto [block, dest] = array.getPointerToInsertElementsAt(12);
+    for (auto i = 0u; i < 12; ++i)
+    {
+      dest[i] = i;
+    }
+
+    array.prepare(gl, vboManager);
+    gl.onBindBuffer = [](GLenum, GLuint) {};
+
+    auto capturedDraws = std::vector<std::tuple<size_t, GLsizei>>{};
+    gl.onDrawElements =
+      [&](GLenum, const GLsizei count, GLenum, const void* indices) {
+        const auto offset = reinterpret_cast<size_t>(indices) / sizeof(GLuint);
+        capturedDraws.emplace_back(offset, count);
+      };
+
+    const auto render = [&]() {
+      capturedDraws.clear();
+      array.setup(gl);
+      array.render(gl, gl::PrimType::Triangles);
+      array.cleanup(gl);
+    };
+
+    // the offset of the array's block within the VBO
+    render();
+    REQUIRE(capturedDraws.size() == 1u);
+    const auto [baseOffset, baseCount] = capturedDraws.front();
+    REQUIRE(block->pos == 0u);
+    REQUIRE(baseCount == 12);
+
+    SECTION("restricts the draw calls to the given ranges")
+    {
+      array.setVisibleRanges(std::vector<AllocationTracker::Range>{{0, 3}, {6, 6}});
+      CHECK(array.hasVisibleIndices());
+
+      render();
+      using Draws = std::vector<std::tuple<size_t, GLsizei>>;
+      CHECK(capturedDraws == Draws{{baseOffset, 3}, {baseOffset + 6, 6}});
+    }
+
+    SECTION("with no ranges leaves nothing to render")
+    {
+      array.setVisibleRanges(std::vector<AllocationTracker::Range>{});
+      CHECK(array.hasValidIndices());
+      CHECK(!array.hasVisibleIndices());
+
+      render();
+      CHECK(capturedDraws.empty());
+    }
+
+    SECTION("with std::nullopt renders all indices again")
+    {
+      array.setVisibleRanges(std::vector<AllocationTracker::Range>{});
+      array.setVisibleRanges(std::nullopt);
+      CHECK(array.hasVisibleIndices());
+
+      render();
+      CHECK(capturedDraws == std::vector<std::tuple<size_t, GLsizei>>{{baseOffset, 12}});
+    }
+
+    SECTION("is reset by inserting more indices")
+    {
+      array.setVisibleRanges(std::vector<AllocationTracker::Range>{});
+      array.getPointerToInsertElementsAt(3);
+      CHECK(array.hasVisibleIndices());
+    }
+  }
+
   vboManager.destroyPendingVbos(gl);
 }
 
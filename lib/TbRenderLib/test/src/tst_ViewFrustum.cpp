@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/OrthographicCamera.h"
+#include "gl/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::render
+{
+
+TEST_CASE("ViewFrustum")
+{
+  SECTION("perspective camera")
+  {
+    const auto camera = gl::PerspectiveCamera{
+      90.0f,
+      1.0f,
+      8192.0f,
+      gl::Camera::Viewport{0, 0, 100, 100},
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{1, 0, 0},
+      vm::vec3f{0, 0, 1}};
+    const auto frustum = ViewFrustum{camera};
+
+    SECTION("intersects a box in front of the camera")
+    {
+      CHECK(frustum.intersects(vm::bbox3f{{100, -8, -8}, {116, 8, 8}}));
+    }
+
+    SECTION("intersects a box that contains the camera")
+    {
+      CHECK(frustum.intersects(vm::bbox3f{{-8, -8, -8}, {8, 8, 8}}));
+    }
+
+    SECTION("intersects a box that straddles a frustum plane")
+    {
+      CHECK(frustum.intersects(vm::bbox3f{{100, 60, -8}, {116, 200, 8}}));
+    }
+
+    SECTION("does not intersect a box behind the camera")
+    {
+      CHECK(!frustum.intersects(vm::bbox3f{{-116, -8, -8}, {-100, 8, 8}}));
+    }
+
+    SECTION("does not intersect a box beside the frustum")
+    {
+      CHECK(!frustum.intersects(vm::bbox3f{{100, 200, -8}, {116, 216, 8}}));
+      CHECK(!frustum.intersects(vm::bbox3f{{100, -8, -216}, {116, 8, -200}}));
+    }
+
+    SECTION("accepts double precision boxes")
+    {
+      CHECK(frustum.intersects(vm::bbox3d{{100, -8, -8}, {116, 8, 8}}));
+      CHECK(!frustum.intersects(vm::bbox3d{{-116, -8, -8}, {-100, 8, 8}}));
+    }
+  }
+
+  SECTION("orthographic camera")
+  {
+    const auto camera = gl::OrthographicCamera{
+      1.0f,
+      100.0f,
+      gl::Camera::Viewport{0, 0, 100, 50},
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{1, 0, 0},
+      vm::vec3f{0, 0, 1}};
+    const auto frustum = ViewFrustum{camera};
+
+    SECTION("intersects a box inside the viewport in front of or behind the camera")
+    {
+      CHECK(frustum.intersects(vm::bbox3f{{100, -8, -8}, {116, 8, 8}}));
+      CHECK(frustum.intersects(vm::bbox3f{{-116, -8, -8}, {-100, 8, 8}}));
+    }
+
+    SECTION("does not intersect a box outside of the viewport")
+    {
+      CHECK(!frustum.intersects(vm::bbox3f{{0, 60, -8}, {16, 76, 8}}));
+      CHECK(!frustum.intersects(vm::bbox3f{{0, -8, 30}, {16, 8, 46}}));
+    }
+  }
+
+  SECTION("equality")
+  {
+    auto camera = gl::PerspectiveCamera{};
+    const auto frustum = ViewFrustum{camera};
+    CHECK(ViewFrustum{camera} == frustum);
+
+    camera.moveTo(vm::vec3f{64, 0, 0});
+    CHECK(ViewFrustum{camera} != frustum);
+  }
+}
+
+} // namespace tb::render
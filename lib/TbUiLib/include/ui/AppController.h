@@ -22,6 +22,7 @@
 #include <QObject>
 #include <QtSystemDetection>
 
+#include "base/NotifierConnection.h"
 #include "base/Result.h"
 
 #include <filesystem>
@@ -91,6 +92,8 @@ private:
   std::unique_ptr<WelcomeWindow> m_welcomeWindow;
   std::unique_ptr<AboutDialog> m_aboutDialog;
 
+  NotifierConnection m_notifierConnection;
+
 public:
   AppController(
     std::unique_ptr<kdl::task_manager> taskManager,
@@ -141,7 +144,9 @@ public:
 
 private:
   void connectObservers();
+  void preferenceDidChange(const std::filesystem::path& path);
 
+  void updateResourceManagerFromPreferences();
   void processGlResources();
 };
 
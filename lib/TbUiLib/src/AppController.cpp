@@ -70,6 +70,7 @@
 #include <fmt/ostream.h>
 #include <fmt/std.h>
 
+#include <algorithm>
 #include <chrono>
 
 namespace tb::ui
@@ -193,6 +194,7 @@ AppController::AppController(
   using namespace std::chrono_literals;
 
   connectObservers();
+  updateResourceManagerFromPreferences();
 
   m_reloadRecentDocumentsTimer->start(1s);
   m_processResourcesTimer->start(20ms);
@@ -430,6 +432,25 @@ void AppController::connectObservers()
     &RecentDocuments::reload);
   connect(
     m_processResourcesTimer, &QTimer::timeout, this, &AppController::processGlResources);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection +=
+    prefs.preferenceDidChangeNotifier.connect(this, &AppController::preferenceDidChange);
+}
+
+void AppController::preferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::TextureMemoryBudget.path)
+  {
+    updateResourceManagerFromPreferences();
+  }
+}
+
+void AppController::updateResourceManagerFromPreferences()
+{
+  const auto textureMemoryBudget = size_t(std::max(
+    pref(Preferences::TextureMemoryBudget), Preferences::MinTextureMemoryBudget));
+  m_glManager->resourceManager().setMemoryBudget(textureMemoryBudget * 1024u * 1024u);
 }
 
 void AppController::processGlResources()
@@ -250,9 +250,10 @@ vm::vec3d MapView3D::pasteObjectsDelta(
       vm::ray3d{m_camera->pickRay(float(clientCoords.x()), float(clientCoords.y()))};
     auto pickResult = mdl::PickResult::byDistance();
 
-    mdl::pick(map, pickRay, pickResult);
+    const auto brushHitFilter = type(mdl::BrushNode::BrushHitType);
+    mdl::pickNearest(map, pickRay, brushHitFilter, 1, pickResult);
 
-    const auto& hit = pickResult.first(type(mdl::BrushNode::BrushHitType));
+    const auto& hit = pickResult.first(brushHitFilter);
     if (const auto faceHandle = mdl::hitToFaceHandle(hit))
     {
       const auto& face = faceHandle->face();
@@ -1280,6 +1280,8 @@ void MapWindow::reloadEntityDefinitions()
 
 bool MapWindow::canReloadMaterialCollections() const
 {
+  // only waits for the pending resources; unused resources that the resource manager has
+  // not found yet are released later and don't prevent a reload
   return !m_appController.glManager().resourceManager().needsProcessing();
 }
 
@@ -54,6 +54,8 @@
 #include "vm/mat_ext.h"
 #include "vm/vec.h"
 
+#include <fmt/format.h>
+
 #include <ranges>
 #include <string>
 #include <vector>
@@ -171,7 +173,11 @@ void MaterialBrowserView::doReloadLayout(Layout& layout)
   {
     for (const auto* collection : getCollections())
     {
-      layout.addGroup(collection->path().string(), float(fontSize) + 2.0f);
+      const auto title = fmt::format(
+        "{} ({:.1f} MiB)",
+        collection->path().string(),
+        double(collection->memoryUsage()) / (1024.0 * 1024.0));
+      layout.addGroup(title, float(fontSize) + 2.0f);
       addMaterialsToLayout(layout, getMaterials(*collection), font);
     }
   }
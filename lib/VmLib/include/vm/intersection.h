@@ -854,4 +854,24 @@ constexpr bool intersect_bbox_polygon(
   // 4
   return edgeIsect;
 }
+
+/**
+ * Tests if a bounding box lies entirely above a plane, that is, on the side that the
+ * plane normal points to. Only the corner of the box that lies furthest below the plane
+ * is tested.
+ *
+ * @tparam T the component type
+ * @param bbox the bbox to test
+ * @param plane the plane to test against
+ * @return true if every point of the bbox is above the plane, false otherwise
+ */
+template <typename T>
+constexpr bool bbox_above_plane(const bbox<T, 3>& bbox, const plane<T, 3>& plane)
+{
+  const auto corner = vec<T, 3>{
+    plane.normal.x() > T(0) ? bbox.min.x() : bbox.max.x(),
+    plane.normal.y() > T(0) ? bbox.min.y() : bbox.max.y(),
+    plane.normal.z() > T(0) ? bbox.min.z() : bbox.max.z()};
+  return plane.point_distance(corner) > T(0);
+}
 } // namespace vm
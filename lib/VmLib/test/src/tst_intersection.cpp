@@ -522,6 +522,24 @@ TEST_CASE("intersection")
     }
   }
 
+  SECTION("bbox_above_plane")
+  {
+    constexpr auto bbox = bbox3d{{-1, -1, -1}, {1, 1, 1}};
+
+    // below, touching, intersecting and above an axis aligned plane
+    CHECK(!bbox_above_plane(bbox, plane3d{2.0, vec3d{0, 0, 1}}));
+    CHECK(!bbox_above_plane(bbox, plane3d{1.0, vec3d{0, 0, 1}}));
+    CHECK(!bbox_above_plane(bbox, plane3d{0.0, vec3d{0, 0, 1}}));
+    CHECK(bbox_above_plane(bbox, plane3d{-2.0, vec3d{0, 0, 1}}));
+    CHECK(bbox_above_plane(bbox, plane3d{-2.0, vec3d{0, 0, -1}}));
+
+    // only the corner furthest below a diagonal plane decides
+    const auto diagonal = normalize(vec3d{1, 1, 1});
+    CHECK(!bbox_above_plane(bbox, plane3d{-1.5, diagonal}));
+    CHECK(bbox_above_plane(bbox, plane3d{-2.0, diagonal}));
+    CHECK(bbox_above_plane(bbox, plane3d{-2.0, -diagonal}));
+  }
+
   SECTION("segments_overlap")
   {
     static constexpr auto epsilon = constants<double>::almost_zero();